@@ -0,0 +1,1112 @@
+/*
+ * Generated by tools/psm_codegen from:
+ *   RefDoc/LDM_Common.xml
+ *   RefDoc/Nstel_PSM.xml
+ *   RefDoc/Usage_And_Condition_Monitoring_PSM.xml
+ * Do not edit; regenerate with "make psm-codegen".
+ *
+ * C types of the PSM, prefixed by module. In C++ the types are also
+ * reflected (legacy_reflect.hpp), which instantiates a CBOR codec per
+ * type: register one with
+ *   legacy::reflect::register_type<T>(h, T_TOPIC, T_TYPE)
+ * and use legacy_agent_write_struct / legacy_agent_subscribe_typed.
+ * Sequences (other than strings) are not described: not sent, left empty.
+ */
+
+#ifndef PSM_TYPES_H
+#define PSM_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---- P_LDM_Common ---- */
+
+typedef double P_LDM_Common_T_Double;
+
+typedef enum {
+    P_LDM_Common_L_RAGType_RED = 0,
+    P_LDM_Common_L_RAGType_AMBER = 1,
+    P_LDM_Common_L_RAGType_GREEN = 2
+} P_LDM_Common_T_RAGType;
+
+typedef int32_t P_LDM_Common_T_Int32;
+
+typedef struct {
+    P_LDM_Common_T_Int32 A_xPosition;
+    P_LDM_Common_T_Int32 A_yPosition;
+} P_LDM_Common_T_Position2DType;
+
+typedef enum {
+    P_LDM_Common_L_Axis3DType_X_AXIS = 0,
+    P_LDM_Common_L_Axis3DType_Y_AXIS = 1,
+    P_LDM_Common_L_Axis3DType_Z_AXIS = 2
+} P_LDM_Common_T_Axis3DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_ForceInNewtonsType;
+
+typedef char P_LDM_Common_T_Char;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_CapacityInAmpereHoursType;
+
+typedef bool P_LDM_Common_T_Boolean;
+
+typedef int64_t P_LDM_Common_T_Int64;
+
+typedef struct {
+    P_LDM_Common_T_Int32 A_xSize;
+    P_LDM_Common_T_Int32 A_ySize;
+} P_LDM_Common_T_Size2DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_AngleInRadiansType;
+
+typedef int16_t P_LDM_Common_T_Int16;
+
+typedef char P_LDM_Common_T_LongString[501];
+
+typedef char P_LDM_Common_T_MediumString[101];
+
+typedef char P_LDM_Common_T_ShortString[21];
+
+typedef struct {
+    P_LDM_Common_T_Int32 A_resourceId;
+    P_LDM_Common_T_Int32 A_instanceId;
+} P_LDM_Common_T_IdentifierType;
+
+typedef struct {
+    P_LDM_Common_T_Int32 A_seconds;
+    P_LDM_Common_T_Int32 A_nanoseconds;
+} P_LDM_Common_T_DurationType;
+
+typedef P_LDM_Common_T_DurationType P_LDM_Common_T_HeartbeatType;
+
+typedef struct {
+    P_LDM_Common_T_Int64 A_second;
+    P_LDM_Common_T_Int32 A_nanoseconds;
+} P_LDM_Common_T_DateTimeType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_TorqueInNewtonMetresType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_LinearAccelerationInMetresPerSecPerSecType;
+
+typedef struct {
+    P_LDM_Common_T_LinearAccelerationInMetresPerSecPerSecType A_xAcceleration;
+    P_LDM_Common_T_LinearAccelerationInMetresPerSecPerSecType A_yAcceleration;
+    P_LDM_Common_T_LinearAccelerationInMetresPerSecPerSecType A_zAcceleration;
+} P_LDM_Common_T_LinearAcceleration3DType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_pitch;
+    P_LDM_Common_T_AngleInRadiansType A_roll;
+    P_LDM_Common_T_AngleInRadiansType A_yaw;
+} P_LDM_Common_T_AttitudeType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_DistanceInMetresType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_SpeedInMetresPerSecType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_angle;
+    P_LDM_Common_T_AngleInRadiansType A_elevation;
+    P_LDM_Common_T_DistanceInMetresType A_radius;
+} P_LDM_Common_T_PointPolar3DType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_angle;
+    P_LDM_Common_T_AngleInRadiansType A_elevation;
+    P_LDM_Common_T_DistanceInMetresType A_range;
+} P_LDM_Common_T_CoordinatePolar3DType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_angle;
+    P_LDM_Common_T_DistanceInMetresType A_range;
+} P_LDM_Common_T_CoordinatePolar2DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_AngularAccelerationInRadiansPerSecPerSecType;
+
+typedef struct {
+    P_LDM_Common_T_AngularAccelerationInRadiansPerSecPerSecType A_pitch;
+    P_LDM_Common_T_AngularAccelerationInRadiansPerSecPerSecType A_roll;
+    P_LDM_Common_T_AngularAccelerationInRadiansPerSecPerSecType A_yaw;
+} P_LDM_Common_T_AngularAcceleration3DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_AngularVelocityinRadiansPerSecType;
+
+typedef struct {
+    P_LDM_Common_T_AngularVelocityinRadiansPerSecType A_pitch;
+    P_LDM_Common_T_AngularVelocityinRadiansPerSecType A_roll;
+    P_LDM_Common_T_AngularVelocityinRadiansPerSecType A_yaw;
+} P_LDM_Common_T_AngularVelocity3DType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_heading;
+    P_LDM_Common_T_SpeedInMetresPerSecType A_speed;
+    P_LDM_Common_T_SpeedInMetresPerSecType A_vrate;
+} P_LDM_Common_T_LinearVelocity3DType;
+
+typedef P_LDM_Common_T_AngleInRadiansType P_LDM_Common_T_LatitudeType;
+
+typedef P_LDM_Common_T_DistanceInMetresType P_LDM_Common_T_AltitudeType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_pitchOffset;
+    P_LDM_Common_T_AngleInRadiansType A_rollOffset;
+    P_LDM_Common_T_AngleInRadiansType A_yawOffset;
+} P_LDM_Common_T_RotationalOffsetType;
+
+typedef P_LDM_Common_T_AngleInRadiansType P_LDM_Common_T_LongitudeType;
+
+typedef struct {
+    P_LDM_Common_T_LatitudeType A_latitude;
+    P_LDM_Common_T_LongitudeType A_longitude;
+} P_LDM_Common_T_Coordinate2DType;
+
+typedef struct {
+    P_LDM_Common_T_SpeedInMetresPerSecType A_xSpeed;
+    P_LDM_Common_T_SpeedInMetresPerSecType A_ySpeed;
+    P_LDM_Common_T_SpeedInMetresPerSecType A_zSpeed;
+} P_LDM_Common_T_LinearSpeed3DType;
+
+typedef struct {
+    P_LDM_Common_T_DistanceInMetresType A_xOffset;
+    P_LDM_Common_T_DistanceInMetresType A_yOffset;
+    P_LDM_Common_T_DistanceInMetresType A_zOffset;
+} P_LDM_Common_T_LinearOffsetType;
+
+typedef P_LDM_Common_T_AngleInRadiansType P_LDM_Common_T_BearingType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_VolumeInCubicMetresType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_VoltageInVoltsType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_TemperatureInDegreesKelvinType;
+
+typedef struct {
+    P_LDM_Common_T_AngleInRadiansType A_heading;
+    P_LDM_Common_T_SpeedInMetresPerSecType A_speed;
+} P_LDM_Common_T_LinearVelocity2DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_PressureInPascalType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_PowerInWattsType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_PercentageType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_ChargeInCoulombsType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_FrequencyInHertzType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_FlowRateInCubicMetresPerSecType;
+
+typedef struct {
+    P_LDM_Common_T_AltitudeType A_altitude;
+    P_LDM_Common_T_LatitudeType A_latitude;
+    P_LDM_Common_T_LongitudeType A_longitude;
+} P_LDM_Common_T_Coordinate3DType;
+
+typedef P_LDM_Common_T_Double P_LDM_Common_T_CurrentInAmpsType;
+
+typedef enum {
+    P_LDM_Common_L_CommandResponseType_Command_Failed = 0,
+    P_LDM_Common_L_CommandResponseType_Command_Not_Available = 1,
+    P_LDM_Common_L_CommandResponseType_Command_Not_Recognised = 2,
+    P_LDM_Common_L_CommandResponseType_Resource_Control_Failure = 3
+} P_LDM_Common_T_CommandResponseType;
+
+/* ---- P_NSTEL ---- */
+
+typedef enum {
+    P_NSTEL_L_OperationModeType_NORMAL = 0,
+    P_NSTEL_L_OperationModeType_EMERGENCY = 1,
+    P_NSTEL_L_OperationModeType_MANUAL = 2
+} P_NSTEL_T_OperationModeType;
+
+typedef enum {
+    P_NSTEL_L_PalmModeType_ON = 0,
+    P_NSTEL_L_PalmModeType_OFF = 1
+} P_NSTEL_T_PalmModeType;
+
+typedef enum {
+    P_NSTEL_L_TargetFixType_FIXED = 0,
+    P_NSTEL_L_TargetFixType_ETC = 1
+} P_NSTEL_T_TargetFixType;
+
+typedef enum {
+    P_NSTEL_L_ArmPositionType_RELEASE = 0,
+    P_NSTEL_L_ArmPositionType_DRIVING = 1
+} P_NSTEL_T_ArmPositionType;
+
+typedef enum {
+    P_NSTEL_L_CannonRestoreType_RELEASE = 0,
+    P_NSTEL_L_CannonRestoreType_RESTORE = 1
+} P_NSTEL_T_CannonRestoreType;
+
+typedef enum {
+    P_NSTEL_L_CannonFixType_RELEASE = 0,
+    P_NSTEL_L_CannonFixType_FIX = 1
+} P_NSTEL_T_CannonFixType;
+
+typedef enum {
+    P_NSTEL_L_EquipOpenStatusType_CLOSE = 0,
+    P_NSTEL_L_EquipOpenStatusType_OPEN = 1
+} P_NSTEL_T_EquipOpenStatusType;
+
+typedef enum {
+    P_NSTEL_L_CannonFixStatusType_NORMAL = 0,
+    P_NSTEL_L_CannonFixStatusType_FIXED = 1
+} P_NSTEL_T_CannonFixStatusType;
+
+typedef enum {
+    P_NSTEL_L_DeckClearanceType_OUT_OF_DECK = 0,
+    P_NSTEL_L_DeckClearanceType_IN_DECK = 1
+} P_NSTEL_T_DeckClearanceType;
+
+typedef enum {
+    P_NSTEL_L_CannonDrivingType_DRIVING = 0,
+    P_NSTEL_L_CannonDrivingType_DONE = 1
+} P_NSTEL_T_CannonDrivingType;
+
+typedef enum {
+    P_NSTEL_L_CannonLockType_NORMAL = 0,
+    P_NSTEL_L_CannonLockType_LOCKED = 1
+} P_NSTEL_T_CannonLockType;
+
+typedef enum {
+    P_NSTEL_L_ShutdownType_UNKNOWN = 0,
+    P_NSTEL_L_ShutdownType_SHUTDOWN = 1
+} P_NSTEL_T_ShutdownType;
+
+typedef enum {
+    P_NSTEL_L_EnergyStorageStatusType_NORMAL = 0,
+    P_NSTEL_L_EnergyStorageStatusType_DISCHARGE = 1
+} P_NSTEL_T_EnergyStorageStatusType;
+
+typedef enum {
+    P_NSTEL_L_BITResultType_NORMAL = 0,
+    P_NSTEL_L_BITResultType_ABNORMAL = 1
+} P_NSTEL_T_BITResultType;
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_IdentifierType A_specification_sourceID;
+} P_NSTEL_C_CannonDrivingDevice;
+#define P_NSTEL_C_CannonDrivingDevice_TYPE  "P_NSTEL::C_CannonDrivingDevice"
+#define P_NSTEL_C_CannonDrivingDevice_TOPIC "P_NSTEL__C_CannonDrivingDevice"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Boolean A_powerOnBITSupported;
+    P_LDM_Common_T_Boolean A_continousBITSupported;
+    P_LDM_Common_T_Boolean A_initiatedBITSupported;
+    P_LDM_Common_T_Int32 A_continousBITInterval;
+    P_LDM_Common_T_IdentifierType A_specifiedCannonDrivingDevices_sourceID[100];
+    uint32_t A_specifiedCannonDrivingDevices_sourceID_length;
+} P_NSTEL_C_CannonDrivingDevice_Specification;
+#define P_NSTEL_C_CannonDrivingDevice_Specification_TYPE  "P_NSTEL::C_CannonDrivingDevice_Specification"
+#define P_NSTEL_C_CannonDrivingDevice_Specification_TOPIC "P_NSTEL__C_CannonDrivingDevice_Specification"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_IdentifierType A_recipientID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Int32 A_referenceNum;
+    P_LDM_Common_T_Double A_roundPosition;
+    P_LDM_Common_T_Double A_upDownPosition;
+    P_LDM_Common_T_Double A_roundAngleVelocity;
+    P_LDM_Common_T_Double A_upDownAngleVelocity;
+    P_LDM_Common_T_Double A_cannonUpDownAngle;
+    P_LDM_Common_T_Double A_topRelativeAngle;
+    P_NSTEL_T_OperationModeType A_operationMode;
+    P_NSTEL_T_PalmModeType A_parm;
+    P_NSTEL_T_TargetFixType A_targetFix;
+    P_NSTEL_T_ArmPositionType A_autoArmPosition;
+    P_NSTEL_T_ArmPositionType A_manualArmPosition;
+    P_NSTEL_T_CannonRestoreType A_mainCannonRestore;
+    P_NSTEL_T_CannonFixType A_mainCannonFix;
+    P_NSTEL_T_EquipOpenStatusType A_closureEquipOpenStatus;
+} P_NSTEL_C_CannonDrivingDevice_commandDriving;
+#define P_NSTEL_C_CannonDrivingDevice_commandDriving_TYPE  "P_NSTEL::C_CannonDrivingDevice_commandDriving"
+#define P_NSTEL_C_CannonDrivingDevice_commandDriving_TOPIC "P_NSTEL__C_CannonDrivingDevice_commandDriving"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_IdentifierType A_recipientID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Double A_azAngleVelocity;
+    P_LDM_Common_T_Double A_e1AngleVelocity;
+    P_NSTEL_T_EnergyStorageStatusType A_energyStorage;
+    P_NSTEL_T_CannonFixType A_mainCannonFixStatus;
+    P_NSTEL_T_DeckClearanceType A_deckCleance;
+    P_NSTEL_T_CannonDrivingType A_autoArmPositionComplement;
+    P_NSTEL_T_CannonDrivingType A_manualArmPositionComplement;
+    P_NSTEL_T_CannonDrivingType A_mainCannonRestoreComplement;
+    P_NSTEL_T_CannonLockType A_armSafetyMainCannonLock;
+    P_NSTEL_T_ShutdownType A_shutdown;
+    P_LDM_Common_T_Double A_roundGiro;
+    P_LDM_Common_T_Double A_upDownGiro;
+} P_NSTEL_C_CannonDrivingDevice_Signal;
+#define P_NSTEL_C_CannonDrivingDevice_Signal_TYPE  "P_NSTEL::C_CannonDrivingDevice_Signal"
+#define P_NSTEL_C_CannonDrivingDevice_Signal_TOPIC "P_NSTEL__C_CannonDrivingDevice_Signal"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Double A_value;
+} P_NSTEL_C_VehicleSpeed;
+#define P_NSTEL_C_VehicleSpeed_TYPE  "P_NSTEL::C_VehicleSpeed"
+#define P_NSTEL_C_VehicleSpeed_TOPIC "P_NSTEL__C_VehicleSpeed"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_IdentifierType A_cannonDrivingDevice_sourceID;
+    P_LDM_Common_T_Boolean A_BITRunning;
+    P_NSTEL_T_BITResultType A_upDownMotor;
+    P_NSTEL_T_BITResultType A_roundMotor;
+    P_NSTEL_T_BITResultType A_upDownAmp;
+    P_NSTEL_T_BITResultType A_roundAmp;
+    P_NSTEL_T_BITResultType A_baseGiro;
+    P_NSTEL_T_BITResultType A_topForwardGiro;
+    P_NSTEL_T_BITResultType A_vehicleForwardGiro;
+    P_NSTEL_T_BITResultType A_powerController;
+    P_NSTEL_T_BITResultType A_energyStorage;
+    P_NSTEL_T_BITResultType A_directPower;
+    P_NSTEL_T_BITResultType A_cableLoop;
+} P_NSTEL_C_CannonDrivingDevice_PowerOnBIT;
+#define P_NSTEL_C_CannonDrivingDevice_PowerOnBIT_TYPE  "P_NSTEL::C_CannonDrivingDevice_PowerOnBIT"
+#define P_NSTEL_C_CannonDrivingDevice_PowerOnBIT_TOPIC "P_NSTEL__C_CannonDrivingDevice_PowerOnBIT"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_IdentifierType A_cannonDrivingDevice_sourceID;
+    P_NSTEL_T_BITResultType A_upDownMotor;
+    P_NSTEL_T_BITResultType A_roundMotor;
+    P_NSTEL_T_BITResultType A_upDownAmp;
+    P_NSTEL_T_BITResultType A_roundAmp;
+    P_NSTEL_T_BITResultType A_baseGiro;
+    P_NSTEL_T_BITResultType A_topForwardGiro;
+    P_NSTEL_T_BITResultType A_vehicleForwardGiro;
+    P_NSTEL_T_BITResultType A_powerController;
+    P_NSTEL_T_BITResultType A_energyStorage;
+    P_NSTEL_T_BITResultType A_directPower;
+    P_NSTEL_T_BITResultType A_cableLoop;
+    P_NSTEL_T_BITResultType A_upDownPark;
+    P_NSTEL_T_BITResultType A_roundPark;
+    P_NSTEL_T_BITResultType A_mainCannonLock;
+    P_NSTEL_T_BITResultType A_controllerNetwork;
+} P_NSTEL_C_CannonDrivingDevice_PBIT;
+#define P_NSTEL_C_CannonDrivingDevice_PBIT_TYPE  "P_NSTEL::C_CannonDrivingDevice_PBIT"
+#define P_NSTEL_C_CannonDrivingDevice_PBIT_TOPIC "P_NSTEL__C_CannonDrivingDevice_PBIT"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_IdentifierType A_cannonDrivingDevice_sourceID;
+    P_LDM_Common_T_Int32 A_referenceNum;
+    P_LDM_Common_T_Boolean A_BITRunning;
+    P_NSTEL_T_BITResultType A_upDownMotor;
+    P_NSTEL_T_BITResultType A_roundMotor;
+    P_NSTEL_T_BITResultType A_upDownAmp;
+    P_NSTEL_T_BITResultType A_roundAmp;
+    P_NSTEL_T_BITResultType A_baseGiro;
+    P_NSTEL_T_BITResultType A_topForwardGiro;
+    P_NSTEL_T_BITResultType A_vehicleForwardGiro;
+    P_NSTEL_T_BITResultType A_powerController;
+    P_NSTEL_T_BITResultType A_energyStorage;
+    P_NSTEL_T_BITResultType A_directPower;
+    P_NSTEL_T_BITResultType A_cableLoop;
+} P_NSTEL_C_CannonDrivingDevice_IBIT;
+#define P_NSTEL_C_CannonDrivingDevice_IBIT_TYPE  "P_NSTEL::C_CannonDrivingDevice_IBIT"
+#define P_NSTEL_C_CannonDrivingDevice_IBIT_TOPIC "P_NSTEL__C_CannonDrivingDevice_IBIT"
+
+/* ---- P_Usage_And_Condition_Monitoring_PSM ---- */
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_Monitored_Entity_StateType_ON = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_Monitored_Entity_StateType_OFF = 1
+} P_Usage_And_Condition_Monitoring_PSM_T_Monitored_Entity_StateType;
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_BITType_C_BIT = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_BITType_P_BIT = 1,
+    P_Usage_And_Condition_Monitoring_PSM_L_BITType_I_BIT = 2
+} P_Usage_And_Condition_Monitoring_PSM_T_BITType;
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_OPERATIONAL = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_DEGRADED = 1,
+    P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_NOT_OPERATIONAL = 2,
+    P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_UNKNOWN = 3
+} P_Usage_And_Condition_Monitoring_PSM_T_HealthStatus;
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_MonitoredCharacteristicKind_INSTANT = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_MonitoredCharacteristicKind_CUMULATIVE = 1
+} P_Usage_And_Condition_Monitoring_PSM_T_MonitoredCharacteristicKind;
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_NO_WARNING = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_PRE_WARNING = 1,
+    P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_WARNING = 2
+} P_Usage_And_Condition_Monitoring_PSM_T_MonitoredDataWarningLevel;
+
+typedef enum {
+    P_Usage_And_Condition_Monitoring_PSM_L_ThresholdType_MIN = 0,
+    P_Usage_And_Condition_Monitoring_PSM_L_ThresholdType_MAX = 1
+} P_Usage_And_Condition_Monitoring_PSM_T_ThresholdType;
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_DateTimeType A_eventOccurenceDate;
+    P_LDM_Common_T_Double A_standardFaultCode;
+    P_LDM_Common_T_LongString A_proprietaryFaultCode;
+    P_LDM_Common_T_Boolean A_predictedFailure;
+    P_LDM_Common_T_LongString A_failureDescription;
+    P_LDM_Common_T_LongString A_causeDescription;
+    P_LDM_Common_T_LongString A_operationalConsequenceDescription;
+    P_LDM_Common_T_LongString A_operatorActionDescription;
+    P_LDM_Common_T_LongString A_maintenanceActionDescription;
+    P_LDM_Common_T_LongString A_complementaryInformation;
+    P_LDM_Common_T_LongString A_eventDocumentationURI;
+    P_LDM_Common_T_IdentifierType A_monitoredEntity_sourceID;
+} P_Usage_And_Condition_Monitoring_PSM_C_Failure_Event;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Failure_Event_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Failure_Event"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Failure_Event_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Failure_Event"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Int32 A_serialNumber;
+    P_LDM_Common_T_Int32 A_version;
+    P_LDM_Common_T_Int32 A_configuration;
+    P_LDM_Common_T_IdentifierType A_subSystem_sourceID;
+} P_Usage_And_Condition_Monitoring_PSM_C_Installed_Software;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Installed_Software_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Installed_Software"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Installed_Software_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Installed_Software"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Double A_value;
+    P_LDM_Common_T_IdentifierType A_monitoredEntity_sourceID;
+    P_LDM_Common_T_IdentifierType A_specification_sourceID;
+    P_LDM_Common_T_IdentifierType A_thresholdExceedenceEvents_sourceID[100];
+    uint32_t A_thresholdExceedenceEvents_sourceID_length;
+} P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Monitored_Characteristic"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Monitored_Characteristic"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_ShortString A_unit;
+    P_LDM_Common_T_LongString A_descriptor;
+    P_LDM_Common_T_Int32 A_publishingIntervalInSeconds;
+    P_Usage_And_Condition_Monitoring_PSM_T_MonitoredCharacteristicKind A_characteristicKind;
+    P_LDM_Common_T_IdentifierType A_specifiedMonitoredCharacteristic_sourceID[100];
+    uint32_t A_specifiedMonitoredCharacteristic_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_thresholds_sourceID;
+} P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_Specification;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_Specification_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Monitored_Characteristic_Specification"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_Specification_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Monitored_Characteristic_Specification"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_recipientID;    /* key */
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_Int32 A_referenceNum;
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_Usage_And_Condition_Monitoring_PSM_T_BITType A_type;
+} P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_runBIT;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_runBIT_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Monitored_Entity_runBIT"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_runBIT_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Monitored_Entity_runBIT"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_Usage_And_Condition_Monitoring_PSM_T_HealthStatus A_healthStatus;
+    P_Usage_And_Condition_Monitoring_PSM_T_Monitored_Entity_StateType A_currentState;
+    P_LDM_Common_T_IdentifierType A_specification_sourceID;
+    P_LDM_Common_T_IdentifierType A_monitoredCharacteristics_sourceID[100];
+    uint32_t A_monitoredCharacteristics_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_failureEvents_sourceID[100];
+    uint32_t A_failureEvents_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_installedSoftware_sourceID[100];
+    uint32_t A_installedSoftware_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_preventativeMaintenanceRecomendedEvents_sourceID[100];
+    uint32_t A_preventativeMaintenanceRecomendedEvents_sourceID_length;
+} P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Monitored_Entity"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Monitored_Entity"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Boolean A_cumulativeMonitoredCharacteristicsOutputSupported;
+    P_LDM_Common_T_Boolean A_failureStandardFaultCodeSupported;
+    P_LDM_Common_T_Boolean A_failureProprietaryFaultCodeSupported;
+    P_LDM_Common_T_Boolean A_failureDescriptionSupported;
+    P_LDM_Common_T_Boolean A_failureCauseDescriptionSupported;
+    P_LDM_Common_T_Boolean A_failureOperationalConsequenceDescriptionSupported;
+    P_LDM_Common_T_Boolean A_failureOperatorActionDescriptionSupported;
+    P_LDM_Common_T_Boolean A_failureMaintenanceActionDescriptionSupported;
+    P_LDM_Common_T_Boolean A_failureComplementaryInformationSupported;
+    P_LDM_Common_T_Boolean A_failureDocumentationURISupported;
+    P_LDM_Common_T_DateTimeType A_installationDateTime;
+    P_LDM_Common_T_IdentifierType A_specifiedMonitoredEntities_sourceID[100];
+    uint32_t A_specifiedMonitoredEntities_sourceID_length;
+} P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_Specification;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_Specification_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Monitored_Entity_Specification"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_Specification_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Monitored_Entity_Specification"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_MediumString A_dataDescriptor;
+    P_LDM_Common_T_ShortString A_dataUnit;
+    P_LDM_Common_T_Double A_dataValue;
+    P_LDM_Common_T_Double A_preventiveMaintenanceThreshold;
+    P_LDM_Common_T_DateTimeType A_occurrenceDateTime;
+    P_LDM_Common_T_IdentifierType A_subSystem_sourceID;
+} P_Usage_And_Condition_Monitoring_PSM_C_Preventive_Maintenance_Recommended_Event;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Preventive_Maintenance_Recommended_Event_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Preventive_Maintenance_Recommended_Event"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Preventive_Maintenance_Recommended_Event_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Preventive_Maintenance_Recommended_Event"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_MediumString A_name;
+    P_LDM_Common_T_Double A_value;
+    P_Usage_And_Condition_Monitoring_PSM_T_ThresholdType A_type;
+    P_LDM_Common_T_Int32 A_maxDuration;
+    P_LDM_Common_T_Int32 A_maxNumberOfRepetitions;
+    P_LDM_Common_T_IdentifierType A_conditionedThresholds_sourceID[100];
+    uint32_t A_conditionedThresholds_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_conditioningThreshold_sourceID[100];
+    uint32_t A_conditioningThreshold_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_concernedCharacteristic_sourceID;
+    P_LDM_Common_T_IdentifierType A_specification_sourceID;
+    P_LDM_Common_T_IdentifierType A_exceedenceEvents_sourceID[100];
+    uint32_t A_exceedenceEvents_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_conditionongThreshold_sourceID;
+    P_LDM_Common_T_IdentifierType A_conditionedThreshold_sourceID[100];
+    uint32_t A_conditionedThreshold_sourceID_length;
+} P_Usage_And_Condition_Monitoring_PSM_C_Threshold;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Threshold"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Threshold"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_DateTimeType A_eventOccurenceDate;
+    P_LDM_Common_T_Double A_measuredValue;
+    P_LDM_Common_T_IdentifierType A_inducedEvents_sourceID[100];
+    uint32_t A_inducedEvents_sourceID_length;
+    P_LDM_Common_T_IdentifierType A_inducingEvent_sourceID;
+    P_LDM_Common_T_IdentifierType A_concernedCharacteristic_sourceID;
+    P_LDM_Common_T_IdentifierType A_exceededThreshold_sourceID;
+} P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Exceedence_Event;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Exceedence_Event_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Threshold_Exceedence_Event"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Exceedence_Event_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Threshold_Exceedence_Event"
+
+typedef struct {
+    P_LDM_Common_T_IdentifierType A_sourceID;    /* key */
+    P_LDM_Common_T_DateTimeType A_timeOfDataGeneration;
+    P_LDM_Common_T_Boolean A_valueThresholdSupported;
+    P_LDM_Common_T_Boolean A_durationThresholdSupported;
+    P_LDM_Common_T_Boolean A_repetitionsThresholdSupported;
+    P_LDM_Common_T_IdentifierType A_specifiedThreshold_sourceID[100];
+    uint32_t A_specifiedThreshold_sourceID_length;
+} P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Specification;
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Specification_TYPE  "P_Usage_And_Condition_Monitoring_PSM::C_Threshold_Specification"
+#define P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Specification_TOPIC "P_Usage_And_Condition_Monitoring_PSM__C_Threshold_Specification"
+
+#ifdef __cplusplus
+
+#include "legacy_reflect.hpp"
+
+LEGACY_REFLECT_ENUM_BEGIN(P_LDM_Common_T_RAGType)
+    LEGACY_REFLECT_ENUMERATOR("L_RAGType_RED", P_LDM_Common_L_RAGType_RED)
+    LEGACY_REFLECT_ENUMERATOR("L_RAGType_AMBER", P_LDM_Common_L_RAGType_AMBER)
+    LEGACY_REFLECT_ENUMERATOR("L_RAGType_GREEN", P_LDM_Common_L_RAGType_GREEN)
+LEGACY_REFLECT_ENUM_END(P_LDM_Common_T_RAGType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_Position2DType)
+    LEGACY_REFLECT_FIELD(A_xPosition)
+    LEGACY_REFLECT_FIELD(A_yPosition)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_Position2DType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_LDM_Common_T_Axis3DType)
+    LEGACY_REFLECT_ENUMERATOR("L_Axis3DType_X_AXIS", P_LDM_Common_L_Axis3DType_X_AXIS)
+    LEGACY_REFLECT_ENUMERATOR("L_Axis3DType_Y_AXIS", P_LDM_Common_L_Axis3DType_Y_AXIS)
+    LEGACY_REFLECT_ENUMERATOR("L_Axis3DType_Z_AXIS", P_LDM_Common_L_Axis3DType_Z_AXIS)
+LEGACY_REFLECT_ENUM_END(P_LDM_Common_T_Axis3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_Size2DType)
+    LEGACY_REFLECT_FIELD(A_xSize)
+    LEGACY_REFLECT_FIELD(A_ySize)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_Size2DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_IdentifierType)
+    LEGACY_REFLECT_FIELD(A_resourceId)
+    LEGACY_REFLECT_FIELD(A_instanceId)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_IdentifierType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_DurationType)
+    LEGACY_REFLECT_FIELD(A_seconds)
+    LEGACY_REFLECT_FIELD(A_nanoseconds)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_DurationType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_DateTimeType)
+    LEGACY_REFLECT_FIELD(A_second)
+    LEGACY_REFLECT_FIELD(A_nanoseconds)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_DateTimeType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_LinearAcceleration3DType)
+    LEGACY_REFLECT_FIELD(A_xAcceleration)
+    LEGACY_REFLECT_FIELD(A_yAcceleration)
+    LEGACY_REFLECT_FIELD(A_zAcceleration)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_LinearAcceleration3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_AttitudeType)
+    LEGACY_REFLECT_FIELD(A_pitch)
+    LEGACY_REFLECT_FIELD(A_roll)
+    LEGACY_REFLECT_FIELD(A_yaw)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_AttitudeType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_PointPolar3DType)
+    LEGACY_REFLECT_FIELD(A_angle)
+    LEGACY_REFLECT_FIELD(A_elevation)
+    LEGACY_REFLECT_FIELD(A_radius)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_PointPolar3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_CoordinatePolar3DType)
+    LEGACY_REFLECT_FIELD(A_angle)
+    LEGACY_REFLECT_FIELD(A_elevation)
+    LEGACY_REFLECT_FIELD(A_range)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_CoordinatePolar3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_CoordinatePolar2DType)
+    LEGACY_REFLECT_FIELD(A_angle)
+    LEGACY_REFLECT_FIELD(A_range)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_CoordinatePolar2DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_AngularAcceleration3DType)
+    LEGACY_REFLECT_FIELD(A_pitch)
+    LEGACY_REFLECT_FIELD(A_roll)
+    LEGACY_REFLECT_FIELD(A_yaw)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_AngularAcceleration3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_AngularVelocity3DType)
+    LEGACY_REFLECT_FIELD(A_pitch)
+    LEGACY_REFLECT_FIELD(A_roll)
+    LEGACY_REFLECT_FIELD(A_yaw)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_AngularVelocity3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_LinearVelocity3DType)
+    LEGACY_REFLECT_FIELD(A_heading)
+    LEGACY_REFLECT_FIELD(A_speed)
+    LEGACY_REFLECT_FIELD(A_vrate)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_LinearVelocity3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_RotationalOffsetType)
+    LEGACY_REFLECT_FIELD(A_pitchOffset)
+    LEGACY_REFLECT_FIELD(A_rollOffset)
+    LEGACY_REFLECT_FIELD(A_yawOffset)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_RotationalOffsetType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_Coordinate2DType)
+    LEGACY_REFLECT_FIELD(A_latitude)
+    LEGACY_REFLECT_FIELD(A_longitude)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_Coordinate2DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_LinearSpeed3DType)
+    LEGACY_REFLECT_FIELD(A_xSpeed)
+    LEGACY_REFLECT_FIELD(A_ySpeed)
+    LEGACY_REFLECT_FIELD(A_zSpeed)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_LinearSpeed3DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_LinearOffsetType)
+    LEGACY_REFLECT_FIELD(A_xOffset)
+    LEGACY_REFLECT_FIELD(A_yOffset)
+    LEGACY_REFLECT_FIELD(A_zOffset)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_LinearOffsetType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_LinearVelocity2DType)
+    LEGACY_REFLECT_FIELD(A_heading)
+    LEGACY_REFLECT_FIELD(A_speed)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_LinearVelocity2DType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_LDM_Common_T_Coordinate3DType)
+    LEGACY_REFLECT_FIELD(A_altitude)
+    LEGACY_REFLECT_FIELD(A_latitude)
+    LEGACY_REFLECT_FIELD(A_longitude)
+LEGACY_REFLECT_STRUCT_END(P_LDM_Common_T_Coordinate3DType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_LDM_Common_T_CommandResponseType)
+    LEGACY_REFLECT_ENUMERATOR("L_CommandResponseType_Command_Failed", P_LDM_Common_L_CommandResponseType_Command_Failed)
+    LEGACY_REFLECT_ENUMERATOR("L_CommandResponseType_Command_Not_Available", P_LDM_Common_L_CommandResponseType_Command_Not_Available)
+    LEGACY_REFLECT_ENUMERATOR("L_CommandResponseType_Command_Not_Recognised", P_LDM_Common_L_CommandResponseType_Command_Not_Recognised)
+    LEGACY_REFLECT_ENUMERATOR("L_CommandResponseType_Resource_Control_Failure", P_LDM_Common_L_CommandResponseType_Resource_Control_Failure)
+LEGACY_REFLECT_ENUM_END(P_LDM_Common_T_CommandResponseType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_OperationModeType)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_NORMAL", P_NSTEL_L_OperationModeType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_EMERGENCY", P_NSTEL_L_OperationModeType_EMERGENCY)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_MANUAL", P_NSTEL_L_OperationModeType_MANUAL)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_OperationModeType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_PalmModeType)
+    LEGACY_REFLECT_ENUMERATOR("L_PalmModeType_ON", P_NSTEL_L_PalmModeType_ON)
+    LEGACY_REFLECT_ENUMERATOR("L_PalmModeType_OFF", P_NSTEL_L_PalmModeType_OFF)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_PalmModeType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_TargetFixType)
+    LEGACY_REFLECT_ENUMERATOR("L_TargetFixType_FIXED", P_NSTEL_L_TargetFixType_FIXED)
+    LEGACY_REFLECT_ENUMERATOR("L_TargetFixType_ETC", P_NSTEL_L_TargetFixType_ETC)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_TargetFixType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_ArmPositionType)
+    LEGACY_REFLECT_ENUMERATOR("L_ArmPositionType_RELEASE", P_NSTEL_L_ArmPositionType_RELEASE)
+    LEGACY_REFLECT_ENUMERATOR("L_ArmPositionType_DRIVING", P_NSTEL_L_ArmPositionType_DRIVING)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_ArmPositionType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_CannonRestoreType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonRestoreType_RELEASE", P_NSTEL_L_CannonRestoreType_RELEASE)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonRestoreType_RESTORE", P_NSTEL_L_CannonRestoreType_RESTORE)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_CannonRestoreType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_CannonFixType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixType_RELEASE", P_NSTEL_L_CannonFixType_RELEASE)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixType_FIX", P_NSTEL_L_CannonFixType_FIX)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_CannonFixType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_EquipOpenStatusType)
+    LEGACY_REFLECT_ENUMERATOR("L_EquipOpenStatusType_CLOSE", P_NSTEL_L_EquipOpenStatusType_CLOSE)
+    LEGACY_REFLECT_ENUMERATOR("L_EquipOpenStatusType_OPEN", P_NSTEL_L_EquipOpenStatusType_OPEN)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_EquipOpenStatusType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_CannonFixStatusType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixStatusType_NORMAL", P_NSTEL_L_CannonFixStatusType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixStatusType_FIXED", P_NSTEL_L_CannonFixStatusType_FIXED)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_CannonFixStatusType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_DeckClearanceType)
+    LEGACY_REFLECT_ENUMERATOR("L_DeckClearanceType_OUT_OF_DECK", P_NSTEL_L_DeckClearanceType_OUT_OF_DECK)
+    LEGACY_REFLECT_ENUMERATOR("L_DeckClearanceType_IN_DECK", P_NSTEL_L_DeckClearanceType_IN_DECK)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_DeckClearanceType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_CannonDrivingType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonDrivingType_DRIVING", P_NSTEL_L_CannonDrivingType_DRIVING)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonDrivingType_DONE", P_NSTEL_L_CannonDrivingType_DONE)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_CannonDrivingType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_CannonLockType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonLockType_NORMAL", P_NSTEL_L_CannonLockType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonLockType_LOCKED", P_NSTEL_L_CannonLockType_LOCKED)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_CannonLockType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_ShutdownType)
+    LEGACY_REFLECT_ENUMERATOR("L_ShutdownType_UNKNOWN", P_NSTEL_L_ShutdownType_UNKNOWN)
+    LEGACY_REFLECT_ENUMERATOR("L_ShutdownType_SHUTDOWN", P_NSTEL_L_ShutdownType_SHUTDOWN)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_ShutdownType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_EnergyStorageStatusType)
+    LEGACY_REFLECT_ENUMERATOR("L_EnergyStorageStatusType_NORMAL", P_NSTEL_L_EnergyStorageStatusType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_EnergyStorageStatusType_DISCHARGE", P_NSTEL_L_EnergyStorageStatusType_DISCHARGE)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_EnergyStorageStatusType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_NSTEL_T_BITResultType)
+    LEGACY_REFLECT_ENUMERATOR("L_BITResultType_NORMAL", P_NSTEL_L_BITResultType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_BITResultType_ABNORMAL", P_NSTEL_L_BITResultType_ABNORMAL)
+LEGACY_REFLECT_ENUM_END(P_NSTEL_T_BITResultType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_specification_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_Specification)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_powerOnBITSupported)
+    LEGACY_REFLECT_FIELD(A_continousBITSupported)
+    LEGACY_REFLECT_FIELD(A_initiatedBITSupported)
+    LEGACY_REFLECT_FIELD(A_continousBITInterval)
+    /* A_specifiedCannonDrivingDevices_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_Specification)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_commandDriving)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_recipientID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_referenceNum)
+    LEGACY_REFLECT_FIELD(A_roundPosition)
+    LEGACY_REFLECT_FIELD(A_upDownPosition)
+    LEGACY_REFLECT_FIELD(A_roundAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_upDownAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_cannonUpDownAngle)
+    LEGACY_REFLECT_FIELD(A_topRelativeAngle)
+    LEGACY_REFLECT_FIELD(A_operationMode)
+    LEGACY_REFLECT_FIELD(A_parm)
+    LEGACY_REFLECT_FIELD(A_targetFix)
+    LEGACY_REFLECT_FIELD(A_autoArmPosition)
+    LEGACY_REFLECT_FIELD(A_manualArmPosition)
+    LEGACY_REFLECT_FIELD(A_mainCannonRestore)
+    LEGACY_REFLECT_FIELD(A_mainCannonFix)
+    LEGACY_REFLECT_FIELD(A_closureEquipOpenStatus)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_commandDriving)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_Signal)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_recipientID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_azAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_e1AngleVelocity)
+    LEGACY_REFLECT_FIELD(A_energyStorage)
+    LEGACY_REFLECT_FIELD(A_mainCannonFixStatus)
+    LEGACY_REFLECT_FIELD(A_deckCleance)
+    LEGACY_REFLECT_FIELD(A_autoArmPositionComplement)
+    LEGACY_REFLECT_FIELD(A_manualArmPositionComplement)
+    LEGACY_REFLECT_FIELD(A_mainCannonRestoreComplement)
+    LEGACY_REFLECT_FIELD(A_armSafetyMainCannonLock)
+    LEGACY_REFLECT_FIELD(A_shutdown)
+    LEGACY_REFLECT_FIELD(A_roundGiro)
+    LEGACY_REFLECT_FIELD(A_upDownGiro)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_Signal)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_VehicleSpeed)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_value)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_VehicleSpeed)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_PowerOnBIT)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_cannonDrivingDevice_sourceID)
+    LEGACY_REFLECT_FIELD(A_BITRunning)
+    LEGACY_REFLECT_FIELD(A_upDownMotor)
+    LEGACY_REFLECT_FIELD(A_roundMotor)
+    LEGACY_REFLECT_FIELD(A_upDownAmp)
+    LEGACY_REFLECT_FIELD(A_roundAmp)
+    LEGACY_REFLECT_FIELD(A_baseGiro)
+    LEGACY_REFLECT_FIELD(A_topForwardGiro)
+    LEGACY_REFLECT_FIELD(A_vehicleForwardGiro)
+    LEGACY_REFLECT_FIELD(A_powerController)
+    LEGACY_REFLECT_FIELD(A_energyStorage)
+    LEGACY_REFLECT_FIELD(A_directPower)
+    LEGACY_REFLECT_FIELD(A_cableLoop)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_PowerOnBIT)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_PBIT)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_cannonDrivingDevice_sourceID)
+    LEGACY_REFLECT_FIELD(A_upDownMotor)
+    LEGACY_REFLECT_FIELD(A_roundMotor)
+    LEGACY_REFLECT_FIELD(A_upDownAmp)
+    LEGACY_REFLECT_FIELD(A_roundAmp)
+    LEGACY_REFLECT_FIELD(A_baseGiro)
+    LEGACY_REFLECT_FIELD(A_topForwardGiro)
+    LEGACY_REFLECT_FIELD(A_vehicleForwardGiro)
+    LEGACY_REFLECT_FIELD(A_powerController)
+    LEGACY_REFLECT_FIELD(A_energyStorage)
+    LEGACY_REFLECT_FIELD(A_directPower)
+    LEGACY_REFLECT_FIELD(A_cableLoop)
+    LEGACY_REFLECT_FIELD(A_upDownPark)
+    LEGACY_REFLECT_FIELD(A_roundPark)
+    LEGACY_REFLECT_FIELD(A_mainCannonLock)
+    LEGACY_REFLECT_FIELD(A_controllerNetwork)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_PBIT)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_NSTEL_C_CannonDrivingDevice_IBIT)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_cannonDrivingDevice_sourceID)
+    LEGACY_REFLECT_FIELD(A_referenceNum)
+    LEGACY_REFLECT_FIELD(A_BITRunning)
+    LEGACY_REFLECT_FIELD(A_upDownMotor)
+    LEGACY_REFLECT_FIELD(A_roundMotor)
+    LEGACY_REFLECT_FIELD(A_upDownAmp)
+    LEGACY_REFLECT_FIELD(A_roundAmp)
+    LEGACY_REFLECT_FIELD(A_baseGiro)
+    LEGACY_REFLECT_FIELD(A_topForwardGiro)
+    LEGACY_REFLECT_FIELD(A_vehicleForwardGiro)
+    LEGACY_REFLECT_FIELD(A_powerController)
+    LEGACY_REFLECT_FIELD(A_energyStorage)
+    LEGACY_REFLECT_FIELD(A_directPower)
+    LEGACY_REFLECT_FIELD(A_cableLoop)
+LEGACY_REFLECT_STRUCT_END(P_NSTEL_C_CannonDrivingDevice_IBIT)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_Monitored_Entity_StateType)
+    LEGACY_REFLECT_ENUMERATOR("L_Monitored_Entity_StateType_ON", P_Usage_And_Condition_Monitoring_PSM_L_Monitored_Entity_StateType_ON)
+    LEGACY_REFLECT_ENUMERATOR("L_Monitored_Entity_StateType_OFF", P_Usage_And_Condition_Monitoring_PSM_L_Monitored_Entity_StateType_OFF)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_Monitored_Entity_StateType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_BITType)
+    LEGACY_REFLECT_ENUMERATOR("L_BITType_C_BIT", P_Usage_And_Condition_Monitoring_PSM_L_BITType_C_BIT)
+    LEGACY_REFLECT_ENUMERATOR("L_BITType_P_BIT", P_Usage_And_Condition_Monitoring_PSM_L_BITType_P_BIT)
+    LEGACY_REFLECT_ENUMERATOR("L_BITType_I_BIT", P_Usage_And_Condition_Monitoring_PSM_L_BITType_I_BIT)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_BITType)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_HealthStatus)
+    LEGACY_REFLECT_ENUMERATOR("L_HealthStatus_OPERATIONAL", P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_OPERATIONAL)
+    LEGACY_REFLECT_ENUMERATOR("L_HealthStatus_DEGRADED", P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_DEGRADED)
+    LEGACY_REFLECT_ENUMERATOR("L_HealthStatus_NOT_OPERATIONAL", P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_NOT_OPERATIONAL)
+    LEGACY_REFLECT_ENUMERATOR("L_HealthStatus_UNKNOWN", P_Usage_And_Condition_Monitoring_PSM_L_HealthStatus_UNKNOWN)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_HealthStatus)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_MonitoredCharacteristicKind)
+    LEGACY_REFLECT_ENUMERATOR("L_MonitoredCharacteristicKind_INSTANT", P_Usage_And_Condition_Monitoring_PSM_L_MonitoredCharacteristicKind_INSTANT)
+    LEGACY_REFLECT_ENUMERATOR("L_MonitoredCharacteristicKind_CUMULATIVE", P_Usage_And_Condition_Monitoring_PSM_L_MonitoredCharacteristicKind_CUMULATIVE)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_MonitoredCharacteristicKind)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_MonitoredDataWarningLevel)
+    LEGACY_REFLECT_ENUMERATOR("L_MonitoredDataWarningLevel_NO_WARNING", P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_NO_WARNING)
+    LEGACY_REFLECT_ENUMERATOR("L_MonitoredDataWarningLevel_PRE_WARNING", P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_PRE_WARNING)
+    LEGACY_REFLECT_ENUMERATOR("L_MonitoredDataWarningLevel_WARNING", P_Usage_And_Condition_Monitoring_PSM_L_MonitoredDataWarningLevel_WARNING)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_MonitoredDataWarningLevel)
+
+LEGACY_REFLECT_ENUM_BEGIN(P_Usage_And_Condition_Monitoring_PSM_T_ThresholdType)
+    LEGACY_REFLECT_ENUMERATOR("L_ThresholdType_MIN", P_Usage_And_Condition_Monitoring_PSM_L_ThresholdType_MIN)
+    LEGACY_REFLECT_ENUMERATOR("L_ThresholdType_MAX", P_Usage_And_Condition_Monitoring_PSM_L_ThresholdType_MAX)
+LEGACY_REFLECT_ENUM_END(P_Usage_And_Condition_Monitoring_PSM_T_ThresholdType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Failure_Event)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_eventOccurenceDate)
+    LEGACY_REFLECT_FIELD(A_standardFaultCode)
+    LEGACY_REFLECT_FIELD(A_proprietaryFaultCode)
+    LEGACY_REFLECT_FIELD(A_predictedFailure)
+    LEGACY_REFLECT_FIELD(A_failureDescription)
+    LEGACY_REFLECT_FIELD(A_causeDescription)
+    LEGACY_REFLECT_FIELD(A_operationalConsequenceDescription)
+    LEGACY_REFLECT_FIELD(A_operatorActionDescription)
+    LEGACY_REFLECT_FIELD(A_maintenanceActionDescription)
+    LEGACY_REFLECT_FIELD(A_complementaryInformation)
+    LEGACY_REFLECT_FIELD(A_eventDocumentationURI)
+    LEGACY_REFLECT_FIELD(A_monitoredEntity_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Failure_Event)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Installed_Software)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_serialNumber)
+    LEGACY_REFLECT_FIELD(A_version)
+    LEGACY_REFLECT_FIELD(A_configuration)
+    LEGACY_REFLECT_FIELD(A_subSystem_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Installed_Software)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_value)
+    LEGACY_REFLECT_FIELD(A_monitoredEntity_sourceID)
+    LEGACY_REFLECT_FIELD(A_specification_sourceID)
+    /* A_thresholdExceedenceEvents_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_Specification)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_unit)
+    LEGACY_REFLECT_FIELD(A_descriptor)
+    LEGACY_REFLECT_FIELD(A_publishingIntervalInSeconds)
+    LEGACY_REFLECT_FIELD(A_characteristicKind)
+    /* A_specifiedMonitoredCharacteristic_sourceID: sequence, not described */
+    LEGACY_REFLECT_FIELD(A_thresholds_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Characteristic_Specification)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_runBIT)
+    LEGACY_REFLECT_FIELD(A_recipientID)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_referenceNum)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_type)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_runBIT)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_healthStatus)
+    LEGACY_REFLECT_FIELD(A_currentState)
+    LEGACY_REFLECT_FIELD(A_specification_sourceID)
+    /* A_monitoredCharacteristics_sourceID: sequence, not described */
+    /* A_failureEvents_sourceID: sequence, not described */
+    /* A_installedSoftware_sourceID: sequence, not described */
+    /* A_preventativeMaintenanceRecomendedEvents_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_Specification)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_cumulativeMonitoredCharacteristicsOutputSupported)
+    LEGACY_REFLECT_FIELD(A_failureStandardFaultCodeSupported)
+    LEGACY_REFLECT_FIELD(A_failureProprietaryFaultCodeSupported)
+    LEGACY_REFLECT_FIELD(A_failureDescriptionSupported)
+    LEGACY_REFLECT_FIELD(A_failureCauseDescriptionSupported)
+    LEGACY_REFLECT_FIELD(A_failureOperationalConsequenceDescriptionSupported)
+    LEGACY_REFLECT_FIELD(A_failureOperatorActionDescriptionSupported)
+    LEGACY_REFLECT_FIELD(A_failureMaintenanceActionDescriptionSupported)
+    LEGACY_REFLECT_FIELD(A_failureComplementaryInformationSupported)
+    LEGACY_REFLECT_FIELD(A_failureDocumentationURISupported)
+    LEGACY_REFLECT_FIELD(A_installationDateTime)
+    /* A_specifiedMonitoredEntities_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Monitored_Entity_Specification)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Preventive_Maintenance_Recommended_Event)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_dataDescriptor)
+    LEGACY_REFLECT_FIELD(A_dataUnit)
+    LEGACY_REFLECT_FIELD(A_dataValue)
+    LEGACY_REFLECT_FIELD(A_preventiveMaintenanceThreshold)
+    LEGACY_REFLECT_FIELD(A_occurrenceDateTime)
+    LEGACY_REFLECT_FIELD(A_subSystem_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Preventive_Maintenance_Recommended_Event)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Threshold)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_name)
+    LEGACY_REFLECT_FIELD(A_value)
+    LEGACY_REFLECT_FIELD(A_type)
+    LEGACY_REFLECT_FIELD(A_maxDuration)
+    LEGACY_REFLECT_FIELD(A_maxNumberOfRepetitions)
+    /* A_conditionedThresholds_sourceID: sequence, not described */
+    /* A_conditioningThreshold_sourceID: sequence, not described */
+    LEGACY_REFLECT_FIELD(A_concernedCharacteristic_sourceID)
+    LEGACY_REFLECT_FIELD(A_specification_sourceID)
+    /* A_exceedenceEvents_sourceID: sequence, not described */
+    LEGACY_REFLECT_FIELD(A_conditionongThreshold_sourceID)
+    /* A_conditionedThreshold_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Threshold)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Exceedence_Event)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_eventOccurenceDate)
+    LEGACY_REFLECT_FIELD(A_measuredValue)
+    /* A_inducedEvents_sourceID: sequence, not described */
+    LEGACY_REFLECT_FIELD(A_inducingEvent_sourceID)
+    LEGACY_REFLECT_FIELD(A_concernedCharacteristic_sourceID)
+    LEGACY_REFLECT_FIELD(A_exceededThreshold_sourceID)
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Exceedence_Event)
+
+LEGACY_REFLECT_STRUCT_BEGIN(P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Specification)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_valueThresholdSupported)
+    LEGACY_REFLECT_FIELD(A_durationThresholdSupported)
+    LEGACY_REFLECT_FIELD(A_repetitionsThresholdSupported)
+    /* A_specifiedThreshold_sourceID: sequence, not described */
+LEGACY_REFLECT_STRUCT_END(P_Usage_And_Condition_Monitoring_PSM_C_Threshold_Specification)
+
+#endif /* __cplusplus */
+
+#endif /* PSM_TYPES_H */
@@ -13,6 +13,7 @@
 #include <stdbool.h>
 #include "legacy_agent.h"
 #include "demo_app_enums.h"
+#include "demo_app_wheel.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -270,6 +271,25 @@ typedef struct {
     T_CannonDrivingDeviceShutdownType shutdown;              // A_shutdown
 } ActuatorSignalState;
 
+// Published fields of ActuatorSignalState plus the tick they were sampled
+// at. The timer task copies one when it queues a signal event, so the
+// publisher worker never reads the live signal_state. Fits a cache line.
+typedef struct {
+    uint64_t tick;                // tick_count when sampled (ms)
+    double azAngle;
+    double e1AngleVelocity;
+    double roundGyro;
+    double upDownGyro;
+    uint8_t energyStorage;               // T_ChangingStatusType
+    uint8_t mainCannonFixStatus;         // T_MainCannonFixStatusType
+    uint8_t deckClearance;               // T_DekClearanceType
+    uint8_t autoArmPositionComplement;   // T_ArmPositionType
+    uint8_t manualArmPositionComple;     // T_ArmPositionType
+    uint8_t mainCannonRestoreComplement; // T_MainCannonReturnStatusType
+    uint8_t armSafetyMainCannonLock;     // T_ArmSafetyMainCannonLock
+    uint8_t shutdown;                    // T_CannonDrivingDeviceShutdownType
+} DemoSignalSample;
+
 // Vehicle Speed State
 // Based on P_NSTEL::C_Vehicle_Speed
 typedef struct {
@@ -325,16 +345,80 @@ typedef struct {
     BITComponentState result_components;
 } BITState;
 
+// resultBIT fields as they were when IBIT completed. The timer task copies
+// one when it queues resultBIT, so a new IBIT request cannot change the
+// reference number or results before the publisher worker writes them.
+typedef struct {
+    uint64_t time_ms;             // demo_timer_now_ms() at completion
+    uint32_t reference_num;       // ibit_reference_num
+    BITComponentState components; // result_components
+} DemoResultBitSample;
+
 /* ========================================================================
- * Main Context Structure
+ * Timer Jobs
  * ======================================================================== */
 
+// Internal jobs of the timer task (publish topics are registered separately)
+typedef enum {
+    DEMO_TIMER_JOB_IBIT = 0,     // IBIT completion (one-shot, 3s after start)
+    DEMO_TIMER_JOB_STATS,        // 1-second Hz window
+    DEMO_TIMER_JOB_COUNT
+} DemoTimerJobId;
+
+// Lateness histogram buckets: <50us, <200us, <1ms, <2ms, <5ms, >=5ms
+#define DEMO_TIMER_JITTER_BUCKETS 6
+
+// Run statistics of a timer job or publish topic
 typedef struct {
+    uint64_t period_ns;          // period the job is armed with
+    uint64_t first_run_ns;       // start of the rate window (reset when re-armed)
+    uint64_t last_run_ns;
+    uint32_t window_runs;        // runs since first_run_ns
+    uint32_t runs;
+    uint32_t overruns;           // whole periods skipped because the job ran late
+    uint64_t late_max_ns;
+    uint32_t late_hist[DEMO_TIMER_JITTER_BUCKETS];
+} DemoTimerJob;
+
+/* ========================================================================
+ * Periodic Publish Topics
+ * ======================================================================== */
+
+#define DEMO_MAX_PUBLISH_TOPICS 256
+
+struct DemoAppContext;
+typedef int (*DemoPublishFn)(struct DemoAppContext* ctx);
+
+// Sampled topics: capture copies the topic's state into a sample block on
+// the timer task when the topic is queued; publish writes that copy on the
+// publisher worker. The block is opaque to the publisher (size checked at
+// registration against DEMO_PUBLISHER_SAMPLE_SIZE).
+typedef void (*DemoSampleCaptureFn)(struct DemoAppContext* ctx, void* sample);
+typedef int (*DemoSamplePublishFn)(struct DemoAppContext* ctx, const void* sample);
+
+// A topic sampled by the timer task every period_ms while in Run state and
+// written by the publisher worker (pending samples coalesce)
+typedef struct {
+    const char* name;            // key for demo_app_set_publish_hz
+    int pub_slot;                // publisher slot (owns the publish function)
+    uint32_t period_ms;          // 0 = disabled
+    uint32_t default_period_ms;  // restored by demo_app_reset_publish_periods
+    uint32_t armed_period_ms;    // timer task only
+    DemoWheelTimer timer;        // timer task only
+    DemoTimerJob stats;
+} DemoPublishTopic;
+
+/* ========================================================================
+ * Main Context Structure
+ * ======================================================================== */
+
+typedef struct DemoAppContext {
     // State
     DemoState current_state;
     
     // LegacyLib handle
     LEGACY_HANDLE agent;
+    LEGACY_WRITER signal_writer;    // pre-encoded Signal envelope (200Hz)
     
     // DDS Configuration
     int domain_id;
@@ -349,13 +433,14 @@ typedef struct {
     BITState             bit_state;
     
     // Timing
-    uint64_t tick_count;         // 1ms tick counter
-    uint64_t last_200hz_tick;    // Last 200Hz update
-    uint64_t last_1hz_tick;      // Last 1Hz update
-    // Configurable publish periods (ms)
-    uint32_t signal_period_ms;   // default 5 (200Hz)
-    uint32_t cbit_period_ms;     // default 1000 (1Hz)
-    uint32_t pbit_period_ms;     // default 0 (only at start)
+    uint64_t tick_count;         // ms since timer start (monotonic clock)
+    uint64_t last_sim_tick;      // Simulation integrated up to this tick
+    DemoTimerJob timer_jobs[DEMO_TIMER_JOB_COUNT];
+    uint32_t timer_wakeups;      // Timer task wakeups
+
+    // Periodic publish topics (signal 200Hz, cbit 1Hz, pbit off by default)
+    DemoPublishTopic publish_topics[DEMO_MAX_PUBLISH_TOPICS];
+    uint32_t publish_topic_count;
     
     // Statistics (counters)
     uint32_t signal_pub_count;   // Actuator signal publish count
@@ -417,6 +502,17 @@ typedef struct {
 } DemoAppContext;
 
 /* Publish period control APIs */
+// Register a periodic publish topic (period_ms 0: disabled until set_publish_hz).
+// Only before demo_timer_init or after demo_timer_cleanup (init code): -1
+// while the timer runs. Only the name pointer is stored, so it must outlive
+// the registration (a string literal or static buffer).
+// Returns the topic index, or -1 if the name is taken or the table is full.
+int demo_app_register_publish_topic(DemoAppContext* ctx, const char* name, uint32_t period_ms, DemoPublishFn publish);
+// Same for a topic written from a snapshot: capture fills a sample_size
+// block when the timer queues the topic, publish writes it on the worker.
+int demo_app_register_sampled_topic(DemoAppContext* ctx, const char* name, uint32_t period_ms,
+                                    DemoSampleCaptureFn capture, DemoSamplePublishFn publish,
+                                    size_t sample_size);
 int demo_app_set_publish_hz(DemoAppContext* ctx, const char* topic, uint32_t hz);
 void demo_app_reset_publish_periods(DemoAppContext* ctx);
 
@@ -474,7 +570,7 @@ void demo_msg_cleanup(DemoAppContext* ctx);
 
 // Callbacks (called by LegacyLib when messages arrive)
 void demo_msg_on_runbit(LEGACY_HANDLE h, const LegacyEvent* evt, void* user);
-void demo_msg_on_actuator_control(LEGACY_HANDLE h, const LegacyEvent* evt, void* user);
+void demo_msg_on_actuator_control(LEGACY_HANDLE h, const LegacyEvent* evt, void* user_struct, void* user); // typed
 void demo_msg_on_vehicle_speed(LEGACY_HANDLE h, const LegacyEvent* evt, void* user);
 
 // Publish functions
@@ -483,6 +579,14 @@ int demo_msg_publish_cbit(DemoAppContext* ctx);
 int demo_msg_publish_result_bit(DemoAppContext* ctx);
 int demo_msg_publish_actuator_signal(DemoAppContext* ctx);
 
+// Actuator signal from a snapshot (publisher worker; see DemoSignalSample)
+void demo_msg_capture_actuator_signal(DemoAppContext* ctx, DemoSignalSample* out);
+int demo_msg_publish_actuator_signal_sample(DemoAppContext* ctx, const DemoSignalSample* sample);
+
+// resultBIT from a snapshot (publisher worker; see DemoResultBitSample)
+void demo_msg_capture_result_bit(DemoAppContext* ctx, DemoResultBitSample* out);
+int demo_msg_publish_result_bit_sample(DemoAppContext* ctx, const DemoResultBitSample* sample);
+
 // Test write functions (1회성 전송)
 int demo_msg_test_write_pbit(DemoAppContext* ctx);
 int demo_msg_test_write_cbit(DemoAppContext* ctx);
@@ -499,15 +603,29 @@ int demo_timer_init(DemoAppContext* ctx);
 // Cleanup timer subsystem
 void demo_timer_cleanup(DemoAppContext* ctx);
 
-// 1ms tick handler (call from VxWorks timer)
+// Advance tick_count from the clock and run the jobs that are due (timer task)
 void demo_timer_tick(DemoAppContext* ctx);
 
+// Current time in ms on the tick_count clock (any task). tick_count only
+// advances when the timer task wakes, so timestamps taken elsewhere use this.
+uint64_t demo_timer_now_ms(void);
+
+// Wake the timer task to pick up state, period and topic changes (any task)
+void demo_timer_kick(void);
+
+// Register the built-in publish topics (signal, cbit, pbit)
+void demo_timer_register_default_topics(DemoAppContext* ctx);
+
 // Check if timer is running
 int demo_timer_is_running(void);
 
-// Simulation update (position/velocity calculation)
+// Simulation update (one 1ms step of position/velocity)
 void demo_timer_update_simulation(DemoAppContext* ctx);
 
+// Names for status output
+const char* demo_timer_job_name(int job);
+const char* demo_timer_jitter_label(int bucket);
+
 /* ========================================================================
  * VxWorks Integration (demo_app_dkm.c)
  * ======================================================================== */
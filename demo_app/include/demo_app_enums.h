@@ -7,6 +7,8 @@
 #ifndef DEMO_APP_ENUMS_H
 #define DEMO_APP_ENUMS_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -175,6 +177,15 @@ T_MainCannonReturnType parse_main_cannon_return(const char* str);
 T_MainCannonFixType parse_main_cannon_fix(const char* str);
 T_EquipOpenLockType parse_equip_open_lock(const char* str);
 
+/* parse_bit_type on a span that need not be NUL-terminated (length known,
+ * e.g. a decoded string). Schema enumerator names are matched by perfect hash. */
+T_BITType parse_bit_type_n(const char* s, size_t len);
+
+/* Start-up check of the perfect-hash tables: NULL when every enumerator name
+ * sits in its own slot, else the first misplaced name (its lookups would
+ * silently fall back to the token scan). */
+const char* demo_enum_check(void);
+
 /* ========================================================================
  * Enum Formatting Functions (Enum Value -> JSON String)
  * ======================================================================== */
@@ -7,17 +7,63 @@
 extern "C" {
 #endif
 
+// Publisher topics (periodic topics plus one-shot events)
+#define DEMO_PUBLISHER_MAX_TOPICS (DEMO_MAX_PUBLISH_TOPICS + 8)
+
+// Queue capacity (events); coalescing keeps at most one event per periodic topic
+#define DEMO_PUBLISHER_QUEUE_SIZE 1024
+
+// Preallocated snapshots for sampled topics (power of two). A coalescing
+// sampled topic holds at most one pending block plus the one being written;
+// a non-coalescing one holds a block per queued event.
+#define DEMO_PUBLISHER_SAMPLE_POOL 64
+
+// Bytes per snapshot block (suitably aligned for any scalar member)
+#define DEMO_PUBLISHER_SAMPLE_SIZE 128
+
+typedef struct {
+    const char* name;
+    uint64_t queued;             // events put on the queue
+    uint64_t coalesced;          // samples merged into a pending event
+    uint64_t dropped;            // queue full / sample pool empty / stopped
+    uint64_t written;            // publish calls made by the worker
+    uint64_t latency_ns_total;   // enqueue -> write start
+    uint64_t latency_ns_max;
+    uint64_t write_ns_total;     // time spent in the publish function
+} DemoPublisherTopicStats;
+
 // Initialize publisher (creates queue + worker). Returns 0 on success.
 int demo_publisher_init(void);
 
 // Shutdown publisher and free resources.
 void demo_publisher_shutdown(void);
 
-// Enqueue a signal publish event (non-blocking). Returns 0 if enqueued, -1 if dropped.
-int demo_publisher_enqueue_signal(DemoAppContext* ctx);
+// Register a publisher topic; its publish function runs on the worker.
+// coalesce=1: at most one pending event (periodic samples, latest value wins).
+// Re-registering a name updates it. Only while the publisher is stopped
+// (before demo_publisher_init / after shutdown); 'name' is stored, not
+// copied. Returns the topic slot, or -1.
+int demo_publisher_register(const char* name, DemoPublishFn publish, int coalesce);
+
+// Register a sampled topic: each enqueue captures into a pool block and the
+// worker publishes that copy (a coalesced enqueue replaces the pending
+// sample). sample_size is the capture size, at most
+// DEMO_PUBLISHER_SAMPLE_SIZE. Same rules as demo_publisher_register.
+int demo_publisher_register_sampled(const char* name, DemoSampleCaptureFn capture,
+                                    DemoSamplePublishFn publish, size_t sample_size, int coalesce);
+
+// Enqueue a publish event (non-blocking). Returns 0 if enqueued, 1 if
+// coalesced into a pending event, -1 if dropped.
+// Single producer: call from the timer task only.
+int demo_publisher_enqueue(int slot, DemoAppContext* ctx);
+
+// Query publisher queue statistics (high water: most events queued at once).
+// Returns 0 on success.
+int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count, int* out_high_water);
 
-// Query publisher queue statistics. Returns 0 on success.
-int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count);
+// Per-topic statistics
+int demo_publisher_topic_count(void);
+int demo_publisher_get_topic_stats(int slot, DemoPublisherTopicStats* out);
 
 #ifdef __cplusplus
 }
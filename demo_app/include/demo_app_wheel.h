@@ -0,0 +1,82 @@
+#ifndef DEMO_APP_WHEEL_H
+#define DEMO_APP_WHEEL_H
+
+/*
+ * demo_app_wheel.h - Hierarchical timer wheel
+ *
+ * Timers are kept in DEMO_WHEEL_LEVELS levels of DEMO_WHEEL_SLOTS slots;
+ * level L covers delays below SLOTS^(L+1) ticks. A timer sits in the slot
+ * of its expiry at the lowest level that can hold it and cascades down a
+ * level when the wheel reaches its slot. Arming, cancelling and finding the
+ * next expiry are O(1) in the number of timers, so an idle wheel costs
+ * nothing per tick and the owner can sleep until demo_wheel_next().
+ *
+ * Not thread-safe: one task owns the wheel and all of its timers.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEMO_WHEEL_LEVELS     4
+#define DEMO_WHEEL_SLOT_BITS  6
+#define DEMO_WHEEL_SLOTS      (1 << DEMO_WHEEL_SLOT_BITS)
+
+// Longest delay a timer can be armed for (ticks); longer delays are clamped
+#define DEMO_WHEEL_MAX_DELAY  ((1ULL << (DEMO_WHEEL_SLOT_BITS * DEMO_WHEEL_LEVELS)) - 1)
+
+// demo_wheel_next() result when no timer is armed
+#define DEMO_WHEEL_NEVER      UINT64_MAX
+
+typedef struct DemoWheel DemoWheel;
+typedef struct DemoWheelTimer DemoWheelTimer;
+
+// Expiry callback; 'tick' is the tick the timer expired at (may be earlier
+// than the tick passed to demo_wheel_advance). The callback may re-arm or
+// cancel any timer, including this one.
+typedef void (*DemoWheelFn)(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t tick);
+
+struct DemoWheelTimer {
+    DemoWheelTimer* next;
+    DemoWheelTimer* prev;
+    uint64_t expires;            // absolute tick
+    DemoWheelFn fn;
+    void* arg;
+    uint8_t level;
+    uint8_t slot;
+    uint8_t armed;
+};
+
+struct DemoWheel {
+    uint64_t now;                                               // last processed tick
+    uint64_t occupied[DEMO_WHEEL_LEVELS];                       // non-empty slots
+    DemoWheelTimer* slots[DEMO_WHEEL_LEVELS][DEMO_WHEEL_SLOTS];
+};
+
+// Reset the wheel to tick 'now' (timers armed before are forgotten)
+void demo_wheel_init(DemoWheel* wheel, uint64_t now);
+
+// Prepare a timer (not armed)
+void demo_wheel_timer_init(DemoWheelTimer* timer, DemoWheelFn fn, void* arg);
+
+// (Re)arm a timer to expire at an absolute tick; a tick not after the
+// wheel's current tick expires on the next tick
+void demo_wheel_arm(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t expires);
+
+// Disarm a timer (no-op if not armed)
+void demo_wheel_cancel(DemoWheel* wheel, DemoWheelTimer* timer);
+
+// Earliest tick at which demo_wheel_advance has work to do (an expiry or a
+// cascade), or DEMO_WHEEL_NEVER
+uint64_t demo_wheel_next(const DemoWheel* wheel);
+
+// Process all ticks up to and including 'now', running expired timers
+void demo_wheel_advance(DemoWheel* wheel, uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEMO_APP_WHEEL_H */
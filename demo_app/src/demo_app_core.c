@@ -5,6 +5,7 @@
 #include "../include/demo_app.h"
 #include "../include/demo_app_enums.h"
 #include "../include/demo_app_log.h"
+#include "../include/demo_app_publisher.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -111,10 +112,8 @@ void demo_app_context_init(DemoAppContext* ctx) {
     ctx->speed_rx_prev = 0;
     ctx->runbit_rx_prev = 0;
 
-    /* Publish period defaults */
-    ctx->signal_period_ms = 5;    // 200Hz
-    ctx->cbit_period_ms = 1000;   // 1Hz
-    ctx->pbit_period_ms = 0;      // 0 => only at start (no periodic PBIT)
+    /* Publish topics with default periods (signal 200Hz, cbit 1Hz, pbit off) */
+    demo_timer_register_default_topics(ctx);
     
     LOG_INFO("[Core] Context initialized with default values\n");
 }
@@ -129,48 +128,25 @@ void enter_state(DemoAppContext* ctx, DemoState new_state) {
     
     LOG_INFO("[Core] State transition: %s -> %s\n",
            demo_state_name(old_state), demo_state_name(new_state));
+
+    // Timer jobs are armed per state
+    demo_timer_kick();
 }
 
 /* ========================================================================
  * Callbacks
  * ======================================================================== */
 
-static void on_hello(LEGACY_HANDLE h, LegacyRequestId req_id,
-                     const LegacySimpleResult* res,
-                     const LegacyHelloInfo* info, void* user) {
-    DemoAppContext* ctx = (DemoAppContext*)user;
-    LOG_INFO("[Core] Hello response: ok=%d, proto=%d\n",
-           res->ok, info ? info->proto : -1);
-    
-    if (res->ok) {
-        ctx->agent_connected = true;
-        LOG_INFO("[Core] Agent connection established (Async Callback)\n");
-    }
-}
-
-static void on_entity_created(LEGACY_HANDLE h, LegacyRequestId req_id,
-                              const LegacySimpleResult* res, void* user) {
-    const char* entity_name = (const char*)user;
-    if (res->ok) {
-        LOG_INFO("[Core] Entity created: %s\n", 
-               entity_name ? entity_name : "Unknown");
+/* Log the outcome of a blocking (_sync) entity request */
+static void log_entity_result(const char* entity_name, LegacyStatus status,
+                              const LegacySyncResult* res) {
+    if (status == LEGACY_OK) {
+        LOG_INFO("[Core] Entity created: %s\n", entity_name);
+    } else if (status == LEGACY_ERR_PROTO) {
+        LOG_ERROR("[Core] Failed to create %s: %s\n", entity_name,
+               res->msg[0] ? res->msg : "Unknown error");
     } else {
-        LOG_ERROR("[Core] Failed to create %s: %s\n",
-               entity_name ? entity_name : "Unknown",
-               res->msg ? res->msg : "Unknown error");
-    }
-}
-
-static void on_entity_cleared(LEGACY_HANDLE h, LegacyRequestId req_id,
-                              const LegacySimpleResult* res, void* user) {
-    (void)h;
-    (void)req_id;
-    (void)user;
-    if (res->ok) {
-        LOG_INFO("[Core] DDS entities cleared\n");
-    } else {
-        LOG_INFO("[Core] WARNING: Failed to clear entities: %s\n",
-               res->msg ? res->msg : "Unknown error");
+        LOG_ERROR("[Core] Failed to create %s (status=%d)\n", entity_name, (int)status);
     }
 }
 
@@ -184,42 +160,35 @@ static int create_dds_entities(DemoAppContext* ctx) {
     LOG_INFO("[Core] Creating DDS entities...\n");
     
     LegacyStatus status;
+    LegacySyncResult res;
     
+    // Each call returns once the agent replied, so no fixed delay is needed
+    // before the writers/readers that depend on these entities.
+
     // 1. Create Participant
     LegacyParticipantConfig pcfg = { ctx->domain_id, "NstelQosLib::Participant_UDPv4_Only" };
-    status = legacy_agent_create_participant(ctx->agent, &pcfg, 2000,
-                                            on_entity_created, (void*)"Participant");
+    status = legacy_agent_create_participant_sync(ctx->agent, &pcfg, 2000, &res);
+    log_entity_result("Participant", status, &res);
     if (status != LEGACY_OK) {
-        LOG_ERROR("[Core] Failed to create participant\n");
         return -1;
     }
     
     // 2. Create Publisher
     LegacyPublisherConfig pubcfg = { ctx->domain_id, "pub1", "NstelQosLib::PubSub_Base" };
-    status = legacy_agent_create_publisher(ctx->agent, &pubcfg, 2000,
-                                          on_entity_created, (void*)"Publisher");
+    status = legacy_agent_create_publisher_sync(ctx->agent, &pubcfg, 2000, &res);
+    log_entity_result("Publisher", status, &res);
     if (status != LEGACY_OK) {
-        LOG_ERROR("[Core] Failed to create publisher\n");
         return -1;
     }
     
     // 3. Create Subscriber
     LegacySubscriberConfig subcfg = { ctx->domain_id, "sub1", "NstelQosLib::PubSub_Base" };
-    status = legacy_agent_create_subscriber(ctx->agent, &subcfg, 2000,
-                                           on_entity_created, (void*)"Subscriber");
+    status = legacy_agent_create_subscriber_sync(ctx->agent, &subcfg, 2000, &res);
+    log_entity_result("Subscriber", status, &res);
     if (status != LEGACY_OK) {
-        LOG_ERROR("[Core] Failed to create subscriber\n");
         return -1;
     }
     
-    // Give time for entities to be created
-    // TODO: Better synchronization mechanism
-    #ifdef _VXWORKS_
-    taskDelay(sysClkRateGet() / 2);  // 500ms
-    #else
-    // Linux: sleep not available in this context
-    #endif
-    
     LOG_INFO("[Core] DDS entities created successfully\n");
     return 0;
 }
@@ -252,6 +221,10 @@ int demo_app_start(DemoAppContext* ctx, const char* agent_ip, uint16_t agent_por
     }
     
     LOG_INFO("Starting demo application...\n");
+    const char* misplaced = demo_enum_check();
+    if (misplaced) {
+        LOG_ERROR("[Core] Enum table key byte wrong for %s (lookups fall back to the scan)\n", misplaced);
+    }
     LOG_INFO("Agent: %s:%d\n", agent_ip, agent_port);
     
     // Transition: Idle -> Init
@@ -266,7 +239,11 @@ int demo_app_start(DemoAppContext* ctx, const char* agent_ip, uint16_t agent_por
         100,      // send_task_priority
         64*1024,  // send_task_stack
         on_legacy_log, // log_cb
-        NULL      // log_user
+        NULL,     // log_user
+        1,        // dispatch_workers: 200Hz handlers off the receive task
+        0,        // dispatch_queue_depth (default)
+        110,      // dispatch_task_priority
+        32*1024   // dispatch_task_stack
     };
     
     LegacyStatus status = legacy_agent_init(&cfg, &ctx->agent);
@@ -279,47 +256,29 @@ int demo_app_start(DemoAppContext* ctx, const char* agent_ip, uint16_t agent_por
     LOG_INFO("LegacyLib initialized\n");
     
     ctx->agent_connected = false;
-    status = legacy_agent_hello(ctx->agent, 2000, on_hello, ctx);
+    LegacySyncResult res;
+    int proto = -1;
+    status = legacy_agent_hello_sync(ctx->agent, 2000, &res, &proto);
+    LOG_INFO("[Core] Hello response: status=%d, proto=%d\n", (int)status, proto);
     if (status != LEGACY_OK) {
-        LOG_ERROR("Failed to send hello\n");
-        legacy_agent_close(ctx->agent);
-        ctx->agent = NULL;
-        enter_state(ctx, DEMO_STATE_IDLE);
-        return -1;
-    }
-    
-    // Wait for hello response (max 2 seconds)
-    int wait_count = 0;
-    while (!ctx->agent_connected && wait_count < 20) {
-        #ifdef _VXWORKS_
-        taskDelay(sysClkRateGet() / 10);  // 100ms
-        #else
-        // Sleep(100);
-        #endif
-        wait_count++;
-    }
-
-    if (!ctx->agent_connected) {
-        LOG_ERROR("Timeout waiting for Agent connection\n");
+        LOG_ERROR("No valid hello reply from Agent\n");
         legacy_agent_close(ctx->agent);
         ctx->agent = NULL;
         enter_state(ctx, DEMO_STATE_IDLE);
         return -1;
     }
+    ctx->agent_connected = true;
     
     // Clear existing DDS entities (clean slate)
     LOG_INFO("Clearing existing DDS entities...\n");
-    status = legacy_agent_clear_dds_entities(ctx->agent, 2000,
-                                             on_entity_cleared, (void*)"ClearEntities");
-    if (status != LEGACY_OK) {
-        LOG_INFO("WARNING: Failed to clear DDS entities\n");
+    status = legacy_agent_clear_dds_entities_sync(ctx->agent, 2000, &res);
+    if (status == LEGACY_OK) {
+        LOG_INFO("[Core] DDS entities cleared\n");
+    } else {
+        LOG_INFO("WARNING: Failed to clear DDS entities: %s\n",
+               res.msg[0] ? res.msg : "no reply");
     }
     
-    // Wait for clear response
-    #ifdef _VXWORKS_
-    taskDelay(sysClkRateGet() / 2);  // 500ms
-    #endif
-    
     LOG_INFO("Agent connection established\n");
     LOG_INFO("Ready to create DDS entities\n");
     LOG_INFO("Use 'demoAppCreateEntities()' to proceed\n");
@@ -419,6 +378,48 @@ int demo_app_start_scenario(DemoAppContext* ctx) {
  * Publish period control API
  * ======================================================================== */
 
+static DemoPublishTopic* find_publish_topic(DemoAppContext* ctx, const char* name) {
+    for (uint32_t i = 0; i < ctx->publish_topic_count; ++i) {
+        if (strcmp(ctx->publish_topics[i].name, name) == 0) return &ctx->publish_topics[i];
+    }
+    return NULL;
+}
+
+// Add a periodic topic with its publisher slot (plain or sampled)
+static int add_publish_topic(DemoAppContext* ctx, const char* name, uint32_t period_ms,
+                             DemoPublishFn publish, DemoSampleCaptureFn capture,
+                             DemoSamplePublishFn publish_sample, size_t sample_size) {
+    // The timer task walks the table unlocked: only register while it is stopped
+    if (demo_timer_is_running()) return -1;
+    if (find_publish_topic(ctx, name) || ctx->publish_topic_count >= DEMO_MAX_PUBLISH_TOPICS) return -1;
+
+    // Periodic samples: a slow agent gets the latest value, not a backlog
+    int slot = capture ? demo_publisher_register_sampled(name, capture, publish_sample, sample_size, 1)
+                       : demo_publisher_register(name, publish, 1);
+    if (slot < 0) return -1;
+
+    DemoPublishTopic* t = &ctx->publish_topics[ctx->publish_topic_count];
+    memset(t, 0, sizeof(*t));
+    t->name = name;
+    t->pub_slot = slot;
+    t->period_ms = period_ms;
+    t->default_period_ms = period_ms;
+    ctx->publish_topic_count++;
+    return (int)(ctx->publish_topic_count - 1);
+}
+
+int demo_app_register_publish_topic(DemoAppContext* ctx, const char* name, uint32_t period_ms, DemoPublishFn publish) {
+    if (!ctx || !name || !publish) return -1;
+    return add_publish_topic(ctx, name, period_ms, publish, NULL, NULL, 0);
+}
+
+int demo_app_register_sampled_topic(DemoAppContext* ctx, const char* name, uint32_t period_ms,
+                                    DemoSampleCaptureFn capture, DemoSamplePublishFn publish,
+                                    size_t sample_size) {
+    if (!ctx || !name || !capture || !publish) return -1;
+    return add_publish_topic(ctx, name, period_ms, NULL, capture, publish, sample_size);
+}
+
 int demo_app_set_publish_hz(DemoAppContext* ctx, const char* topic, uint32_t hz) {
     if (!ctx || !topic) return -1;
 
@@ -431,27 +432,20 @@ int demo_app_set_publish_hz(DemoAppContext* ctx, const char* topic, uint32_t hz)
         if (period_ms == 0) period_ms = 1; // at least 1ms
     }
 
-    if (strcmp(topic, "signal") == 0) {
-        ctx->signal_period_ms = period_ms;
-        return 0;
-    }
-    if (strcmp(topic, "cbit") == 0) {
-        ctx->cbit_period_ms = period_ms;
-        return 0;
-    }
-    if (strcmp(topic, "pbit") == 0) {
-        ctx->pbit_period_ms = period_ms;
-        return 0;
-    }
+    DemoPublishTopic* t = find_publish_topic(ctx, topic);
+    if (!t) return -1;
 
-    return -1;
+    t->period_ms = period_ms;
+    demo_timer_kick();
+    return 0;
 }
 
 void demo_app_reset_publish_periods(DemoAppContext* ctx) {
     if (!ctx) return;
-    ctx->signal_period_ms = 5;
-    ctx->cbit_period_ms = 1000;
-    ctx->pbit_period_ms = 0;
+    for (uint32_t i = 0; i < ctx->publish_topic_count; ++i) {
+        ctx->publish_topics[i].period_ms = ctx->publish_topics[i].default_period_ms;
+    }
+    demo_timer_kick();
 }
 
 void demo_app_stop(DemoAppContext* ctx) {
@@ -483,11 +477,8 @@ int demo_app_reset(DemoAppContext* ctx) {
     // Clear DDS entities and close agent
     if (ctx->agent) {
         LOG_INFO("Clearing DDS entities...\n");
-        legacy_agent_clear_dds_entities(ctx->agent, 2000,
-                                        on_entity_created, (void*)"ClearEntities");
-        #ifdef _VXWORKS_
-        taskDelay(sysClkRateGet() / 2);  // 500ms
-        #endif
+        // Blocks until the agent confirmed (or 2 s passed), then closes
+        legacy_agent_clear_dds_entities_sync(ctx->agent, 2000, NULL);
         legacy_agent_close(ctx->agent);
         ctx->agent = NULL;
     }
@@ -538,8 +529,8 @@ int demo_app_trigger_ibit(DemoAppContext* ctx, uint32_t reference_num, int type)
     ctx->bit_state.ibit_reference_num = reference_num;
     ctx->bit_state.ibit_type = (T_BITType)type;
     
-    // Get current tick count as timestamp (milliseconds)
-    ctx->bit_state.ibit_start_time = ctx->tick_count;
+    // Start time on the timer clock (ms); tick_count may lag until the timer task wakes
+    ctx->bit_state.ibit_start_time = demo_timer_now_ms();
     
     enter_state(ctx, DEMO_STATE_IBIT_RUNNING);
     
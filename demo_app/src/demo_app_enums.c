@@ -7,82 +7,265 @@
 
 /* ========================================================================
  * Enum Parsing Functions (JSON String -> Enum Value)
+ *
+ * The schema enumerator names are matched exactly through a perfect hash:
+ * the slot is (one distinguishing byte + 2 * length) & 7. Every name of a
+ * table is <prefix><token>, and the key byte is a fixed offset into the
+ * token (the first byte that differs), so its position is derived from the
+ * prefix. Slots are placed at compile time from the name and its key byte;
+ * demo_enum_check() verifies at start-up that each key byte matches its name,
+ * and a hit is confirmed with memcmp. Anything else (legacy spellings,
+ * partial names) falls back to the token scan the parsers always did, so
+ * results do not change. The _n variant takes a span that need not be
+ * NUL-terminated.
  * ======================================================================== */
 
-T_BITType parse_bit_type(const char* str) {
-    if (!str) return L_BITType_C_BIT;
-    
-    if (strstr(str, "P_BIT")) return L_BITType_P_BIT;
-    if (strstr(str, "I_BIT")) return L_BITType_I_BIT;
-    if (strstr(str, "C_BIT")) return L_BITType_C_BIT;
-    
+typedef struct {
+    const char* name;
+    size_t      len;
+    int         value;
+} DemoEnumSlot;
+
+typedef struct {
+    const DemoEnumSlot* slots;
+    size_t              key_pos;
+} DemoEnumTable;
+
+#define DEMO_ENUM_SLOTS 8
+#define DEMO_ENUM_HASH(key, len) \
+    ((((unsigned)(unsigned char)(key)) + 2u * (unsigned)(len)) & (DEMO_ENUM_SLOTS - 1))
+/* Position of the key byte: 'offset' bytes into the token after 'prefix' */
+#define DEMO_ENUM_KEY_POS(prefix, offset) (sizeof(prefix) - 1 + (offset))
+/* 'key' is token[offset] of the table (checked by demo_enum_check()) */
+#define DEMO_ENUM_NAME(prefix, token, key, val) \
+    [DEMO_ENUM_HASH(key, sizeof(prefix token) - 1)] = { prefix token, sizeof(prefix token) - 1, (int)(val) }
+
+static int demo_enum_lookup(const DemoEnumTable* t, const char* s, size_t len, int* out) {
+    const DemoEnumSlot* e;
+    if (len <= t->key_pos) return 0;
+    e = &t->slots[DEMO_ENUM_HASH(s[t->key_pos], len)];
+    if (e->len != len || memcmp(e->name, s, len) != 0) return 0;
+    *out = e->value;
+    return 1;
+}
+
+/* strstr() over a span */
+static int span_has(const char* s, size_t len, const char* token) {
+    size_t n = strlen(token);
+    size_t i;
+    if (n > len) return 0;
+    for (i = 0; i + n <= len; ++i) {
+        if (s[i] == token[0] && memcmp(s + i, token, n) == 0) return 1;
+    }
+    return 0;
+}
+
+#define BIT_TYPE_PREFIX "L_BITType_"
+static const DemoEnumSlot kBITTypeSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(BIT_TYPE_PREFIX, "C_BIT", 'C', L_BITType_C_BIT),
+    DEMO_ENUM_NAME(BIT_TYPE_PREFIX, "P_BIT", 'P', L_BITType_P_BIT),
+    DEMO_ENUM_NAME(BIT_TYPE_PREFIX, "I_BIT", 'I', L_BITType_I_BIT),
+};
+static const DemoEnumTable kBITTypeNames = { kBITTypeSlots, DEMO_ENUM_KEY_POS(BIT_TYPE_PREFIX, 0) };
+
+T_BITType parse_bit_type_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_BITType_C_BIT;
+    if (demo_enum_lookup(&kBITTypeNames, s, len, &v)) return (T_BITType)v;
+
+    if (span_has(s, len, "P_BIT")) return L_BITType_P_BIT;
+    if (span_has(s, len, "I_BIT")) return L_BITType_I_BIT;
+    if (span_has(s, len, "C_BIT")) return L_BITType_C_BIT;
+
     return L_BITType_C_BIT;  // default
 }
 
-T_OperationModeType parse_operation_mode(const char* str) {
-    if (!str) return L_OperationModeType_NORMAL;
-    
-    if (strstr(str, "EMERGENCY")) return L_OperationModeType_EMERGENCY;
-    if (strstr(str, "MANUAL")) return L_OperationModeType_MANUAL;
-    if (strstr(str, "NORMAL")) return L_OperationModeType_NORMAL;
-    
+#define OPERATION_MODE_PREFIX "L_OperationModeType_"
+static const DemoEnumSlot kOperationModeSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(OPERATION_MODE_PREFIX, "NORMAL", 'N', L_OperationModeType_NORMAL),
+    DEMO_ENUM_NAME(OPERATION_MODE_PREFIX, "EMERGENCY", 'E', L_OperationModeType_EMERGENCY),
+    DEMO_ENUM_NAME(OPERATION_MODE_PREFIX, "MANUAL", 'M', L_OperationModeType_MANUAL),
+};
+static const DemoEnumTable kOperationModeNames = { kOperationModeSlots, DEMO_ENUM_KEY_POS(OPERATION_MODE_PREFIX, 0) };
+
+static T_OperationModeType parse_operation_mode_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_OperationModeType_NORMAL;
+    if (demo_enum_lookup(&kOperationModeNames, s, len, &v)) return (T_OperationModeType)v;
+
+    if (span_has(s, len, "EMERGENCY")) return L_OperationModeType_EMERGENCY;
+    if (span_has(s, len, "MANUAL")) return L_OperationModeType_MANUAL;
+    if (span_has(s, len, "NORMAL")) return L_OperationModeType_NORMAL;
+
     return L_OperationModeType_NORMAL;
 }
 
-T_OnOffType parse_onoff_type(const char* str) {
-    if (!str) return L_OnOffType_OFF;
-    
-    if (strstr(str, "ON")) return L_OnOffType_ON;
-    if (strstr(str, "OFF")) return L_OnOffType_OFF;
-    
+/* Schema type: T_PalmModeType (ON/OFF differ in length only) */
+#define ONOFF_PREFIX "L_PalmModeType_"
+static const DemoEnumSlot kOnOffSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(ONOFF_PREFIX, "ON", 'O', L_OnOffType_ON),
+    DEMO_ENUM_NAME(ONOFF_PREFIX, "OFF", 'O', L_OnOffType_OFF),
+};
+static const DemoEnumTable kOnOffNames = { kOnOffSlots, DEMO_ENUM_KEY_POS(ONOFF_PREFIX, 0) };
+
+static T_OnOffType parse_onoff_type_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_OnOffType_OFF;
+    if (demo_enum_lookup(&kOnOffNames, s, len, &v)) return (T_OnOffType)v;
+
+    if (span_has(s, len, "ON")) return L_OnOffType_ON;
+    if (span_has(s, len, "OFF")) return L_OnOffType_OFF;
+
     return L_OnOffType_OFF;
 }
 
-T_TargetAllotType parse_target_allot(const char* str) {
-    if (!str) return L_TargetAllotType_ALLOT;
-    
-    if (strstr(str, "ALLOT")) return L_TargetAllotType_ALLOT;
-    if (strstr(str, "ETC")) return L_TargetAllotType_ETC;
-    
+/* Schema type: T_TargetFixType (FIXED has no token below: default ALLOT) */
+#define TARGET_ALLOT_PREFIX "L_TargetFixType_"
+static const DemoEnumSlot kTargetAllotSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(TARGET_ALLOT_PREFIX, "FIXED", 'F', L_TargetAllotType_ALLOT),
+    DEMO_ENUM_NAME(TARGET_ALLOT_PREFIX, "ETC", 'E', L_TargetAllotType_ETC),
+};
+static const DemoEnumTable kTargetAllotNames = { kTargetAllotSlots, DEMO_ENUM_KEY_POS(TARGET_ALLOT_PREFIX, 0) };
+
+static T_TargetAllotType parse_target_allot_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_TargetAllotType_ALLOT;
+    if (demo_enum_lookup(&kTargetAllotNames, s, len, &v)) return (T_TargetAllotType)v;
+
+    if (span_has(s, len, "ALLOT")) return L_TargetAllotType_ALLOT;
+    if (span_has(s, len, "ETC")) return L_TargetAllotType_ETC;
+
     return L_TargetAllotType_ALLOT;
 }
 
-T_ArmPositionLockType parse_arm_position_lock(const char* str) {
-    if (!str) return L_ArmPositionLockType_RELEASE;
-    
-    if (strstr(str, "LOCK")) return L_ArmPositionLockType_LOCK;
-    if (strstr(str, "RELEASE")) return L_ArmPositionLockType_RELEASE;
-    
+/* Schema type: T_ArmPositionType (DRIVING has no token below: default RELEASE) */
+#define ARM_POSITION_PREFIX "L_ArmPositionType_"
+static const DemoEnumSlot kArmPositionLockSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(ARM_POSITION_PREFIX, "RELEASE", 'R', L_ArmPositionLockType_RELEASE),
+    DEMO_ENUM_NAME(ARM_POSITION_PREFIX, "DRIVING", 'D', L_ArmPositionLockType_RELEASE),
+};
+static const DemoEnumTable kArmPositionLockNames = { kArmPositionLockSlots, DEMO_ENUM_KEY_POS(ARM_POSITION_PREFIX, 0) };
+
+static T_ArmPositionLockType parse_arm_position_lock_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_ArmPositionLockType_RELEASE;
+    if (demo_enum_lookup(&kArmPositionLockNames, s, len, &v)) return (T_ArmPositionLockType)v;
+
+    if (span_has(s, len, "LOCK")) return L_ArmPositionLockType_LOCK;
+    if (span_has(s, len, "RELEASE")) return L_ArmPositionLockType_RELEASE;
+
     return L_ArmPositionLockType_RELEASE;
 }
 
-T_MainCannonReturnType parse_main_cannon_return(const char* str) {
-    if (!str) return L_MainCannonReturnType_RELEASE;
-    
-    if (strstr(str, "COMMAND")) return L_MainCannonReturnType_COMMAND;
-    if (strstr(str, "RELEASE")) return L_MainCannonReturnType_RELEASE;
-    
+/* Schema type: T_CannonRestoreType (key byte: third of the token) */
+#define CANNON_RESTORE_PREFIX "L_CannonRestoreType_"
+static const DemoEnumSlot kMainCannonReturnSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(CANNON_RESTORE_PREFIX, "RELEASE", 'L', L_MainCannonReturnType_RELEASE),
+    DEMO_ENUM_NAME(CANNON_RESTORE_PREFIX, "RESTORE", 'S', L_MainCannonReturnType_RELEASE),
+};
+static const DemoEnumTable kMainCannonReturnNames = { kMainCannonReturnSlots, DEMO_ENUM_KEY_POS(CANNON_RESTORE_PREFIX, 2) };
+
+static T_MainCannonReturnType parse_main_cannon_return_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_MainCannonReturnType_RELEASE;
+    if (demo_enum_lookup(&kMainCannonReturnNames, s, len, &v)) return (T_MainCannonReturnType)v;
+
+    if (span_has(s, len, "COMMAND")) return L_MainCannonReturnType_COMMAND;
+    if (span_has(s, len, "RELEASE")) return L_MainCannonReturnType_RELEASE;
+
     return L_MainCannonReturnType_RELEASE;
 }
 
-T_MainCannonFixType parse_main_cannon_fix(const char* str) {
-    if (!str) return L_MainCannonFixType_RELEASE;
-    
-    if (strstr(str, "COMMAND")) return L_MainCannonFixType_COMMAND;
-    if (strstr(str, "RELEASE")) return L_MainCannonFixType_RELEASE;
-    
+/* Schema type: T_CannonFixType */
+#define CANNON_FIX_PREFIX "L_CannonFixType_"
+static const DemoEnumSlot kMainCannonFixSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(CANNON_FIX_PREFIX, "RELEASE", 'R', L_MainCannonFixType_RELEASE),
+    DEMO_ENUM_NAME(CANNON_FIX_PREFIX, "FIX", 'F', L_MainCannonFixType_RELEASE),
+};
+static const DemoEnumTable kMainCannonFixNames = { kMainCannonFixSlots, DEMO_ENUM_KEY_POS(CANNON_FIX_PREFIX, 0) };
+
+static T_MainCannonFixType parse_main_cannon_fix_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_MainCannonFixType_RELEASE;
+    if (demo_enum_lookup(&kMainCannonFixNames, s, len, &v)) return (T_MainCannonFixType)v;
+
+    if (span_has(s, len, "COMMAND")) return L_MainCannonFixType_COMMAND;
+    if (span_has(s, len, "RELEASE")) return L_MainCannonFixType_RELEASE;
+
     return L_MainCannonFixType_RELEASE;
 }
 
-T_EquipOpenLockType parse_equip_open_lock(const char* str) {
-    if (!str) return L_EquipOpenLockType_LOCK;
-    
-    if (strstr(str, "OPEN")) return L_EquipOpenLockType_OPEN;
-    if (strstr(str, "LOCK")) return L_EquipOpenLockType_LOCK;
-    
+/* Schema type: T_EquipOpenStatusType (CLOSE has no token below: default LOCK) */
+#define EQUIP_OPEN_PREFIX "L_EquipOpenStatusType_"
+static const DemoEnumSlot kEquipOpenLockSlots[DEMO_ENUM_SLOTS] = {
+    DEMO_ENUM_NAME(EQUIP_OPEN_PREFIX, "CLOSE", 'C', L_EquipOpenLockType_LOCK),
+    DEMO_ENUM_NAME(EQUIP_OPEN_PREFIX, "OPEN", 'O', L_EquipOpenLockType_OPEN),
+};
+static const DemoEnumTable kEquipOpenLockNames = { kEquipOpenLockSlots, DEMO_ENUM_KEY_POS(EQUIP_OPEN_PREFIX, 0) };
+
+static T_EquipOpenLockType parse_equip_open_lock_n(const char* s, size_t len) {
+    int v;
+    if (!s) return L_EquipOpenLockType_LOCK;
+    if (demo_enum_lookup(&kEquipOpenLockNames, s, len, &v)) return (T_EquipOpenLockType)v;
+
+    if (span_has(s, len, "OPEN")) return L_EquipOpenLockType_OPEN;
+    if (span_has(s, len, "LOCK")) return L_EquipOpenLockType_LOCK;
+
     return L_EquipOpenLockType_LOCK;
 }
 
+const char* demo_enum_check(void) {
+    static const DemoEnumTable* const tables[] = {
+        &kBITTypeNames, &kOperationModeNames, &kOnOffNames, &kTargetAllotNames,
+        &kArmPositionLockNames, &kMainCannonReturnNames, &kMainCannonFixNames, &kEquipOpenLockNames
+    };
+    size_t t, i;
+    for (t = 0; t < sizeof(tables) / sizeof(tables[0]); ++t) {
+        for (i = 0; i < DEMO_ENUM_SLOTS; ++i) {
+            const DemoEnumSlot* e = &tables[t]->slots[i];
+            if (!e->name) continue;
+            // A wrong key byte files the name where its lookup never lands
+            if (e->len <= tables[t]->key_pos ||
+                DEMO_ENUM_HASH(e->name[tables[t]->key_pos], e->len) != i) {
+                return e->name;
+            }
+        }
+    }
+    return NULL;
+}
+
+T_BITType parse_bit_type(const char* str) {
+    return parse_bit_type_n(str, str ? strlen(str) : 0);
+}
+
+T_OperationModeType parse_operation_mode(const char* str) {
+    return parse_operation_mode_n(str, str ? strlen(str) : 0);
+}
+
+T_OnOffType parse_onoff_type(const char* str) {
+    return parse_onoff_type_n(str, str ? strlen(str) : 0);
+}
+
+T_TargetAllotType parse_target_allot(const char* str) {
+    return parse_target_allot_n(str, str ? strlen(str) : 0);
+}
+
+T_ArmPositionLockType parse_arm_position_lock(const char* str) {
+    return parse_arm_position_lock_n(str, str ? strlen(str) : 0);
+}
+
+T_MainCannonReturnType parse_main_cannon_return(const char* str) {
+    return parse_main_cannon_return_n(str, str ? strlen(str) : 0);
+}
+
+T_MainCannonFixType parse_main_cannon_fix(const char* str) {
+    return parse_main_cannon_fix_n(str, str ? strlen(str) : 0);
+}
+
+T_EquipOpenLockType parse_equip_open_lock(const char* str) {
+    return parse_equip_open_lock_n(str, str ? strlen(str) : 0);
+}
+
 /* ========================================================================
  * Enum Formatting Functions (Enum Value -> JSON String)
  * ======================================================================== */
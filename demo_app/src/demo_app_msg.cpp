@@ -6,7 +6,9 @@
 #include "../include/demo_app.h"
 #include "../include/demo_app_log.h"
 #include "../include/msg_fields.h"
+#include "legacy_reflect.hpp"
 #include <cstdio>
+#include <cstddef>
 #include <cstring>
 #include <cmath>
 #include <string>
@@ -15,125 +17,230 @@
 
 using json = nlohmann::json;
 
-extern "C" {
-
 /* ========================================================================
- * Callbacks
+ * Struct reflection (typed receive: CBOR -> struct; write_struct: struct ->
+ * CBOR; no JSON text either way). Member names are the wire keys.
  * ======================================================================== */
 
-static void on_writer_created(LEGACY_HANDLE h, LegacyRequestId req_id,
-                              const LegacySimpleResult* res, void* user) {
-    const char* topic = (const char*)user;
-    if (res->ok) {
-        LOG_INFO("Writer created: %s\n", topic);
-    } else {
-        LOG_INFO("ERROR: Failed to create writer for %s: %s\n",
-               topic, res->msg ? res->msg : "Unknown");
-    }
-}
+LEGACY_REFLECT_STRUCT_BEGIN(T_IdentifierType)
+    LEGACY_REFLECT_FIELD(A_resourceId)
+    LEGACY_REFLECT_FIELD(A_instanceId)
+LEGACY_REFLECT_STRUCT_END(T_IdentifierType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(T_DateTimeType)
+    LEGACY_REFLECT_FIELD(A_second)
+    LEGACY_REFLECT_FIELD(A_nanoseconds)
+LEGACY_REFLECT_STRUCT_END(T_DateTimeType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_OperationModeType)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_NORMAL", L_OperationModeType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_EMERGENCY", L_OperationModeType_EMERGENCY)
+    LEGACY_REFLECT_ENUMERATOR("L_OperationModeType_MANUAL", L_OperationModeType_MANUAL)
+LEGACY_REFLECT_ENUM_END(T_OperationModeType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_PalmModeType)
+    LEGACY_REFLECT_ENUMERATOR("L_PalmModeType_ON", L_PalmModeType_ON)
+    LEGACY_REFLECT_ENUMERATOR("L_PalmModeType_OFF", L_PalmModeType_OFF)
+LEGACY_REFLECT_ENUM_END(T_PalmModeType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_TargetFixType)
+    LEGACY_REFLECT_ENUMERATOR("L_TargetFixType_FIXED", L_TargetFixType_FIXED)
+    LEGACY_REFLECT_ENUMERATOR("L_TargetFixType_ETC", L_TargetFixType_ETC)
+LEGACY_REFLECT_ENUM_END(T_TargetFixType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_ArmPositionType)
+    LEGACY_REFLECT_ENUMERATOR("L_ArmPositionType_RELEASE", L_ArmPositionType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_ArmPositionType_DRIVING", L_ArmPositionType_MANUAL)
+LEGACY_REFLECT_ENUM_END(T_ArmPositionType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_CannonRestoreType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonRestoreType_RELEASE", L_CannonRestoreType_RELEASE)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonRestoreType_RESTORE", L_CannonRestoreType_RESTORE)
+LEGACY_REFLECT_ENUM_END(T_CannonRestoreType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_CannonFixType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixType_RELEASE", L_CannonFixType_RELEASE)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonFixType_FIX", L_CannonFixType_FIX)
+LEGACY_REFLECT_ENUM_END(T_CannonFixType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_EquipOpenStatusType)
+    LEGACY_REFLECT_ENUMERATOR("L_EquipOpenStatusType_CLOSE", L_EquipOpenStatusType_CLOSE)
+    LEGACY_REFLECT_ENUMERATOR("L_EquipOpenStatusType_OPEN", L_EquipOpenStatusType_OPEN)
+LEGACY_REFLECT_ENUM_END(T_EquipOpenStatusType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(C_CannonDrivingDevice_commandDriving)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_recipientID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_referenceNum)
+    LEGACY_REFLECT_FIELD(A_roundPosition)
+    LEGACY_REFLECT_FIELD(A_upDownPosition)
+    LEGACY_REFLECT_FIELD(A_roundAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_upDownAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_cannonUpDownAngle)
+    LEGACY_REFLECT_FIELD(A_topRelativeAngle)
+    LEGACY_REFLECT_FIELD(A_operationMode)
+    LEGACY_REFLECT_FIELD(A_parm)
+    LEGACY_REFLECT_FIELD(A_targetFix)
+    LEGACY_REFLECT_FIELD(A_autoArmPosition)
+    LEGACY_REFLECT_FIELD(A_manualArmPosition)
+    LEGACY_REFLECT_FIELD(A_mainCannonRestore)
+    LEGACY_REFLECT_FIELD(A_mainCannonFix)
+    LEGACY_REFLECT_FIELD(A_closureEquipOpenStatus)
+LEGACY_REFLECT_STRUCT_END(C_CannonDrivingDevice_commandDriving)
+
+/* Signal enumerators: schema names, as produced by the format_* helpers */
+LEGACY_REFLECT_ENUM_BEGIN(T_ChangingStatusType)
+    LEGACY_REFLECT_ENUMERATOR("L_EnergyStorageStatusType_NORMAL", L_ChangingStatusType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_EnergyStorageStatusType_DISCHARGE", L_ChangingStatusType_DISCHARGE)
+LEGACY_REFLECT_ENUM_END(T_ChangingStatusType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_DekClearanceType)
+    LEGACY_REFLECT_ENUMERATOR("L_DeckClearanceType_OUT_OF_DECK", L_DekClearanceType_OUTSIDE)
+    LEGACY_REFLECT_ENUMERATOR("L_DeckClearanceType_IN_DECK", L_DekClearanceType_RUNNING)
+LEGACY_REFLECT_ENUM_END(T_DekClearanceType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_CannonDrivingType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonDrivingType_DRIVING", L_CannonDrivingType_DRIVING)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonDrivingType_DONE", L_CannonDrivingType_DONE)
+LEGACY_REFLECT_ENUM_END(T_CannonDrivingType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_CannonLockType)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonLockType_NORMAL", L_CannonLockType_NORMAL)
+    LEGACY_REFLECT_ENUMERATOR("L_CannonLockType_LOCKED", L_CannonLockType_LOCKED)
+LEGACY_REFLECT_ENUM_END(T_CannonLockType)
+
+LEGACY_REFLECT_ENUM_BEGIN(T_CannonDrivingDeviceShutdownType)
+    LEGACY_REFLECT_ENUMERATOR("L_ShutdownType_UNKNOWN", L_CannonDrivingDeviceShutdownType_UNKNOWN)
+    LEGACY_REFLECT_ENUMERATOR("L_ShutdownType_SHUTDOWN", L_CannonDrivingDeviceShutdownType_SHUTDOWN)
+LEGACY_REFLECT_ENUM_END(T_CannonDrivingDeviceShutdownType)
+
+LEGACY_REFLECT_STRUCT_BEGIN(C_CannonDrivingDevice_Signal)
+    LEGACY_REFLECT_FIELD(A_sourceID)
+    LEGACY_REFLECT_FIELD(A_recipientID)
+    LEGACY_REFLECT_FIELD(A_timeOfDataGeneration)
+    LEGACY_REFLECT_FIELD(A_azAngleVelocity)
+    LEGACY_REFLECT_FIELD(A_e1AngleVelocity)
+    LEGACY_REFLECT_FIELD(A_energyStorage)
+    LEGACY_REFLECT_FIELD(A_mainCannonFixStatus)
+    LEGACY_REFLECT_FIELD(A_deckCleance)
+    LEGACY_REFLECT_FIELD(A_autoArmPositionComplement)
+    LEGACY_REFLECT_FIELD(A_manualArmPositionComplement)
+    LEGACY_REFLECT_FIELD(A_mainCannonRestoreComplement)
+    LEGACY_REFLECT_FIELD(A_armSafetyMainCannonLock)
+    LEGACY_REFLECT_FIELD(A_shutdown)
+    LEGACY_REFLECT_FIELD(A_roundGyro)
+    LEGACY_REFLECT_FIELD(A_upDownGyro)
+LEGACY_REFLECT_STRUCT_END(C_CannonDrivingDevice_Signal)
 
-static void on_reader_created(LEGACY_HANDLE h, LegacyRequestId req_id,
-                              const LegacySimpleResult* res, void* user) {
-    const char* topic = (const char*)user;
-    if (res->ok) {
-        LOG_INFO("Reader created: %s\n", topic);
-    } else {
-        LOG_INFO("ERROR: Failed to create reader for %s: %s\n",
-               topic, res->msg ? res->msg : "Unknown");
-    }
-}
+extern "C" {
 
 /* ========================================================================
  * Initialization
  * ======================================================================== */
 
+/* Last commandDriving delivered. The library zero-fills the typed struct, so
+ * each sample is decoded over a copy of this one instead: a field missing
+ * from a sample keeps its previous value, as the JSON handler did with
+ * j.value(key, current). Touched only by the task delivering the topic. */
+static C_CannonDrivingDevice_commandDriving g_last_control;
+static bool (*g_decode_control)(LegacyCborReader* r, void* out);
+
+static bool decode_control_over_last(LegacyCborReader* r, void* out) {
+    memcpy(out, &g_last_control, sizeof(g_last_control));
+    return g_decode_control(r, out);
+}
+
+// Command that maps back to the initial control state (before any sample)
+static void control_seed(const ActuatorControlState* ctrl, C_CannonDrivingDevice_commandDriving* cmd) {
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->A_roundPosition = ctrl->drivingPosition;
+    cmd->A_upDownPosition = ctrl->upDownPosition;
+    cmd->A_roundAngleVelocity = ctrl->roundAngleVelocity;
+    cmd->A_upDownAngleVelocity = ctrl->upDownAngleVelocity;
+    cmd->A_cannonUpDownAngle = ctrl->cannonUpDownAngle;
+    cmd->A_topRelativeAngle = ctrl->topRelativeAngle;
+    cmd->A_operationMode = ctrl->operationMode;
+    cmd->A_parm = (ctrl->parm == L_OnOffType_ON) ? L_PalmModeType_ON : L_PalmModeType_OFF;
+    cmd->A_targetFix = (ctrl->targetDesingation == L_TargetAllotType_ETC) ? L_TargetFixType_ETC : L_TargetFixType_FIXED;
+    cmd->A_closureEquipOpenStatus = (ctrl->closeEquipOpenStatus == L_EquipOpenLockType_OPEN)
+                                        ? L_EquipOpenStatusType_OPEN : L_EquipOpenStatusType_CLOSE;
+    // Arm position, restore and fix map every enumerator to RELEASE
+}
+
 int demo_msg_init(DemoAppContext* ctx) {
     if (!ctx || !ctx->agent) return -1;
     
     LOG_INFO("Initializing message handlers...\n");
     
-    LegacyStatus status;
-    
-    // ===== Create Writers (4 send topics) =====
-    
-    // 1. PBIT Writer (Initial State QoS)
-    LegacyWriterConfig pbit_wcfg = {
-        ctx->domain_id,
-        "pub1",
-        TOPIC_PowerOnBIT,
-        TYPE_PowerOnBIT,
-        "NstelCustomQosLib::InitialStateProfile"
+    // 4 send topics (writers on pub1) and 3 receive topics (readers on sub1),
+    // created with one pipelined request burst instead of 7 round trips
+    const LegacyEntityDesc entities[] = {
+        // PBIT Writer (Initial State QoS)
+        { LEGACY_ENTITY_WRITER, ctx->domain_id, "pub1", TOPIC_PowerOnBIT, TYPE_PowerOnBIT,
+          "NstelCustomQosLib::InitialStateProfile" },
+        // CBIT Writer (Low Frequency Status QoS - 1Hz)
+        { LEGACY_ENTITY_WRITER, ctx->domain_id, "pub1", TOPIC_PBIT, TYPE_PBIT,
+          "NstelCustomQosLib::LowFrequencyStatusProfile" },
+        // ResultBIT Writer (Non-Periodic Event QoS)
+        { LEGACY_ENTITY_WRITER, ctx->domain_id, "pub1", TOPIC_IBIT, TYPE_IBIT,
+          "NstelCustomQosLib::NonPeriodicEventProfile" },
+        // Actuator Signal Writer (High Frequency Periodic QoS - 200Hz)
+        { LEGACY_ENTITY_WRITER, ctx->domain_id, "pub1", TOPIC_Signal, TYPE_Signal,
+          "NstelCustomQosLib::HighFrequencyPeriodicProfile" },
+        // runBIT Reader (Non-Periodic Event QoS)
+        { LEGACY_ENTITY_READER, ctx->domain_id, "sub1", TOPIC_runBIT, TYPE_runBIT,
+          "NstelCustomQosLib::NonPeriodicEventProfile" },
+        // Actuator Control Reader (High Frequency Periodic QoS - 200Hz)
+        { LEGACY_ENTITY_READER, ctx->domain_id, "sub1", TOPIC_commandDriving, TYPE_commandDriving,
+          "NstelCustomQosLib::HighFrequencyPeriodicProfile" },
+        // Vehicle Speed Reader (Low Frequency Vehicle QoS - 1Hz)
+        { LEGACY_ENTITY_READER, ctx->domain_id, "sub1", TOPIC_VehicleSpeed, TYPE_VehicleSpeed,
+          "NstelCustomQosLib::LowFrequencyVehicleProfile" },
     };
-    status = legacy_agent_create_writer(ctx->agent, &pbit_wcfg, 2000,
-                                       on_writer_created, (void*)TOPIC_PowerOnBIT);
-    if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create PBIT writer\n");
-        return -1;
+    const size_t entity_count = sizeof(entities) / sizeof(entities[0]);
+    LegacySyncResult results[sizeof(entities) / sizeof(entities[0])];
+    
+    // Returns once every entity has been answered (or timed out)
+    LegacyStatus status = legacy_agent_create_entities_sync(ctx->agent, entities, entity_count,
+                                                            2000, results);
+    for (size_t i = 0; i < entity_count; i++) {
+        const char* kind = (entities[i].kind == LEGACY_ENTITY_WRITER) ? "Writer" : "Reader";
+        if (results[i].ok) {
+            LOG_INFO("%s created: %s\n", kind, entities[i].topic);
+        } else {
+            LOG_INFO("ERROR: Failed to create %s for %s: %s\n", kind, entities[i].topic,
+                   results[i].msg[0] ? results[i].msg : "Unknown");
+        }
     }
-    
-    // 2. CBIT Writer (Low Frequency Status QoS - 1Hz)
-    LegacyWriterConfig cbit_wcfg = {
-        ctx->domain_id,
-        "pub1",
-        TOPIC_PBIT,
-        TYPE_PBIT,
-        "NstelCustomQosLib::LowFrequencyStatusProfile"
-    };
-    status = legacy_agent_create_writer(ctx->agent, &cbit_wcfg, 2000,
-                                       on_writer_created, (void*)TOPIC_PBIT);
     if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create CBIT writer\n");
+        LOG_INFO("ERROR: Failed to create writers/readers (status=%d)\n", (int)status);
         return -1;
     }
     
-    // 3. ResultBIT Writer (Non-Periodic Event QoS)
-    LegacyWriterConfig rbit_wcfg = {
-        ctx->domain_id,
-        "pub1",
-        TOPIC_IBIT,
-        TYPE_IBIT,
-        "NstelCustomQosLib::NonPeriodicEventProfile"
-    };
-    status = legacy_agent_create_writer(ctx->agent, &rbit_wcfg, 2000,
-                                       on_writer_created, (void*)TOPIC_IBIT);
+    // 200Hz Signal: encoded by the library from the struct, and the constant
+    // request envelope only once
+    status = legacy::reflect::register_type<C_CannonDrivingDevice_Signal>(ctx->agent, TOPIC_Signal, TYPE_Signal);
     if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create ResultBIT writer\n");
+        LOG_INFO("ERROR: Failed to register Actuator Signal adapter (status=%d)\n", (int)status);
         return -1;
     }
-    
-    // 4. Actuator Signal Writer (High Frequency Periodic QoS - 200Hz)
-    LegacyWriterConfig signal_wcfg = {
-        ctx->domain_id,
-        "pub1",
+    LegacyWriteJsonOptions signal_opt = {
         TOPIC_Signal,
         TYPE_Signal,
+        NULL,
+        ctx->domain_id,
+        "pub1",
         "NstelCustomQosLib::HighFrequencyPeriodicProfile"
     };
-    status = legacy_agent_create_writer(ctx->agent, &signal_wcfg, 2000,
-                                       on_writer_created, (void*)TOPIC_Signal);
+    status = legacy_agent_open_writer(ctx->agent, &signal_opt, &ctx->signal_writer);
     if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create Actuator Signal writer\n");
+        LOG_INFO("ERROR: Failed to open Actuator Signal writer (status=%d)\n", (int)status);
         return -1;
     }
     
-    // ===== Create Readers (3 receive topics) =====
+    // ===== Subscribe to the 3 receive topics =====
     
-    // 1. runBIT Reader (Non-Periodic Event QoS)
-    LegacyReaderConfig runbit_rcfg = {
-        ctx->domain_id,
-        "sub1",
-        TOPIC_runBIT,
-        TYPE_runBIT,
-        "NstelCustomQosLib::NonPeriodicEventProfile"
-    };
-    status = legacy_agent_create_reader(ctx->agent, &runbit_rcfg, 2000,
-                                       on_reader_created, (void*)TOPIC_runBIT);
-    if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create runBIT reader\n");
-        return -1;
-    }
-    
-    // Subscribe to runBIT events
     status = legacy_agent_subscribe_event(ctx->agent, TOPIC_runBIT, TYPE_runBIT,
                                          demo_msg_on_runbit, ctx);
     if (status != LEGACY_OK) {
@@ -141,46 +248,24 @@ int demo_msg_init(DemoAppContext* ctx) {
         return -1;
     }
     
-    // 2. Actuator Control Reader (High Frequency Periodic QoS - 200Hz)
-    LegacyReaderConfig control_rcfg = {
-        ctx->domain_id,
-        "sub1",
-        TOPIC_commandDriving,
-        TYPE_commandDriving,
-        "NstelCustomQosLib::HighFrequencyPeriodicProfile"
-    };
-    status = legacy_agent_create_reader(ctx->agent, &control_rcfg, 2000,
-                                       on_reader_created, (void*)TOPIC_commandDriving);
-    if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create Actuator Control reader\n");
-        return -1;
+    // 200Hz control topic: decoded by the library straight into the struct,
+    // over the last received command (see decode_control_over_last)
+    LegacyTypeAdapter control_adapter =
+        legacy::reflect::make_adapter<C_CannonDrivingDevice_commandDriving>(TOPIC_commandDriving, TYPE_commandDriving);
+    control_seed(&ctx->control_state, &g_last_control);
+    g_decode_control = control_adapter.decode_cbor;
+    control_adapter.decode_cbor = decode_control_over_last;
+    status = legacy_agent_register_type_adapter(ctx->agent, &control_adapter);
+    if (status == LEGACY_OK) {
+        status = legacy_agent_subscribe_typed(ctx->agent, TOPIC_commandDriving,
+                                              TYPE_commandDriving,
+                                              demo_msg_on_actuator_control, ctx);
     }
-    
-    // Subscribe to control events
-    status = legacy_agent_subscribe_event(ctx->agent, TOPIC_commandDriving,
-                                         TYPE_commandDriving,
-                                         demo_msg_on_actuator_control, ctx);
     if (status != LEGACY_OK) {
         LOG_INFO("ERROR: Failed to subscribe to Actuator Control\n");
         return -1;
     }
     
-    // 3. Vehicle Speed Reader (Low Frequency Vehicle QoS - 1Hz)
-    LegacyReaderConfig speed_rcfg = {
-        ctx->domain_id,
-        "sub1",
-        TOPIC_VehicleSpeed,
-        TYPE_VehicleSpeed,
-        "NstelCustomQosLib::LowFrequencyVehicleProfile"
-    };
-    status = legacy_agent_create_reader(ctx->agent, &speed_rcfg, 2000,
-                                       on_reader_created, (void*)TOPIC_VehicleSpeed);
-    if (status != LEGACY_OK) {
-        LOG_INFO("ERROR: Failed to create Vehicle Speed reader\n");
-        return -1;
-    }
-    
-    // Subscribe to speed events
     status = legacy_agent_subscribe_event(ctx->agent, TOPIC_VehicleSpeed,
                                          TYPE_VehicleSpeed,
                                          demo_msg_on_vehicle_speed, ctx);
@@ -189,11 +274,6 @@ int demo_msg_init(DemoAppContext* ctx) {
         return -1;
     }
     
-    // Give time for all entities to be created
-    #ifdef _VXWORKS_
-    taskDelay(sysClkRateGet());  // 1 second
-    #endif
-    
     LOG_INFO("All message handlers initialized (7 topics)\n");
     return 0;
 }
@@ -203,6 +283,11 @@ void demo_msg_cleanup(DemoAppContext* ctx) {
     
     LOG_INFO("Cleaning up message handlers...\n");
     
+    if (ctx->signal_writer) {
+        legacy_agent_close_writer(ctx->signal_writer);
+        ctx->signal_writer = NULL;
+    }
+    
     // TODO Phase 3: Unsubscribe and delete writers
 }
 
@@ -225,7 +310,7 @@ void demo_msg_on_runbit(LEGACY_HANDLE h, const LegacyEvent* evt, void* user) {
 
         uint32_t reference_num = j.value(F_A_REFERENCE_NUM, 0u);
         std::string type_str = j.value(F_A_TYPE, std::string());
-        T_BITType type = parse_bit_type(type_str.c_str());
+        T_BITType type = parse_bit_type_n(type_str.data(), type_str.size());
 
         printf("[DemoApp Msg] runBIT parsed: A_referenceNum=%u, A_type=%d\n", reference_num, (int)type);
 
@@ -238,74 +323,82 @@ void demo_msg_on_runbit(LEGACY_HANDLE h, const LegacyEvent* evt, void* user) {
     }
 }
 
-void demo_msg_on_actuator_control(LEGACY_HANDLE h, const LegacyEvent* evt, void* user) {
+/* Decoded schema enumerators -> control state. Same results as running the
+ * wire strings through the parse_* helpers (the text path): enumerators
+ * those helpers do not recognize fall back to their defaults. */
+static T_OnOffType control_parm(T_PalmModeType v) {
+    return (v == L_PalmModeType_ON) ? L_OnOffType_ON : L_OnOffType_OFF;
+}
+
+static T_TargetAllotType control_target(T_TargetFixType v) {
+    return (v == L_TargetFixType_ETC) ? L_TargetAllotType_ETC : L_TargetAllotType_ALLOT;
+}
+
+static T_ArmPositionLockType control_arm_position(T_ArmPositionType v) {
+    switch (v) {
+        case L_ArmPositionType_NORMAL:  // "L_ArmPositionType_RELEASE"
+        case L_ArmPositionType_MANUAL:  // "L_ArmPositionType_DRIVING"
+        default: return L_ArmPositionLockType_RELEASE;
+    }
+}
+
+static T_MainCannonReturnType control_cannon_restore(T_CannonRestoreType v) {
+    switch (v) {
+        case L_CannonRestoreType_RELEASE:
+        case L_CannonRestoreType_RESTORE:
+        default: return L_MainCannonReturnType_RELEASE;
+    }
+}
+
+static T_MainCannonFixType control_cannon_fix(T_CannonFixType v) {
+    switch (v) {
+        case L_CannonFixType_RELEASE:
+        case L_CannonFixType_FIX:
+        default: return L_MainCannonFixType_RELEASE;
+    }
+}
+
+static T_EquipOpenLockType control_equip_open(T_EquipOpenStatusType v) {
+    return (v == L_EquipOpenStatusType_OPEN) ? L_EquipOpenLockType_OPEN : L_EquipOpenLockType_LOCK;
+}
+
+void demo_msg_on_actuator_control(LEGACY_HANDLE h, const LegacyEvent* evt, void* user_struct, void* user) {
     DemoAppContext* ctx = (DemoAppContext*)user;
-    if (!ctx || !evt) return;
+    const C_CannonDrivingDevice_commandDriving* cmd = (const C_CannonDrivingDevice_commandDriving*)user_struct;
+    if (!ctx || !evt || !cmd) return;
     
     ctx->control_rx_count++;
-    
-    const char* json_c = evt->data_json;
-    if (!json_c) return;
+    g_last_control = *cmd;
     
     ActuatorControlState* ctrl = &ctx->control_state;
-    
-    try {
-        json j = json::parse(json_c);
 
-        // Extract float/double fields
-        ctrl->drivingPosition = j.value(F_A_DRIVINGPOSITION, ctrl->drivingPosition);
-        ctrl->upDownPosition = j.value(F_A_UPDOWNPOSITION, ctrl->upDownPosition);
-        ctrl->roundAngleVelocity = j.value(F_A_ROUNDANGLEVELOCITY, ctrl->roundAngleVelocity);
-        ctrl->upDownAngleVelocity = j.value(F_A_UPDOWNANGLEVELOCITY, ctrl->upDownAngleVelocity);
-        ctrl->cannonUpDownAngle = j.value(F_A_CANNONUPDOWNANGLE, ctrl->cannonUpDownAngle);
-        ctrl->topRelativeAngle = j.value(F_A_TOPRELATIVEANGLE, ctrl->topRelativeAngle);
-
-        // Extract enum fields (strings)
-        if (j.contains(F_A_OPERATIONMODE)) {
-            std::string enum_val = j[F_A_OPERATIONMODE];
-            ctrl->operationMode = parse_operation_mode(enum_val.c_str());
-        }
-        if (j.contains(F_A_PARM)) {
-            std::string enum_val = j[F_A_PARM];
-            ctrl->parm = parse_onoff_type(enum_val.c_str());
-        }
-        if (j.contains(F_A_TARGET_DESIGNATION)) {
-            std::string enum_val = j[F_A_TARGET_DESIGNATION];
-            ctrl->targetDesingation = parse_target_allot(enum_val.c_str());
-        }
-        if (j.contains(F_A_AUTO_ARM_POSITION)) {
-            std::string enum_val = j[F_A_AUTO_ARM_POSITION];
-            ctrl->autoArmPosition = parse_arm_position_lock(enum_val.c_str());
-        }
-        if (j.contains(F_A_MANUAL_ARM_POSITION)) {
-            std::string enum_val = j[F_A_MANUAL_ARM_POSITION];
-            ctrl->manualArmPosition = parse_arm_position_lock(enum_val.c_str());
-        }
-        if (j.contains(F_A_MAIN_CANNON_RESTORE)) {
-            std::string enum_val = j[F_A_MAIN_CANNON_RESTORE];
-            ctrl->mainCannonRestore = parse_main_cannon_return(enum_val.c_str());
-        }
-        if (j.contains(F_A_MAIN_CANNON_FIX)) {
-            std::string enum_val = j[F_A_MAIN_CANNON_FIX];
-            ctrl->manCannonFix = parse_main_cannon_fix(enum_val.c_str());
-        }
-        if (j.contains(F_A_CLOSE_EQUIP_OPEN_STATUS)) {
-            std::string enum_val = j[F_A_CLOSE_EQUIP_OPEN_STATUS];
-            ctrl->closeEquipOpenStatus = parse_equip_open_lock(enum_val.c_str());
-        }
-
-        ctrl->last_update_time = ctx->tick_count;
-        ctx->control_rx_count++;
+    // Position/velocity fields
+    ctrl->drivingPosition = cmd->A_roundPosition;
+    ctrl->upDownPosition = cmd->A_upDownPosition;
+    ctrl->roundAngleVelocity = cmd->A_roundAngleVelocity;
+    ctrl->upDownAngleVelocity = cmd->A_upDownAngleVelocity;
+    ctrl->cannonUpDownAngle = cmd->A_cannonUpDownAngle;
+    ctrl->topRelativeAngle = cmd->A_topRelativeAngle;
+
+    // Enum fields
+    ctrl->operationMode = cmd->A_operationMode;
+    ctrl->parm = control_parm(cmd->A_parm);
+    ctrl->targetDesingation = control_target(cmd->A_targetFix);
+    ctrl->autoArmPosition = control_arm_position(cmd->A_autoArmPosition);
+    ctrl->manualArmPosition = control_arm_position(cmd->A_manualArmPosition);
+    ctrl->mainCannonRestore = control_cannon_restore(cmd->A_mainCannonRestore);
+    ctrl->manCannonFix = control_cannon_fix(cmd->A_mainCannonFix);
+    ctrl->closeEquipOpenStatus = control_equip_open(cmd->A_closureEquipOpenStatus);
+
+    ctrl->last_update_time = demo_timer_now_ms();
+    ctx->control_rx_count++;
 
-        if ((ctx->control_rx_count % 100) == 0) {
-            LOG_RX("Actuator Control: driving=%.2f, updown=%.2f, mode=%d (rx=%u)\n",
-                   ctrl->drivingPosition,
-                   ctrl->upDownPosition,
-                   (int)ctrl->operationMode,
-                   ctx->control_rx_count);
-        }
-    } catch (...) {
-        LOG_INFO("ERROR: Failed to parse actuator control JSON\n");
+    if ((ctx->control_rx_count % 100) == 0) {
+        LOG_RX("Actuator Control: driving=%.2f, updown=%.2f, mode=%d (rx=%u)\n",
+               ctrl->drivingPosition,
+               ctrl->upDownPosition,
+               (int)ctrl->operationMode,
+               ctx->control_rx_count);
     }
 }
 
@@ -319,7 +412,7 @@ void demo_msg_on_vehicle_speed(LEGACY_HANDLE h, const LegacyEvent* evt, void* us
     try {
         json j = json::parse(json_c);
         ctx->speed_state.speed = j.value(F_A_SPEED, ctx->speed_state.speed);
-        ctx->speed_state.last_update_time = ctx->tick_count;
+        ctx->speed_state.last_update_time = demo_timer_now_ms();
         ctx->speed_rx_count++;
 
         LOG_RX("Vehicle Speed: A_value=%.2f m/s (rx=%u)\n",
@@ -364,9 +457,10 @@ int demo_msg_publish_pbit(DemoAppContext* ctx) {
         {F_A_INSTANCEID, 1}
     };
     // Time
+    uint64_t now_ms = demo_timer_now_ms();
     j[F_A_TIMEOFDATA] = {
-        {F_A_SECOND, (long long)(ctx->tick_count/1000)},
-        {F_A_NANOSECONDS, (int)((ctx->tick_count%1000)*1000000)}
+        {F_A_SECOND, (long long)(now_ms/1000)},
+        {F_A_NANOSECONDS, (int)((now_ms%1000)*1000000)}
     };
     // Cannon source id
     j[F_A_CANNON_SOURCEID] = {
@@ -416,7 +510,8 @@ int demo_msg_publish_cbit(DemoAppContext* ctx) {
     CBITComponentState* cbit = &ctx->bit_state.cbit_components;
     json j;
     j[F_A_SOURCEID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
-    j[F_A_TIMEOFDATA] = {{F_A_SECOND,(long long)(ctx->tick_count/1000)},{F_A_NANOSECONDS,(int)((ctx->tick_count%1000)*1000000)}};
+    uint64_t now_ms = demo_timer_now_ms();
+    j[F_A_TIMEOFDATA] = {{F_A_SECOND,(long long)(now_ms/1000)},{F_A_NANOSECONDS,(int)((now_ms%1000)*1000000)}};
     j[F_A_CANNON_SOURCEID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
     j[F_A_CONTROLLER_NETWORK] = format_bit_result(cbit->controllerNetwork);
     j[F_A_UPDOWNMOTOR] = format_bit_result(cbit->base.upDownMotor);
@@ -455,14 +550,29 @@ int demo_msg_publish_cbit(DemoAppContext* ctx) {
     return 0;
 }
 
+void demo_msg_capture_result_bit(DemoAppContext* ctx, DemoResultBitSample* out) {
+    out->time_ms = demo_timer_now_ms();
+    out->reference_num = ctx->bit_state.ibit_reference_num;
+    out->components = ctx->bit_state.result_components;
+}
+
 int demo_msg_publish_result_bit(DemoAppContext* ctx) {
     if (!ctx || !ctx->agent) return -1;
+
+    DemoResultBitSample sample;
+    demo_msg_capture_result_bit(ctx, &sample);
+    return demo_msg_publish_result_bit_sample(ctx, &sample);
+}
+
+int demo_msg_publish_result_bit_sample(DemoAppContext* ctx, const DemoResultBitSample* sample) {
+    if (!ctx || !ctx->agent || !sample) return -1;
     
-    BITComponentState* result = &ctx->bit_state.result_components;
+    const BITComponentState* result = &sample->components;
     json j;
     j[F_A_SOURCEID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
-    j[F_A_TIMEOFDATA] = {{F_A_SECOND,(long long)(ctx->tick_count/1000)},{F_A_NANOSECONDS,(int)((ctx->tick_count%1000)*1000000)}};
-    j[F_A_REFERENCE_NUM] = ctx->bit_state.ibit_reference_num;
+    uint64_t now_ms = sample->time_ms;
+    j[F_A_TIMEOFDATA] = {{F_A_SECOND,(long long)(now_ms/1000)},{F_A_NANOSECONDS,(int)((now_ms%1000)*1000000)}};
+    j[F_A_REFERENCE_NUM] = sample->reference_num;
     j[F_A_CANNON_SOURCEID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
     j[F_A_BITRUNNING] = (result->bitRunning == L_BITResultType_NORMAL) ? true : false;
     j[F_A_UPDOWNMOTOR] = format_bit_result(result->upDownMotor);
@@ -512,17 +622,40 @@ int demo_msg_publish_result_bit(DemoAppContext* ctx) {
     );
     
     LOG_TX("resultBIT published: ref=%u, result=%s\n",
-           ctx->bit_state.ibit_reference_num,
+           sample->reference_num,
            has_fault ? "FAIL" : "PASS");
     
     return 0;
 }
 
+void demo_msg_capture_actuator_signal(DemoAppContext* ctx, DemoSignalSample* out) {
+    const ActuatorSignalState* sig = &ctx->signal_state;
+    out->tick = ctx->tick_count;
+    out->azAngle = sig->azAngle;
+    out->e1AngleVelocity = sig->e1AngleVelocity;
+    out->roundGyro = sig->roundGyro;
+    out->upDownGyro = sig->upDownGyro;
+    out->energyStorage = (uint8_t)sig->energyStorage;
+    out->mainCannonFixStatus = (uint8_t)sig->mainCannonFixStatus;
+    out->deckClearance = (uint8_t)sig->deckClearance;
+    out->autoArmPositionComplement = (uint8_t)sig->autoArmPositionComplement;
+    out->manualArmPositionComple = (uint8_t)sig->manualArmPositionComple;
+    out->mainCannonRestoreComplement = (uint8_t)sig->mainCannonRestoreComplement;
+    out->armSafetyMainCannonLock = (uint8_t)sig->armSafetyMainCannonLock;
+    out->shutdown = (uint8_t)sig->shutdown;
+}
+
 int demo_msg_publish_actuator_signal(DemoAppContext* ctx) {
     if (!ctx || !ctx->agent) return -1;
-    
-    ActuatorSignalState* sig = &ctx->signal_state;
-    
+
+    DemoSignalSample sample;
+    demo_msg_capture_actuator_signal(ctx, &sample);
+    return demo_msg_publish_actuator_signal_sample(ctx, &sample);
+}
+
+int demo_msg_publish_actuator_signal_sample(DemoAppContext* ctx, const DemoSignalSample* sig) {
+    if (!ctx || !ctx->agent || !sig) return -1;
+
     // Quantize/clamp values (use double-aware math)
     double az_v = sig->e1AngleVelocity;
     if (az_v > 800.0) az_v = 800.0;
@@ -544,50 +677,40 @@ int demo_msg_publish_actuator_signal(DemoAppContext* ctx) {
     if (updown_v < -655.0) updown_v = -655.0;
     updown_v = round(updown_v / 0.02) * 0.02;
 
-    json j;
-    j[F_A_RECIPIENTID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
-    j[F_A_SOURCEID] = {{F_A_RESOURCEID,1},{F_A_INSTANCEID,1}};
-    j[F_A_TIMEOFDATA] = {{F_A_SECOND,(long long)(ctx->tick_count/1000)},{F_A_NANOSECONDS,(int)((ctx->tick_count%1000)*1000000)}};
-    j[F_A_AZANGLEVELOCITY] = az_v;
-    j[F_A_E1ANGLEVELOCITY] = e1_v;
-    j[F_A_ENERGY_STORAGE] = format_energy_storage(sig->energyStorage);
-    j[F_A_MAINCANNONFIXSTATUS] = format_main_cannon_fix_status(sig->mainCannonFixStatus);
-    j[F_A_DECKCLEARANCE] = format_dek_clearance(sig->deckClearance);
-    j[F_A_AUTO_ARM_POSITION_COMPLEMENT] = format_cannon_driving_from_arm(sig->autoArmPositionComplement);
-    j[F_A_MANUAL_ARM_POSITION_COMPLEMENT] = format_cannon_driving_from_arm(sig->manualArmPositionComple);
-    j[F_A_MAIN_CANNON_RESTORE_COMPLEMENT] = format_cannon_driving_from_return(sig->mainCannonRestoreComplement);
-    j[F_A_ARM_SAFETY_MAIN_CANNON_LOCK] = format_arm_safety_lock(sig->armSafetyMainCannonLock);
-    j[F_A_SHUTDOWN] = format_shutdown_type(sig->shutdown);
-    j[F_A_ROUNDGYRO] = round_v;
-    j[F_A_UPDOWNGYRO] = updown_v;
-
-    uint64_t jd0 = 0, jd1 = 0;
-#ifdef DEMO_PERF_INSTRUMENTATION
-#if defined(_VXWORKS_)
-    unsigned long _tk0 = tickGet(); int _tr0 = sysClkRateGet(); jd0 = (uint64_t)_tk0 * (1000000000ULL / (_tr0 > 0 ? _tr0 : 1));
-#else
-    struct timespec _ts0; clock_gettime(CLOCK_MONOTONIC, &_ts0); jd0 = (uint64_t)_ts0.tv_sec*1000000000ULL + _ts0.tv_nsec;
-#endif
-#endif
-    std::string s = j.dump();
-#ifdef DEMO_PERF_INSTRUMENTATION
-#if defined(_VXWORKS_)
-    unsigned long _tk1 = tickGet(); int _tr1 = sysClkRateGet(); jd1 = (uint64_t)_tk1 * (1000000000ULL / (_tr1 > 0 ? _tr1 : 1));
-#else
-    struct timespec _ts1; clock_gettime(CLOCK_MONOTONIC, &_ts1); jd1 = (uint64_t)_ts1.tv_sec*1000000000ULL + _ts1.tv_nsec;
-#endif
-    ctx->json_dump_ns_total += (jd1 > jd0) ? (jd1 - jd0) : 0ULL;
-    ctx->json_dump_count++;
-#endif
-
-    LegacyWriteJsonOptions wopt = {
-        TOPIC_Signal,
-        TYPE_Signal,
-        s.c_str(),
-        ctx->domain_id,
-        "pub1",
-        "NstelCustomQosLib::HighFrequencyPeriodicProfile"
-    };
+    // Filled in wire form; the library encodes it through its reflected descriptor
+    C_CannonDrivingDevice_Signal out;
+    memset(&out, 0, sizeof(out));
+    out.A_recipientID.A_resourceId = 1;
+    out.A_recipientID.A_instanceId = 1;
+    out.A_sourceID.A_resourceId = 1;
+    out.A_sourceID.A_instanceId = 1;
+    // Stamped with the sampling tick, not the (later) write time
+    out.A_timeOfDataGeneration.A_second = (int64_t)(sig->tick / 1000);
+    out.A_timeOfDataGeneration.A_nanoseconds = (int32_t)((sig->tick % 1000) * 1000000);
+    out.A_azAngleVelocity = az_v;
+    out.A_e1AngleVelocity = e1_v;
+    out.A_energyStorage = (sig->energyStorage == L_ChangingStatusType_DISCHARGE)
+        ? L_ChangingStatusType_DISCHARGE : L_ChangingStatusType_NORMAL;
+    out.A_mainCannonFixStatus = (sig->mainCannonFixStatus == L_MainCannonFixStatusType_FIX)
+        ? L_CannonFixType_FIX : L_CannonFixType_RELEASE;
+    out.A_deckCleance = (sig->deckClearance == L_DekClearanceType_RUNNING)
+        ? L_DekClearanceType_RUNNING : L_DekClearanceType_OUTSIDE;
+    out.A_autoArmPositionComplement = (sig->autoArmPositionComplement == L_ArmPositionType_MANUAL)
+        ? L_CannonDrivingType_DONE : L_CannonDrivingType_DRIVING;
+    out.A_manualArmPositionComplement = (sig->manualArmPositionComple == L_ArmPositionType_MANUAL)
+        ? L_CannonDrivingType_DONE : L_CannonDrivingType_DRIVING;
+    out.A_mainCannonRestoreComplement = (sig->mainCannonRestoreComplement == L_MainCannonReturnStatusType_COMPLETE)
+        ? L_CannonDrivingType_DONE : L_CannonDrivingType_DRIVING;
+    out.A_armSafetyMainCannonLock = (sig->armSafetyMainCannonLock == L_ArmSafetyMainCannonLock_COMPLETE)
+        ? L_CannonLockType_LOCKED : L_CannonLockType_NORMAL;
+    out.A_shutdown = (sig->shutdown == L_CannonDrivingDeviceShutdownType_SHUTDOWN)
+        ? L_CannonDrivingDeviceShutdownType_SHUTDOWN : L_CannonDrivingDeviceShutdownType_UNKNOWN;
+    out.A_roundGyro = round_v;
+    out.A_upDownGyro = updown_v;
+
+    if (!ctx->signal_writer) {
+        return -1;
+    }
     
     uint64_t lw0 = 0, lw1 = 0;
 #ifdef DEMO_PERF_INSTRUMENTATION
@@ -597,8 +720,8 @@ int demo_msg_publish_actuator_signal(DemoAppContext* ctx) {
     struct timespec _lwt0; clock_gettime(CLOCK_MONOTONIC, &_lwt0); lw0 = (uint64_t)_lwt0.tv_sec*1000000000ULL + _lwt0.tv_nsec;
 #endif
 #endif
-    LegacyStatus status = legacy_agent_write_json(ctx->agent, &wopt, 500,
-                                                  on_write_complete, (void*)"Signal");
+    /* 200Hz periodic sample: no per-sample ack; struct fields go straight to CBOR */
+    LegacyStatus status = legacy_agent_writer_write_struct_noack(ctx->signal_writer, &out);
 #ifdef DEMO_PERF_INSTRUMENTATION
 #if defined(_VXWORKS_)
     unsigned long _lwk1 = tickGet(); int _lwr1 = sysClkRateGet(); lw1 = (uint64_t)_lwk1 * (1000000000ULL / (_lwr1 > 0 ? _lwr1 : 1));
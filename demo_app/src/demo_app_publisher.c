@@ -1,57 +1,261 @@
 /* demo_app_publisher.c - Publisher queue and worker
- * Timer enqueues publish events; worker performs legacy_agent_write_json calls
+ * Timer enqueues publish events; worker performs the agent writes
  * to avoid blocking timer context.
+ *
+ * Events name a registered publisher topic. A coalescing (periodic) topic
+ * has at most one event pending: enqueueing while one is pending only
+ * counts a coalesced sample, and since the publish function reads the
+ * current state when the worker runs it, the agent always gets the latest
+ * value instead of a backlog. Non-coalescing topics (one-shot events such
+ * as resultBIT) queue every enqueue.
+ *
+ * Sampled topics (actuator signal) copy their state into a block of a
+ * preallocated sample pool at enqueue, on the timer task, and the worker
+ * publishes that copy. Blocks are opaque here; their size is checked once
+ * at registration. A coalesced sample replaces the pending block, so
+ * the write carries the newest sample and its sampling tick without the
+ * worker ever reading state the simulation is updating.
  */
 
 #include "../include/demo_app_publisher.h"
 #include "../include/demo_app_log.h"
 #include "../include/demo_app.h"
+#include <string.h>
 
 #ifdef _VXWORKS_
 #include <msgQLib.h>
 #include <taskLib.h>
 #include <sysLib.h>
 #include <tickLib.h>
-#include <string.h>
+#include <vxAtomicLib.h>
 
-static MSG_Q_ID g_pubQ = NULL;
-static TASK_ID g_pubTask = TASK_ID_ERROR;
-static int g_pubq_max = 256;
-static uint64_t g_pubq_drop_count = 0;
+typedef atomic_t PubAtomic;
+#define PUB_LOAD(a)     ((int)vxAtomicGet(&(a)))
+#define PUB_STORE(a, v) ((void)vxAtomicSet(&(a), (v)))
+#define PUB_XCHG(a, v)  ((int)vxAtomicSet(&(a), (v)))    // returns the old value
+
+static uint64_t pub_now_ns(void) {
+    int tr = sysClkRateGet();
+    return (uint64_t)tick64Get() * (1000000000ULL / (tr > 0 ? tr : 1));
+}
+#else // POSIX / Windows fallback (compiled as C++)
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+typedef std::atomic<int> PubAtomic;
+#define PUB_LOAD(a)     ((a).load())
+#define PUB_STORE(a, v) ((a).store(v))
+#define PUB_XCHG(a, v)  ((a).exchange(v))
+
+static uint64_t pub_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#if defined(_MSC_VER)
+#define PUB_CACHE_ALIGNED __declspec(align(64))
+#else
+#define PUB_CACHE_ALIGNED __attribute__((aligned(64)))
+#endif
 
-typedef enum { PUB_EVT_SIGNAL = 1 } PubEventType;
 typedef struct {
-    PubEventType type;
+    int slot;                    // publisher topic
+    int sample;                  // sample block, -1: none / pending (coalesced)
     DemoAppContext* ctx;
+    uint64_t enqueue_ns;
 } PubEvent;
 
+typedef struct {
+    DemoPublishFn publish;
+    DemoSampleCaptureFn capture;         // sampled topics only
+    DemoSamplePublishFn publish_sample;
+    int coalesce;
+    DemoPublisherTopicStats stats;
+} PubTopic;
+
+// Registered while the worker is stopped (pub_started() == 0); the timer
+// task and the worker index it without locking
+static PubTopic g_topics[DEMO_PUBLISHER_MAX_TOPICS];
+static int g_topic_count = 0;
+
+static int pub_started(void);
+
+// Pending event per coalescing topic: 0 = none, otherwise 1 (plain topic)
+// or sample block + 1 (sampled topic)
+static PubAtomic g_pending[DEMO_PUBLISHER_MAX_TOPICS];
+
+/* Sample pool. Blocks are cache-line sized so the producer filling one
+ * never shares a line with the worker reading another. The producer
+ * allocates from a private free stack; the worker returns blocks through
+ * a single-producer/single-consumer ring the producer drains when the
+ * stack runs empty. */
+#define SAMPLE_RET_SIZE (2 * DEMO_PUBLISHER_SAMPLE_POOL)    // never fills
+#define SAMPLE_RET_MASK (SAMPLE_RET_SIZE - 1)
+
+typedef struct PUB_CACHE_ALIGNED {
+    union {
+        unsigned char bytes[DEMO_PUBLISHER_SAMPLE_SIZE];
+        uint64_t align_u64;
+        double align_f64;
+    } u;
+} PubSampleBlock;
+
+static PubSampleBlock g_samples[DEMO_PUBLISHER_SAMPLE_POOL];
+static int g_sample_free[DEMO_PUBLISHER_SAMPLE_POOL];    // producer only
+static int g_sample_free_top = 0;
+static int g_sample_ret[SAMPLE_RET_SIZE];
+static PubAtomic g_sample_ret_head;                     // producer
+static PubAtomic g_sample_ret_tail;                     // worker
+
+// Forget pending events and return every sample block (worker stopped)
+static void pub_reset(void) {
+    int i;
+    for (i = 0; i < DEMO_PUBLISHER_MAX_TOPICS; ++i) PUB_STORE(g_pending[i], 0);
+    for (i = 0; i < DEMO_PUBLISHER_SAMPLE_POOL; ++i) {
+        g_sample_free[i] = DEMO_PUBLISHER_SAMPLE_POOL - 1 - i;
+    }
+    g_sample_free_top = DEMO_PUBLISHER_SAMPLE_POOL;
+    PUB_STORE(g_sample_ret_head, 0);
+    PUB_STORE(g_sample_ret_tail, 0);
+}
+
+// Producer: take a free block, or -1 if the pool is exhausted
+static int sample_alloc(void) {
+    if (g_sample_free_top == 0) {
+        int head = PUB_LOAD(g_sample_ret_head);
+        int tail = PUB_LOAD(g_sample_ret_tail);
+        while (head != tail) {
+            g_sample_free[g_sample_free_top++] = g_sample_ret[head];
+            head = (head + 1) & SAMPLE_RET_MASK;
+        }
+        PUB_STORE(g_sample_ret_head, head);
+        if (g_sample_free_top == 0) return -1;
+    }
+    return g_sample_free[--g_sample_free_top];
+}
+
+// Producer: free a block the worker never saw
+static void sample_free(int block) {
+    g_sample_free[g_sample_free_top++] = block;
+}
+
+// Worker: hand a published block back to the producer
+static void sample_release(int block) {
+    int tail = PUB_LOAD(g_sample_ret_tail);
+    g_sample_ret[tail] = block;
+    PUB_STORE(g_sample_ret_tail, (tail + 1) & SAMPLE_RET_MASK);
+}
+
+static int pub_register(const char* name, DemoPublishFn publish, DemoSampleCaptureFn capture,
+                        DemoSamplePublishFn publish_sample, int coalesce) {
+    int i;
+    if (pub_started()) {
+        LOG_ERROR("[Publisher] Cannot register %s while running\n", name);
+        return -1;
+    }
+    for (i = 0; i < g_topic_count; ++i) {
+        if (strcmp(g_topics[i].stats.name, name) == 0) break;
+    }
+    if (i == g_topic_count) {
+        if (g_topic_count >= DEMO_PUBLISHER_MAX_TOPICS) return -1;
+        memset(&g_topics[i], 0, sizeof(g_topics[0]));
+        g_topics[i].stats.name = name;
+        g_topic_count++;
+    }
+    g_topics[i].publish = publish;
+    g_topics[i].capture = capture;
+    g_topics[i].publish_sample = publish_sample;
+    g_topics[i].coalesce = coalesce;
+    return i;
+}
+
+int demo_publisher_register(const char* name, DemoPublishFn publish, int coalesce) {
+    if (!name || !publish) return -1;
+    return pub_register(name, publish, NULL, NULL, coalesce);
+}
+
+int demo_publisher_register_sampled(const char* name, DemoSampleCaptureFn capture,
+                                    DemoSamplePublishFn publish, size_t sample_size, int coalesce) {
+    if (!name || !capture || !publish) return -1;
+    if (sample_size == 0 || sample_size > DEMO_PUBLISHER_SAMPLE_SIZE) {
+        LOG_ERROR("[Publisher] Sample of %s too large (%u bytes)\n", name, (unsigned)sample_size);
+        return -1;
+    }
+    return pub_register(name, NULL, capture, publish, coalesce);
+}
+
+int demo_publisher_topic_count(void) {
+    return g_topic_count;
+}
+
+int demo_publisher_get_topic_stats(int slot, DemoPublisherTopicStats* out) {
+    if (slot < 0 || slot >= g_topic_count || !out) return -1;
+    *out = g_topics[slot].stats;
+    return 0;
+}
+
+// Worker side: run one event's publish and account its latency
+static void pub_dispatch(const PubEvent* ev) {
+    PubTopic* t;
+    int sample = ev->sample;
+    uint64_t t0, t1;
+    if (ev->slot < 0 || ev->slot >= g_topic_count || !ev->ctx) return;
+    t = &g_topics[ev->slot];
+
+    // Take the pending sample: one enqueued from now on queues a new event
+    if (t->coalesce) {
+        int token = PUB_XCHG(g_pending[ev->slot], 0);
+        if (t->capture) sample = token - 1;
+    }
+    if (t->capture && sample < 0) return;
+
+    t0 = pub_now_ns();
+    if (t->capture) {
+        t->publish_sample(ev->ctx, g_samples[sample].u.bytes);
+        sample_release(sample);
+    } else {
+        t->publish(ev->ctx);
+    }
+    t1 = pub_now_ns();
+
+    uint64_t latency = (t0 > ev->enqueue_ns) ? t0 - ev->enqueue_ns : 0;
+    t->stats.written++;
+    t->stats.latency_ns_total += latency;
+    if (latency > t->stats.latency_ns_max) t->stats.latency_ns_max = latency;
+    t->stats.write_ns_total += (t1 > t0) ? t1 - t0 : 0;
+#ifdef DEMO_PERF_INSTRUMENTATION
+    ev->ctx->pub_worker_write_ns_total += (t1 > t0) ? (t1 - t0) : 0ULL;
+    ev->ctx->pub_worker_write_count++;
+#endif
+}
+
+#ifdef _VXWORKS_
+
+static MSG_Q_ID g_pubQ = NULL;
+static TASK_ID g_pubTask = TASK_ID_ERROR;
+static int g_pubq_max = DEMO_PUBLISHER_QUEUE_SIZE;
+static uint64_t g_pubq_drop_count = 0;
+static int g_pubq_high_water = 0;
+
 static void publisherTask(void) {
     PubEvent evt;
     while (1) {
         int n = msgQReceive(g_pubQ, (char*)&evt, sizeof(evt), WAIT_FOREVER);
         if (n == sizeof(evt)) {
-            if (evt.type == PUB_EVT_SIGNAL && evt.ctx) {
-                LOG_DEBUG("Dequeued signal event\n");
-                /* Measure worker dequeue->publish duration when instrumentation enabled */
-#ifdef DEMO_PERF_INSTRUMENTATION
-                uint64_t _tw0 = 0, _tw1 = 0;
-                {
-                    unsigned long tk = tickGet(); int tr = sysClkRateGet();
-                    _tw0 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-                }
-                demo_msg_publish_actuator_signal(evt.ctx);
-                {
-                    unsigned long tk = tickGet(); int tr = sysClkRateGet();
-                    _tw1 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-                }
-                if (evt.ctx) {
-                    evt.ctx->pub_worker_write_ns_total += (_tw1 > _tw0) ? (_tw1 - _tw0) : 0ULL;
-                    evt.ctx->pub_worker_write_count++;
-                }
-#else
-                demo_msg_publish_actuator_signal(evt.ctx);
-#endif
-            }
+            LOG_DEBUG("Dequeued event (topic %d)\n", evt.slot);
+            pub_dispatch(&evt);
         } else {
             // queue error or deleted
             break;
@@ -61,7 +265,8 @@ static void publisherTask(void) {
 
 int demo_publisher_init(void) {
     if (g_pubQ) return 0; // already
-    g_pubq_max = 4096;
+    // Events still pending when the previous queue was deleted are gone
+    pub_reset();
     g_pubQ = msgQCreate(g_pubq_max, sizeof(PubEvent), MSG_Q_FIFO);
     if (!g_pubQ) {
         LOG_ERROR("msgQCreate failed\n");
@@ -79,6 +284,10 @@ int demo_publisher_init(void) {
     return 0;
 }
 
+static int pub_started(void) {
+    return g_pubQ != NULL;
+}
+
 void demo_publisher_shutdown(void) {
     if (g_pubQ) {
         msgQDelete(g_pubQ);
@@ -87,129 +296,228 @@ void demo_publisher_shutdown(void) {
     // task will exit when msgQReceive fails
 }
 
-int demo_publisher_enqueue_signal(DemoAppContext* ctx) {
+static int pub_queue_push(const PubEvent* e) {
     if (!g_pubQ) return -1;
-    PubEvent e;
-    e.type = PUB_EVT_SIGNAL;
-    e.ctx = ctx;
-    STATUS s = msgQSend(g_pubQ, (char*)&e, sizeof(e), NO_WAIT, MSG_PRI_NORMAL);
-    if (s == OK) return 0;
+    STATUS s = msgQSend(g_pubQ, (char*)e, sizeof(*e), NO_WAIT, MSG_PRI_NORMAL);
+    if (s == OK) {
+        int n = msgQNumMsgs(g_pubQ);
+        if (n > g_pubq_high_water) g_pubq_high_water = n;
+        return 0;
+    }
     /* dropped (queue full) */
     g_pubq_drop_count++;
     return -1;
 }
 
-int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count) {
+int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count, int* out_high_water) {
     if (out_queue_len) {
         if (g_pubQ) *out_queue_len = msgQNumMsgs(g_pubQ);
         else *out_queue_len = 0;
     }
     if (out_queue_max) *out_queue_max = g_pubq_max;
     if (out_drop_count) *out_drop_count = g_pubq_drop_count;
+    if (out_high_water) *out_high_water = g_pubq_high_water;
     return 0;
 }
 
 #else // POSIX / Windows fallback
 
-#include <pthread.h>
-#include <stdlib.h>
-#include <unistd.h>
-#include <time.h>
-#include <queue>
-#include <condition_variable>
-#include <mutex>
+// Single-producer (timer task) / single-consumer (worker) ring. Enqueue is
+// lock-free and only makes a system call when the worker is parked.
+static const uint32_t kRingSize = DEMO_PUBLISHER_QUEUE_SIZE;   // power of two
+static const uint32_t kRingMask = kRingSize - 1;
+static const uint32_t kBatchMax = 64;           // events per dequeue
+static const int kSpinBeforePark = 100;         // empty polls before parking
 
-typedef enum { PUB_EVT_SIGNAL = 1 } PubEventType;
-typedef struct {
-    PubEventType type;
-    DemoAppContext* ctx;
-} PubEvent;
+struct alignas(64) RingIndex {
+    std::atomic<uint32_t> v;
+};
 
-static std::queue<PubEvent> g_queue;
-static std::mutex g_queue_mutex;
-static std::condition_variable g_queue_cv;
-static bool g_worker_running = false;
+static PubEvent g_ring[kRingSize];
+static RingIndex g_ring_head;                   // next slot to read (worker)
+static RingIndex g_ring_tail;                   // next slot to write (producer)
+static std::atomic<int> g_worker_parked(0);
+static std::atomic<bool> g_worker_running(false);
+static std::atomic<uint64_t> g_queue_drop_count(0);
+static std::atomic<uint32_t> g_queue_high_water(0);
 static pthread_t g_worker_thread;
-static size_t g_queue_max = 4096;
-static uint64_t g_queue_drop_count = 0;
+
+#ifdef __linux__
+static int g_wake_fd = -1;
+
+static void worker_park(void) {
+    uint64_t v;
+    while (read(g_wake_fd, &v, sizeof(v)) < 0 && errno == EINTR) {
+    }
+}
+
+static void worker_unpark(void) {
+    uint64_t one = 1;
+    ssize_t r = write(g_wake_fd, &one, sizeof(one));
+    (void)r;
+}
+#else
+static std::mutex g_park_mutex;
+static std::condition_variable g_park_cv;
+static bool g_park_signaled = false;
+
+static void worker_park(void) {
+    std::unique_lock<std::mutex> lk(g_park_mutex);
+    g_park_cv.wait(lk, []{ return g_park_signaled; });
+    g_park_signaled = false;
+}
+
+static void worker_unpark(void) {
+    {
+        std::lock_guard<std::mutex> lk(g_park_mutex);
+        g_park_signaled = true;
+    }
+    g_park_cv.notify_one();
+}
+#endif
 
 static void* worker_thread_func(void* arg) {
     (void)arg;
+    PubEvent batch[kBatchMax];
+    uint32_t head = g_ring_head.v.load(std::memory_order_relaxed);
+    int idle = 0;
+
     while (1) {
-        PubEvent ev;
-        {
-            std::unique_lock<std::mutex> lk(g_queue_mutex);
-            g_queue_cv.wait(lk, []{ return !g_queue.empty() || !g_worker_running; });
-            if (!g_worker_running && g_queue.empty()) break;
-            ev = g_queue.front(); g_queue.pop();
-        }
-        if (ev.type == PUB_EVT_SIGNAL && ev.ctx) {
-            demo_log(LOG_LEVEL_INFO, "[Publisher] Dequeued signal event\n");
-            /* Measure worker dequeue->publish duration when instrumentation enabled */
-#ifdef DEMO_PERF_INSTRUMENTATION
-            {
-                uint64_t _tw0 = 0, _tw1 = 0;
-                struct timespec _t0; clock_gettime(CLOCK_MONOTONIC, &_t0); _tw0 = (uint64_t)_t0.tv_sec*1000000000ULL + _t0.tv_nsec;
-                demo_msg_publish_actuator_signal(ev.ctx);
-                struct timespec _t1; clock_gettime(CLOCK_MONOTONIC, &_t1); _tw1 = (uint64_t)_t1.tv_sec*1000000000ULL + _t1.tv_nsec;
-                if (ev.ctx) {
-                    ev.ctx->pub_worker_write_ns_total += (_tw1 > _tw0) ? (_tw1 - _tw0) : 0ULL;
-                    ev.ctx->pub_worker_write_count++;
-                }
-            }
-#else
-            demo_msg_publish_actuator_signal(ev.ctx);
-#endif
+        uint32_t tail = g_ring_tail.v.load(std::memory_order_acquire);
+        if (tail == head) {
+            // Drained: exit only once the ring is empty
+            if (!g_worker_running.load(std::memory_order_acquire)) break;
+            if (idle++ < kSpinBeforePark) continue;
+            // Announce the park, then re-check: the producer stores tail
+            // before reading the flag, so one of the two sees the other
+            g_worker_parked.store(1);
+            if (g_ring_tail.v.load() == head && g_worker_running.load()) worker_park();
+            g_worker_parked.store(0, std::memory_order_relaxed);
+            idle = 0;
+            continue;
         }
+
+        // Copy a batch out and release its slots before publishing
+        uint32_t n = tail - head;
+        if (n > kBatchMax) n = kBatchMax;
+        for (uint32_t i = 0; i < n; ++i) batch[i] = g_ring[(head + i) & kRingMask];
+        head += n;
+        g_ring_head.v.store(head, std::memory_order_release);
+        idle = 0;
+
+        demo_log(LOG_LEVEL_INFO, "[Publisher] Dequeued %u event(s)\n", n);
+        for (uint32_t i = 0; i < n; ++i) pub_dispatch(&batch[i]);
     }
     return NULL;
 }
 
 int demo_publisher_init(void) {
-    if (g_worker_running) return 0;
-    g_worker_running = true;
+    if (g_worker_running.load()) return 0;
+    pub_reset();
+#ifdef __linux__
+    g_wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (g_wake_fd < 0) return -1;
+#endif
+    g_worker_running.store(true);
     if (pthread_create(&g_worker_thread, NULL, worker_thread_func, NULL) != 0) {
-        g_worker_running = false;
+        g_worker_running.store(false);
+#ifdef __linux__
+        close(g_wake_fd);
+        g_wake_fd = -1;
+#endif
         return -1;
     }
     demo_log(LOG_LEVEL_INFO, "[Publisher] Worker started\n");
     return 0;
 }
 
+static int pub_started(void) {
+    return g_worker_running.load() ? 1 : 0;
+}
+
 void demo_publisher_shutdown(void) {
-    {
-        std::lock_guard<std::mutex> lk(g_queue_mutex);
-        g_worker_running = false;
-    }
-    g_queue_cv.notify_all();
-    if (g_worker_running == false) {
-        pthread_join(g_worker_thread, NULL);
-    }
+    if (!g_worker_running.exchange(false)) return;
+    worker_unpark();
+    pthread_join(g_worker_thread, NULL);
+#ifdef __linux__
+    close(g_wake_fd);
+    g_wake_fd = -1;
+#endif
 }
 
-int demo_publisher_enqueue_signal(DemoAppContext* ctx) {
-    if (!g_worker_running) return -1;
-    PubEvent e; e.type = PUB_EVT_SIGNAL; e.ctx = ctx;
-    {
-        std::lock_guard<std::mutex> lk(g_queue_mutex);
-        if (g_queue.size() >= g_queue_max) {
-            g_queue_drop_count++;
-            return -1;
-        }
-        g_queue.push(e);
+static int pub_queue_push(const PubEvent* e) {
+    if (!g_worker_running.load(std::memory_order_relaxed)) return -1;
+    uint32_t tail = g_ring_tail.v.load(std::memory_order_relaxed);
+    uint32_t used = tail - g_ring_head.v.load(std::memory_order_acquire);
+    if (used >= kRingSize) {
+        g_queue_drop_count.fetch_add(1, std::memory_order_relaxed);
+        return -1;
     }
-    g_queue_cv.notify_one();
+    g_ring[tail & kRingMask] = *e;
+    g_ring_tail.v.store(tail + 1);
+    if (used + 1 > g_queue_high_water.load(std::memory_order_relaxed)) {
+        g_queue_high_water.store(used + 1, std::memory_order_relaxed);
+    }
+    if (g_worker_parked.load() && g_worker_parked.exchange(0)) worker_unpark();
     return 0;
 }
 
-int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count) {
+int demo_publisher_get_stats(int* out_queue_len, int* out_queue_max, uint64_t* out_drop_count, int* out_high_water) {
     if (out_queue_len) {
-        std::lock_guard<std::mutex> lk(g_queue_mutex);
-        *out_queue_len = (int)g_queue.size();
+        *out_queue_len = (int)(g_ring_tail.v.load(std::memory_order_acquire) - g_ring_head.v.load(std::memory_order_acquire));
     }
-    if (out_queue_max) *out_queue_max = (int)g_queue_max;
-    if (out_drop_count) *out_drop_count = g_queue_drop_count;
+    if (out_queue_max) *out_queue_max = (int)kRingSize;
+    if (out_drop_count) *out_drop_count = g_queue_drop_count.load(std::memory_order_relaxed);
+    if (out_high_water) *out_high_water = (int)g_queue_high_water.load(std::memory_order_relaxed);
     return 0;
 }
 
 #endif
+
+int demo_publisher_enqueue(int slot, DemoAppContext* ctx) {
+    PubTopic* t;
+    PubEvent e;
+    int token = 1;
+    if (slot < 0 || slot >= g_topic_count || !ctx) return -1;
+    t = &g_topics[slot];
+
+    e.sample = -1;
+    if (t->capture) {
+        // Snapshot now; the worker publishes this copy, not the live state
+        e.sample = sample_alloc();
+        if (e.sample < 0) {
+            t->stats.dropped++;
+            return -1;
+        }
+        t->capture(ctx, g_samples[e.sample].u.bytes);
+        token = e.sample + 1;
+    }
+
+    if (t->coalesce) {
+        int prev = PUB_XCHG(g_pending[slot], token);
+        if (prev != 0) {
+            // Already queued; the pending event now carries this sample and
+            // the one it replaced was never seen by the worker
+            if (t->capture) sample_free(prev - 1);
+            t->stats.coalesced++;
+            return 1;
+        }
+        e.sample = -1;  // the worker takes it from g_pending
+    }
+
+    e.slot = slot;
+    e.ctx = ctx;
+    e.enqueue_ns = pub_now_ns();
+    if (pub_queue_push(&e) != 0) {
+        if (t->coalesce) {
+            int prev = PUB_XCHG(g_pending[slot], 0);
+            if (t->capture && prev != 0) sample_free(prev - 1);
+        } else if (e.sample >= 0) {
+            sample_free(e.sample);
+        }
+        t->stats.dropped++;
+        return -1;
+    }
+    t->stats.queued++;
+    return 0;
+}
@@ -37,6 +37,32 @@ static void status_print(int to_tcp, const char* fmt, ...) {
     }
 }
 
+static void status_print_job(int to_tcp, const char* name, const DemoTimerJob* job, int periodic) {
+    char hist[160];
+    int hpos = 0;
+    int b;
+    if (job->runs == 0) return;
+    if (!periodic) {
+        status_print(to_tcp, "  %s: runs=%u, late max=%llu us\n", name, job->runs,
+                     (unsigned long long)(job->late_max_ns / 1000ULL));
+    } else {
+        double rate_hz = 0.0;
+        double target_hz = 0.0;
+        if (job->window_runs > 1 && job->last_run_ns > job->first_run_ns) {
+            rate_hz = (double)(job->window_runs - 1) * 1e9 / (double)(job->last_run_ns - job->first_run_ns);
+        }
+        if (job->period_ns) target_hz = 1e9 / (double)job->period_ns;
+        status_print(to_tcp, "  %s: runs=%u, rate=%.1f Hz (target %.1f Hz), overruns=%u, late max=%llu us\n",
+                     name, job->runs, rate_hz, target_hz, job->overruns,
+                     (unsigned long long)(job->late_max_ns / 1000ULL));
+    }
+    for (b = 0; b < DEMO_TIMER_JITTER_BUCKETS && hpos < (int)sizeof(hist); ++b) {
+        hpos += snprintf(hist + hpos, sizeof(hist) - hpos, " %s=%u",
+                         demo_timer_jitter_label(b), job->late_hist[b]);
+    }
+    status_print(to_tcp, "    late:%s\n", hist);
+}
+
 void demo_app_print_status(int to_tcp) {
     if (!g_demo_ctx) {
         status_print(to_tcp, "[DemoApp] Not running\n");
@@ -115,6 +141,39 @@ void demo_app_print_status(int to_tcp) {
     status_print(to_tcp, "  Control Received: %u (%u Hz)\n", g_demo_ctx->control_rx_count, g_demo_ctx->control_rx_hz);
     status_print(to_tcp, "  Speed Received: %u (%u Hz)\n", g_demo_ctx->speed_rx_count, g_demo_ctx->speed_rx_hz);
 
+    /* Timer jobs: achieved rate, overruns and lateness histogram */
+    status_print(to_tcp, "\nTimer Jobs (wakeups=%u):\n", g_demo_ctx->timer_wakeups);
+    {
+        uint32_t i;
+        for (i = 0; i < g_demo_ctx->publish_topic_count; ++i) {
+            status_print_job(to_tcp, g_demo_ctx->publish_topics[i].name, &g_demo_ctx->publish_topics[i].stats, 1);
+        }
+        for (i = 0; i < DEMO_TIMER_JOB_COUNT; ++i) {
+            status_print_job(to_tcp, demo_timer_job_name((int)i), &g_demo_ctx->timer_jobs[i], i != DEMO_TIMER_JOB_IBIT);
+        }
+    }
+
+    /* Publisher queue: per-topic coalescing and enqueue->write latency */
+    {
+        int qlen = 0, qmax = 0, qhigh = 0; uint64_t qdrop = 0;
+        int i, n = demo_publisher_topic_count();
+        if (demo_publisher_get_stats(&qlen, &qmax, &qdrop, &qhigh) == 0) {
+            status_print(to_tcp, "\nPublisher Queue:\n");
+            status_print(to_tcp, "  Queue length: %d / %d (high water %d)\n", qlen, qmax, qhigh);
+            status_print(to_tcp, "  Dropped events: %llu\n", (unsigned long long)qdrop);
+        }
+        for (i = 0; i < n; ++i) {
+            DemoPublisherTopicStats ts;
+            double lat_avg_ms = 0.0;
+            if (demo_publisher_get_topic_stats(i, &ts) != 0 || (ts.queued == 0 && ts.coalesced == 0)) continue;
+            if (ts.written) lat_avg_ms = (double)ts.latency_ns_total / (double)ts.written / 1000000.0;
+            status_print(to_tcp, "  %-10s queued=%llu coalesced=%llu dropped=%llu written=%llu latency avg=%.3f ms max=%.3f ms\n",
+                         ts.name, (unsigned long long)ts.queued, (unsigned long long)ts.coalesced,
+                         (unsigned long long)ts.dropped, (unsigned long long)ts.written,
+                         lat_avg_ms, (double)ts.latency_ns_max / 1000000.0);
+        }
+    }
+
 #ifdef DEMO_PERF_INSTRUMENTATION
     if (g_demo_ctx->pub_signal_count || g_demo_ctx->json_dump_count || g_demo_ctx->legacy_write_count) {
         long long sig_avg_ms = 0;
@@ -165,25 +224,28 @@ void demo_app_print_status(int to_tcp) {
                 status_print(to_tcp, "  IPC parse: count=%u, avg=%lld ms    %.1f Hz\n", ps.ipc_parse_count, parse_avg_ms, parse_hz);
                 status_print(to_tcp, "  IPC to_cbor: count=%u, avg=%lld ms    %.1f Hz\n", ps.ipc_cbor_count, cbor_avg_ms, cbor_hz);
                 status_print(to_tcp, "  Transport send: count=%u, avg=%lld ms    %.1f Hz\n", ps.transport_send_count, trans_avg_ms, trans_hz);
+            }
             long long write_avg_ms = 0;
             if (ps.write_count) write_avg_ms = (long long)(ps.write_ns_total / ps.write_count / 1000000ULL);
             status_print(to_tcp, "  Library write: count=%u, avg=%lld ms\n", ps.write_count, write_avg_ms);
+            {
+                double msgs_per_wakeup = 0.0;
+                if (ps.recv_wakeup_count) msgs_per_wakeup = (double)ps.recv_msg_count / (double)ps.recv_wakeup_count;
+                status_print(to_tcp, "  IPC recv: wakeups=%u, msgs=%u, msgs/wakeup=%.2f\n", ps.recv_wakeup_count, ps.recv_msg_count, msgs_per_wakeup);
+            }
+            if (ps.unmatched_reply_count) {
+                status_print(to_tcp, "  Unmatched replies dropped: %u\n", ps.unmatched_reply_count);
+            }
+            if (ps.send_batch_flush_count) {
+                status_print(to_tcp, "  Send batches: flushes=%u, frames=%u, frames/flush=%.2f\n", ps.send_batch_flush_count, ps.send_batch_frame_count,
+                             (double)ps.send_batch_frame_count / (double)ps.send_batch_flush_count);
+            }
             /* Publisher worker dequeue->write timing (app-side) */
             long long worker_write_avg_ms = 0;
             if (g_demo_ctx->pub_worker_write_count) worker_write_avg_ms = (long long)(g_demo_ctx->pub_worker_write_ns_total / g_demo_ctx->pub_worker_write_count / 1000000ULL);
             status_print(to_tcp, "  Pub worker write: count=%u, avg=%lld ms\n", g_demo_ctx->pub_worker_write_count, worker_write_avg_ms);
         }
     }
-
-    /* Publisher queue stats */
-    {
-        int qlen = 0, qmax = 0; uint64_t qdrop = 0;
-        if (demo_publisher_get_stats(&qlen, &qmax, &qdrop) == 0) {
-            status_print(to_tcp, "\nPublisher Queue:\n");
-            status_print(to_tcp, "  Queue length: %d / %d\n", qlen, qmax);
-            status_print(to_tcp, "  Dropped events: %llu\n", (unsigned long long)qdrop);
-        }
-    }
 #endif /* DEMO_PERF_INSTRUMENTATION */
 
     status_print(to_tcp, "\nBIT State:\n");
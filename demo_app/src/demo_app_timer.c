@@ -1,10 +1,23 @@
 /*
  * demo_app_timer.c - Periodic Timer and Scheduling
+ *
+ * Periodic publish topics (see demo_app_register_publish_topic) and the
+ * internal jobs (IBIT completion, Hz statistics) are timers on a
+ * hierarchical wheel with 1ms ticks. The timer task sleeps until the next
+ * expiry on an absolute deadline, or until demo_timer_kick() reports a
+ * state, period or topic change; its cost per wakeup does not depend on
+ * how many topics are registered.
+ *
+ * Expiries advance by whole periods from the previous expiry, so wakeup
+ * latency never accumulates into the rate. A job that runs a full period
+ * late runs once, counts the skipped periods as overruns and resumes on
+ * its original phase.
  */
 
 #include "../include/demo_app.h"
 #include "../include/demo_app_log.h"
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include "../include/demo_app_publisher.h"
 
@@ -12,6 +25,7 @@
 #include <vxWorks.h>
 #include <taskLib.h>
 #include <sysLib.h>
+#include <semLib.h>
 #include <wdLib.h>
 #include <tickLib.h>
 #else
@@ -24,9 +38,18 @@
 #else
 #include <pthread.h>
 #include <unistd.h>
+#include <errno.h>
 #endif
 #endif
 
+#define NS_PER_MS 1000000ULL
+
+// IBIT duration: 3 seconds
+#define DEMO_IBIT_DURATION_MS 3000ULL
+
+// Hz statistics window
+#define DEMO_STATS_PERIOD_MS 1000ULL
+
 /* ========================================================================
  * Global State
  * ======================================================================== */
@@ -34,71 +57,386 @@
 #ifdef _VXWORKS_
 static WDOG_ID g_timer_wdog = NULL;
 static TASK_ID g_timer_task = TASK_ID_ERROR;
+static SEM_ID g_timer_wake = NULL;
 static volatile int g_timer_running = 0;
 #else
 // Windows/Linux
 #ifdef _WIN32
 static HANDLE g_timer_thread = NULL;
+static HANDLE g_timer_wake = NULL;      // auto-reset event
 static volatile int g_timer_running = 0;
 #else
 static pthread_t g_timer_thread;
+static pthread_mutex_t g_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_timer_cond;     // CLOCK_MONOTONIC
+static int g_timer_cond_ready = 0;
+static int g_timer_kicked = 0;
 static volatile int g_timer_running = 0;
 #endif
 #endif
 
+static uint64_t g_timer_base_ns = 0;    // clock value at tick_count 0
+
+// Owned by the timer task
+static DemoWheel g_wheel;
+static DemoWheelTimer g_job_timers[DEMO_TIMER_JOB_COUNT];
+static uint64_t g_now_ns;               // clock at the current wakeup
+static int g_run_armed = 0;             // publish topics armed for Run state
+
 extern DemoAppContext* g_demo_ctx;
 
+static const char* const g_job_names[DEMO_TIMER_JOB_COUNT] = {
+    "IBIT done", "Stats"
+};
+
+// Upper bounds of the lateness buckets (last bucket is open)
+static const uint64_t g_jitter_limit_ns[DEMO_TIMER_JITTER_BUCKETS - 1] = {
+    50000ULL, 200000ULL, 1000000ULL, 2000000ULL, 5000000ULL
+};
+
+static const char* const g_jitter_labels[DEMO_TIMER_JITTER_BUCKETS] = {
+    "<50us", "<200us", "<1ms", "<2ms", "<5ms", ">=5ms"
+};
+
 /* ========================================================================
- * Timer Task (VxWorks)
+ * Clock
  * ======================================================================== */
 
+// Monotonic time in ns
+static uint64_t timer_now_ns(void) {
 #ifdef _VXWORKS_
-static void timerTask(void) {
-    int tick_rate = sysClkRateGet();  // System ticks per second
-    int delay_ticks = 0; // 1ms in ticks (computed below)
+    int rate = sysClkRateGet();
+    return (uint64_t)tick64Get() * (1000000000ULL / (rate > 0 ? rate : 1));
+#elif defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000000ULL +
+           (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000000ULL / (uint64_t)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
 
-    // Compute delay_ticks as ticks representing ~1ms. Use ceil to avoid 0.
-    if (tick_rate > 0) {
-        delay_ticks = (tick_rate + 999) / 1000; // ceil(tick_rate/1000)
-    }
-        if (delay_ticks < 1) {
-         delay_ticks = 1;
-         LOG_INFO("WARNING: System tick rate is %d Hz (<%d Hz required for 1ms)\n",
-               tick_rate, 1000);
-         LOG_INFO("Timer will run at %d ms interval instead\n",
-               1000 / (tick_rate > 0 ? tick_rate : 1));
-        }
-    
-        LOG_INFO("Timer task started\n");
-        LOG_INFO("  System tick rate: %d Hz\n", tick_rate);
-        LOG_INFO("  Delay ticks: %d (%.1f ms)\n", 
-              delay_ticks, (float)delay_ticks * 1000.0f / tick_rate);
-    
-    while (g_timer_running) {
-        if (g_demo_ctx) {
-#ifdef DEMO_PERF_INSTRUMENTATION
-            uint64_t t0 = 0;
+uint64_t demo_timer_now_ms(void) {
+    uint64_t now = timer_now_ns();
+    return (now > g_timer_base_ns) ? (now - g_timer_base_ns) / NS_PER_MS : 0;
+}
+
+// Sleep until an absolute time of timer_now_ns() (UINT64_MAX: no deadline)
+// or until kicked. Returns 1 if kicked.
+static int timer_wait_until(uint64_t due_ns) {
 #ifdef _VXWORKS_
-            t0 = (uint64_t)tickGet() * (1000000000ULL / (tick_rate > 0 ? tick_rate : 1));
+    int rate = sysClkRateGet();
+    uint64_t tick_ns = 1000000000ULL / (rate > 0 ? rate : 1);
+    uint64_t now = timer_now_ns();
+    int ticks = WAIT_FOREVER;
+    if (due_ns != UINT64_MAX) {
+        if (due_ns <= now) return semTake(g_timer_wake, NO_WAIT) == OK;
+        ticks = (int)((due_ns - now + tick_ns - 1) / tick_ns);
+    }
+    return semTake(g_timer_wake, ticks) == OK;
+#elif defined(_WIN32)
+    DWORD ms = INFINITE;
+    if (due_ns != UINT64_MAX) {
+        uint64_t now = timer_now_ns();
+        ms = (due_ns > now) ? (DWORD)((due_ns - now + NS_PER_MS - 1) / NS_PER_MS) : 0;
+    }
+    return WaitForSingleObject(g_timer_wake, ms) == WAIT_OBJECT_0;
 #else
-            struct timespec ts0; clock_gettime(CLOCK_MONOTONIC, &ts0); t0 = (uint64_t)ts0.tv_sec*1000000000ULL + ts0.tv_nsec;
+    struct timespec ts;
+    int kicked;
+    ts.tv_sec = (time_t)(due_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(due_ns % 1000000000ULL);
+    pthread_mutex_lock(&g_timer_lock);
+    while (!g_timer_kicked && g_timer_running) {
+        if (due_ns == UINT64_MAX) {
+            pthread_cond_wait(&g_timer_cond, &g_timer_lock);
+        } else if (pthread_cond_timedwait(&g_timer_cond, &g_timer_lock, &ts) == ETIMEDOUT) {
+            break;
+        }
+    }
+    kicked = g_timer_kicked;
+    g_timer_kicked = 0;
+    pthread_mutex_unlock(&g_timer_lock);
+    return kicked;
 #endif
-            demo_timer_tick(g_demo_ctx);
-            uint64_t t1 = 0;
+}
+
+void demo_timer_kick(void) {
 #ifdef _VXWORKS_
-            t1 = (uint64_t)tickGet() * (1000000000ULL / (tick_rate > 0 ? tick_rate : 1));
+    if (g_timer_wake) semGive(g_timer_wake);
+#elif defined(_WIN32)
+    if (g_timer_wake) SetEvent(g_timer_wake);
 #else
-            struct timespec ts1; clock_gettime(CLOCK_MONOTONIC, &ts1); t1 = (uint64_t)ts1.tv_sec*1000000000ULL + ts1.tv_nsec;
+    if (!g_timer_cond_ready) return;
+    pthread_mutex_lock(&g_timer_lock);
+    g_timer_kicked = 1;
+    pthread_cond_signal(&g_timer_cond);
+    pthread_mutex_unlock(&g_timer_lock);
 #endif
-            LOG_INFO("[TIMING] demo_timer_tick took %llu us (ticks=%d)\n", (unsigned long long)((t1 - t0) / 1000ULL), delay_ticks);
-#else
-            demo_timer_tick(g_demo_ctx);
+}
+
+/* ========================================================================
+ * Job Scheduling
+ * ======================================================================== */
+
+static uint64_t tick_to_ns(uint64_t tick) {
+    return g_timer_base_ns + tick * NS_PER_MS;
+}
+
+// Record a run of a job that was due at due_ns
+static void job_record_run(DemoTimerJob* job, uint64_t due_ns, uint64_t now) {
+    uint64_t late = (now > due_ns) ? now - due_ns : 0;
+    int b = 0;
+    while (b < DEMO_TIMER_JITTER_BUCKETS - 1 && late >= g_jitter_limit_ns[b]) b++;
+    job->late_hist[b]++;
+    if (late > job->late_max_ns) job->late_max_ns = late;
+    if (job->window_runs++ == 0) job->first_run_ns = now;
+    job->last_run_ns = now;
+    job->runs++;
+}
+
+// Start a job's rate window with a new period
+static void job_set_period(DemoTimerJob* job, uint64_t period_ms) {
+    job->period_ns = period_ms * NS_PER_MS;
+    job->window_runs = 0;
+}
+
+// Re-arm a periodic timer that expired at 'tick' one period later,
+// skipping (and counting) the periods already missed
+static void job_rearm(DemoWheelTimer* timer, DemoTimerJob* job, uint64_t tick, uint64_t period_ms) {
+    uint64_t next = tick + period_ms;
+    uint64_t now_tick = (g_now_ns - g_timer_base_ns) / NS_PER_MS;
+    if (next <= now_tick) {
+        uint64_t missed = (now_tick - next) / period_ms + 1;
+        job->overruns += (uint32_t)missed;
+        next += missed * period_ms;
+    }
+    demo_wheel_arm(&g_wheel, timer, next);
+}
+
+// Integrate the simulation in 1ms steps up to the current tick
+static void timer_advance_simulation(DemoAppContext* ctx) {
+    while (ctx->last_sim_tick < ctx->tick_count) {
+        demo_timer_update_simulation(ctx);
+        ctx->last_sim_tick++;
+    }
+}
+
+static void job_update_stats(DemoAppContext* ctx) {
+    ctx->signal_pub_hz = ctx->signal_pub_count - ctx->signal_pub_prev;
+    ctx->cbit_pub_hz = ctx->cbit_pub_count - ctx->cbit_pub_prev;
+    ctx->pbit_pub_hz = ctx->pbit_pub_count - ctx->pbit_pub_prev;
+    ctx->result_pub_hz = ctx->result_pub_count - ctx->result_pub_prev;
+    ctx->control_rx_hz = ctx->control_rx_count - ctx->control_rx_prev;
+    ctx->speed_rx_hz = ctx->speed_rx_count - ctx->speed_rx_prev;
+    ctx->runbit_rx_hz = ctx->runbit_rx_count - ctx->runbit_rx_prev;
+
+    ctx->signal_pub_prev = ctx->signal_pub_count;
+    ctx->cbit_pub_prev = ctx->cbit_pub_count;
+    ctx->pbit_pub_prev = ctx->pbit_pub_count;
+    ctx->result_pub_prev = ctx->result_pub_count;
+    ctx->control_rx_prev = ctx->control_rx_count;
+    ctx->speed_rx_prev = ctx->speed_rx_count;
+    ctx->runbit_rx_prev = ctx->runbit_rx_count;
+
+    ctx->stats_last_tick = ctx->tick_count;
+}
+
+// Signal snapshot, taken on the timer task when the topic is queued
+static void topic_capture_signal(DemoAppContext* ctx, void* sample) {
+    demo_msg_capture_actuator_signal(ctx, (DemoSignalSample*)sample);
+}
+
+// Topic publish functions run on the publisher worker
+static int topic_publish_signal(DemoAppContext* ctx, const void* sample) {
+#ifdef DEMO_PERF_INSTRUMENTATION
+    uint64_t t0 = timer_now_ns();
+#endif
+    int rc = demo_msg_publish_actuator_signal_sample(ctx, (const DemoSignalSample*)sample);
+#ifdef DEMO_PERF_INSTRUMENTATION
+    ctx->pub_signal_ns_total += timer_now_ns() - t0;
+    ctx->pub_signal_count++;
+#endif
+    return rc;
+}
+
+// resultBIT snapshot, taken on the timer task when IBIT completes
+static void topic_capture_result_bit(DemoAppContext* ctx, void* sample) {
+    demo_msg_capture_result_bit(ctx, (DemoResultBitSample*)sample);
+}
+
+static int topic_publish_result_bit(DemoAppContext* ctx, const void* sample) {
+    return demo_msg_publish_result_bit_sample(ctx, (const DemoResultBitSample*)sample);
+}
+
+static int topic_publish_cbit(DemoAppContext* ctx) {
+#ifdef DEMO_PERF_INSTRUMENTATION
+    uint64_t t0 = timer_now_ns();
 #endif
+    int rc = demo_msg_publish_cbit(ctx);
+#ifdef DEMO_PERF_INSTRUMENTATION
+    ctx->pub_cbit_ns_total += timer_now_ns() - t0;
+    ctx->pub_cbit_count++;
+#endif
+    return rc;
+}
+
+static int g_result_pub_slot = -1;      // one-shot resultBIT (not coalesced)
+
+void demo_timer_register_default_topics(DemoAppContext* ctx) {
+    // Signal is written from a snapshot taken when the timer queues it
+    demo_app_register_sampled_topic(ctx, "signal", 5, topic_capture_signal, topic_publish_signal,
+                                    sizeof(DemoSignalSample));   // 200Hz
+    demo_app_register_publish_topic(ctx, "cbit", 1000, topic_publish_cbit);    // 1Hz
+    demo_app_register_publish_topic(ctx, "pbit", 0, demo_msg_publish_pbit);    // only at start
+    g_result_pub_slot = demo_publisher_register_sampled("resultBIT", topic_capture_result_bit,
+                                                        topic_publish_result_bit,
+                                                        sizeof(DemoResultBitSample), 0);
+}
+
+static void on_topic_timer(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t tick) {
+    DemoPublishTopic* topic = (DemoPublishTopic*)timer->arg;
+    (void)wheel;
+    job_record_run(&topic->stats, tick_to_ns(tick), g_now_ns);
+    // Bring the simulation up to this tick before the sample is taken
+    timer_advance_simulation(g_demo_ctx);
+    if (demo_publisher_enqueue(topic->pub_slot, g_demo_ctx) < 0) {
+        demo_log(LOG_LEVEL_INFO, "[Timer] Publisher queue full, dropped %s event\n", topic->name);
+    }
+    job_rearm(timer, &topic->stats, tick, topic->armed_period_ms);
+}
+
+static void on_stats_timer(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t tick) {
+    DemoAppContext* ctx = g_demo_ctx;
+    DemoTimerJob* job = &ctx->timer_jobs[DEMO_TIMER_JOB_STATS];
+    (void)wheel;
+    job_record_run(job, tick_to_ns(tick), g_now_ns);
+    job_update_stats(ctx);
+    // Bound the simulation catch-up when Signal is slow or disabled
+    if (g_run_armed) timer_advance_simulation(ctx);
+    job_rearm(timer, job, tick, DEMO_STATS_PERIOD_MS);
+}
+
+static void on_ibit_timer(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t tick) {
+    DemoAppContext* ctx = g_demo_ctx;
+    (void)wheel;
+    (void)timer;
+    job_record_run(&ctx->timer_jobs[DEMO_TIMER_JOB_IBIT], tick_to_ns(tick), g_now_ns);
+
+    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] IBIT completed after %llu ms\n",
+             (unsigned long long)(ctx->tick_count - ctx->bit_state.ibit_start_time));
+
+    // Publish resultBIT; queued ahead of any Run-state sample that follows
+    if (demo_publisher_enqueue(g_result_pub_slot, ctx) < 0) {
+        demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Publisher queue full, dropped resultBIT\n");
+    }
+
+    // Clear IBIT state
+    ctx->bit_state.ibit_running = false;
+
+    // Transition back to Run state
+    enter_state(ctx, DEMO_STATE_RUN);
+
+    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Returned to Run state\n");
+}
+
+// Arm or disarm timers for the current state and topic periods (after a kick)
+static void timer_reconcile(DemoAppContext* ctx) {
+    uint64_t tick = ctx->tick_count;
+    int run = (ctx->current_state == DEMO_STATE_RUN);
+    DemoWheelTimer* ibit = &g_job_timers[DEMO_TIMER_JOB_IBIT];
+    uint32_t i;
+
+    // The simulation does not integrate time spent outside Run
+    if (run && !g_run_armed) ctx->last_sim_tick = tick;
+    g_run_armed = run;
+
+    for (i = 0; i < ctx->publish_topic_count; ++i) {
+        DemoPublishTopic* topic = &ctx->publish_topics[i];
+        uint32_t period = topic->period_ms;
+
+        if (topic->timer.fn == NULL) demo_wheel_timer_init(&topic->timer, on_topic_timer, topic);
+
+        if (!run || period == 0) {
+            demo_wheel_cancel(&g_wheel, &topic->timer);
+        } else if (!topic->timer.armed) {
+            // First period after (re)entering Run fires immediately
+            topic->armed_period_ms = period;
+            job_set_period(&topic->stats, period);
+            demo_wheel_arm(&g_wheel, &topic->timer, tick);
+        } else if (topic->armed_period_ms != period) {
+            // Keep the previous expiry as the phase reference
+            uint64_t prev = topic->timer.expires - topic->armed_period_ms;
+            topic->armed_period_ms = period;
+            job_set_period(&topic->stats, period);
+            demo_wheel_arm(&g_wheel, &topic->timer, prev + period);
         }
+    }
 
-        taskDelay(delay_ticks);
+    // One-shot IBIT completion from the IBIT start tick; no periodic
+    // publish during IBIT (not in Run)
+    if (ctx->current_state == DEMO_STATE_IBIT_RUNNING) {
+        if (!ibit->armed) {
+            demo_wheel_arm(&g_wheel, ibit, ctx->bit_state.ibit_start_time + DEMO_IBIT_DURATION_MS);
+        }
+    } else {
+        demo_wheel_cancel(&g_wheel, ibit);
     }
-    
+}
+
+/* ========================================================================
+ * Timer Loop (all platforms)
+ * ======================================================================== */
+
+static void timerLoop(void) {
+    int kicked = 1;
+
+    while (g_timer_running) {
+        uint64_t due = UINT64_MAX;
+        DemoAppContext* ctx = g_demo_ctx;
+
+        if (ctx) {
+#ifdef DEMO_PERF_INSTRUMENTATION
+            uint64_t t0 = timer_now_ns();
+#endif
+            if (kicked) {
+                g_now_ns = timer_now_ns();
+                ctx->tick_count = (g_now_ns - g_timer_base_ns) / NS_PER_MS;
+                timer_reconcile(ctx);
+            }
+            demo_timer_tick(ctx);
+
+            uint64_t next = demo_wheel_next(&g_wheel);
+            if (next != DEMO_WHEEL_NEVER) due = tick_to_ns(next);
+#ifdef DEMO_PERF_INSTRUMENTATION
+            ctx->timer_tick_ns_total += timer_now_ns() - t0;
+            ctx->timer_tick_ns_count++;
+#endif
+            ctx->timer_wakeups++;
+        }
+
+        kicked = timer_wait_until(due);
+    }
+}
+
+#ifdef _VXWORKS_
+static void timerTask(void) {
+    int tick_rate = sysClkRateGet();  // System ticks per second
+
+    LOG_INFO("Timer task started\n");
+    LOG_INFO("  System tick rate: %d Hz (deadline resolution %.1f ms)\n",
+             tick_rate, 1000.0f / (float)(tick_rate > 0 ? tick_rate : 1));
+    if (tick_rate < 1000) {
+        LOG_INFO("WARNING: System tick rate is %d Hz (<%d Hz required for 1ms)\n",
+                 tick_rate, 1000);
+    }
+
+    timerLoop();
+
     demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer task exiting\n");
 }
 #else
@@ -106,38 +444,17 @@ static void timerTask(void) {
 #ifdef _WIN32
 static unsigned int __stdcall timerThreadFunc(void* arg) {
     (void)arg;
-    
+
     // Set Windows timer resolution to 1ms
     TIMECAPS tc;
     timeGetDevCaps(&tc, sizeof(TIMECAPS));
     UINT wTimerRes = min(max(tc.wPeriodMin, 1), tc.wPeriodMax);
     timeBeginPeriod(wTimerRes);
-    
-    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread started (1ms interval, resolution=%ums)\n", wTimerRes);
-    
-    LARGE_INTEGER freq, start, now;
-    QueryPerformanceFrequency(&freq);
-    QueryPerformanceCounter(&start);
-    
-    uint64_t tick = 0;
-    
-    while (g_timer_running) {
-        // Calculate elapsed time in ms
-        QueryPerformanceCounter(&now);
-        uint64_t elapsed_ms = ((now.QuadPart - start.QuadPart) * 1000) / freq.QuadPart;
-        
-        // Process all ticks that should have happened
-        while (tick < elapsed_ms && g_timer_running) {
-            if (g_demo_ctx) {
-                demo_timer_tick(g_demo_ctx);
-            }
-            tick++;
-        }
-        
-        // Sleep for remaining time (at least 1ms)
-        Sleep(1);
-    }
-    
+
+    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread started (timer wheel, resolution=%ums)\n", wTimerRes);
+
+    timerLoop();
+
     timeEndPeriod(wTimerRes);
     demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread exiting\n");
     return 0;
@@ -145,15 +462,10 @@ static unsigned int __stdcall timerThreadFunc(void* arg) {
 #else
 static void* timerThreadFunc(void* arg) {
     (void)arg;
-    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread started (1ms interval)\n");
-    
-    while (g_timer_running) {
-        if (g_demo_ctx) {
-            demo_timer_tick(g_demo_ctx);
-        }
-        usleep(1000);  // 1ms = 1000us
-    }
-    
+    demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread started (timer wheel)\n");
+
+    timerLoop();
+
     demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Timer thread exiting\n");
     return NULL;
 }
@@ -169,12 +481,29 @@ int demo_timer_init(DemoAppContext* ctx) {
     
     demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Initializing timer subsystem...\n");
     
+    g_timer_base_ns = timer_now_ns();
     ctx->tick_count = 0;
-    ctx->last_200hz_tick = 0;
-    ctx->last_1hz_tick = 0;
+    ctx->last_sim_tick = 0;
+    ctx->stats_last_tick = 0;
+    ctx->timer_wakeups = 0;
+    memset(ctx->timer_jobs, 0, sizeof(ctx->timer_jobs));
+
+    // Fresh wheel at tick 0; topics are armed by the first reconcile
+    demo_wheel_init(&g_wheel, 0);
+    g_run_armed = 0;
+    for (uint32_t i = 0; i < ctx->publish_topic_count; ++i) {
+        DemoPublishTopic* topic = &ctx->publish_topics[i];
+        demo_wheel_timer_init(&topic->timer, on_topic_timer, topic);
+        memset(&topic->stats, 0, sizeof(topic->stats));
+    }
+    demo_wheel_timer_init(&g_job_timers[DEMO_TIMER_JOB_IBIT], on_ibit_timer, NULL);
+    demo_wheel_timer_init(&g_job_timers[DEMO_TIMER_JOB_STATS], on_stats_timer, NULL);
+    job_set_period(&ctx->timer_jobs[DEMO_TIMER_JOB_STATS], DEMO_STATS_PERIOD_MS);
+    demo_wheel_arm(&g_wheel, &g_job_timers[DEMO_TIMER_JOB_STATS], DEMO_STATS_PERIOD_MS);
     
 #ifdef _VXWORKS_
     // Start timer task
+    g_timer_wake = semBCreate(SEM_Q_PRIORITY, SEM_EMPTY);
     g_timer_running = 1;
     
     g_timer_task = taskSpawn(
@@ -189,6 +518,8 @@ int demo_timer_init(DemoAppContext* ctx) {
     if (g_timer_task == TASK_ID_ERROR) {
         demo_log(LOG_LEVEL_ERROR, "[DemoApp Timer] ERROR: Failed to spawn timer task\n");
         g_timer_running = 0;
+        semDelete(g_timer_wake);
+        g_timer_wake = NULL;
         return -1;
     }
     
@@ -198,14 +529,26 @@ int demo_timer_init(DemoAppContext* ctx) {
     g_timer_running = 1;
     
 #ifdef _WIN32
+    g_timer_wake = CreateEvent(NULL, FALSE, FALSE, NULL);
     g_timer_thread = (HANDLE)_beginthreadex(NULL, 0, timerThreadFunc, NULL, 0, NULL);
     if (g_timer_thread == NULL) {
         LOG_ERROR("Failed to create timer thread\n");
         g_timer_running = 0;
+        CloseHandle(g_timer_wake);
+        g_timer_wake = NULL;
         return -1;
     }
     LOG_INFO("Timer thread created\n");
 #else
+    if (!g_timer_cond_ready) {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&g_timer_cond, &attr);
+        pthread_condattr_destroy(&attr);
+        g_timer_cond_ready = 1;
+    }
+    g_timer_kicked = 0;
     if (pthread_create(&g_timer_thread, NULL, timerThreadFunc, NULL) != 0) {
         LOG_ERROR("Failed to create timer thread\n");
         g_timer_running = 0;
@@ -227,6 +570,7 @@ void demo_timer_cleanup(DemoAppContext* ctx) {
     LOG_INFO("Cleaning up timer subsystem...\n");
     
     g_timer_running = 0;
+    demo_timer_kick();
     
 #ifdef _VXWORKS_
     if (g_timer_task != TASK_ID_ERROR) {
@@ -242,6 +586,11 @@ void demo_timer_cleanup(DemoAppContext* ctx) {
         wdDelete(g_timer_wdog);
         g_timer_wdog = NULL;
     }
+
+    if (g_timer_wake) {
+        semDelete(g_timer_wake);
+        g_timer_wake = NULL;
+    }
 #else
     // Windows/Linux
 #ifdef _WIN32
@@ -250,6 +599,10 @@ void demo_timer_cleanup(DemoAppContext* ctx) {
         CloseHandle(g_timer_thread);
         g_timer_thread = NULL;
     }
+    if (g_timer_wake) {
+        CloseHandle(g_timer_wake);
+        g_timer_wake = NULL;
+    }
 #else
     pthread_join(g_timer_thread, NULL);
 #endif
@@ -268,146 +621,29 @@ int demo_timer_is_running(void) {
     return g_timer_running;
 }
 
+const char* demo_timer_job_name(int job) {
+    if (job < 0 || job >= DEMO_TIMER_JOB_COUNT) return "?";
+    return g_job_names[job];
+}
+
+const char* demo_timer_jitter_label(int bucket) {
+    if (bucket < 0 || bucket >= DEMO_TIMER_JITTER_BUCKETS) return "?";
+    return g_jitter_labels[bucket];
+}
+
 /* ========================================================================
- * Tick Handler (Called every 1ms)
+ * Tick Handler
  * ======================================================================== */
 
 void demo_timer_tick(DemoAppContext* ctx) {
     if (!ctx) return;
-    
-    ctx->tick_count++;
-    
-    // Update Hz statistics every 1 second (1000ms)
-    if ((ctx->tick_count - ctx->stats_last_tick) >= 1000) {
-        ctx->signal_pub_hz = ctx->signal_pub_count - ctx->signal_pub_prev;
-        ctx->cbit_pub_hz = ctx->cbit_pub_count - ctx->cbit_pub_prev;
-        ctx->pbit_pub_hz = ctx->pbit_pub_count - ctx->pbit_pub_prev;
-        ctx->result_pub_hz = ctx->result_pub_count - ctx->result_pub_prev;
-        ctx->control_rx_hz = ctx->control_rx_count - ctx->control_rx_prev;
-        ctx->speed_rx_hz = ctx->speed_rx_count - ctx->speed_rx_prev;
-        ctx->runbit_rx_hz = ctx->runbit_rx_count - ctx->runbit_rx_prev;
-        
-        ctx->signal_pub_prev = ctx->signal_pub_count;
-        ctx->cbit_pub_prev = ctx->cbit_pub_count;
-        ctx->pbit_pub_prev = ctx->pbit_pub_count;
-        ctx->result_pub_prev = ctx->result_pub_count;
-        ctx->control_rx_prev = ctx->control_rx_count;
-        ctx->speed_rx_prev = ctx->speed_rx_count;
-        ctx->runbit_rx_prev = ctx->runbit_rx_count;
-        
-        ctx->stats_last_tick = ctx->tick_count;
-    }
-    
-    // Handle IBIT execution (IBitRunning state)
-    if (ctx->current_state == DEMO_STATE_IBIT_RUNNING) {
-        uint64_t elapsed = ctx->tick_count - ctx->bit_state.ibit_start_time;
-        
-        // IBIT duration: 3 seconds (3000ms)
-        if (elapsed >= 3000) {
-            demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] IBIT completed after %llu ms\n", elapsed);
-            
-            // Publish resultBIT
-            demo_msg_publish_result_bit(ctx);
-            
-            // Clear IBIT state
-            ctx->bit_state.ibit_running = false;
-            
-            // Transition back to Run state
-            extern void enter_state(DemoAppContext* ctx, DemoState new_state);
-            enter_state(ctx, DEMO_STATE_RUN);
-            
-            demo_log(LOG_LEVEL_INFO, "[DemoApp Timer] Returned to Run state\n");
-        }
-        
-        return;  // Don't publish periodic messages during IBIT
-    }
-    
-    // Only process in Run state
-    if (ctx->current_state != DEMO_STATE_RUN) {
-        return;
-    }
-    
-    // Update simulation (position/velocity)
-    demo_timer_update_simulation(ctx);
-    
-    // Signal processing (configurable period)
-    if (ctx->signal_period_ms > 0) {
-        if ((ctx->tick_count - ctx->last_200hz_tick) >= ctx->signal_period_ms) {
-            /* Measure publish duration if instrumentation enabled */
-#ifdef DEMO_PERF_INSTRUMENTATION
-            uint64_t t0 = 0, t1 = 0;
-            /* now_ns: VxWorks use tickGet conversion, otherwise clock_gettime */
-#if defined(_VXWORKS_)
-            {
-                unsigned long tk = tickGet();
-                int tr = sysClkRateGet();
-                t0 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-            }
-#else
-            struct timespec ts0; clock_gettime(CLOCK_MONOTONIC, &ts0); t0 = (uint64_t)ts0.tv_sec*1000000000ULL + ts0.tv_nsec;
-#endif
-            // Enqueue publish to publisher task to avoid blocking timer
-            if (demo_publisher_enqueue_signal(ctx) != 0) {
-                // If enqueue failed (queue full), optionally drop and log
-                demo_log(LOG_LEVEL_INFO, "[Timer] Publisher queue full, dropped signal event\n");
-            }
-#if defined(_VXWORKS_)
-            {
-                unsigned long tk = tickGet();
-                int tr = sysClkRateGet();
-                t1 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-            }
-#else
-            struct timespec ts1; clock_gettime(CLOCK_MONOTONIC, &ts1); t1 = (uint64_t)ts1.tv_sec*1000000000ULL + ts1.tv_nsec;
-#endif
-            ctx->pub_signal_ns_total += (t1 > t0) ? (t1 - t0) : 0ULL;
-            ctx->pub_signal_count++;
-#else
-            if (demo_publisher_enqueue_signal(ctx) != 0) {
-                demo_log(LOG_LEVEL_INFO, "[Timer] Publisher queue full, dropped signal event\n");
-            }
-#endif
-            ctx->last_200hz_tick = ctx->tick_count;
-        }
-    }
-
-    // CBIT processing (configurable period)
-    if (ctx->cbit_period_ms > 0) {
-        if ((ctx->tick_count - ctx->last_1hz_tick) >= ctx->cbit_period_ms) {
-            /* Measure CBIT publish duration */
-#ifdef DEMO_PERF_INSTRUMENTATION
-            uint64_t t0 = 0, t1 = 0;
-#if defined(_VXWORKS_)
-            {
-                unsigned long tk = tickGet();
-                int tr = sysClkRateGet();
-                t0 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-            }
-#else
-            struct timespec ts0; clock_gettime(CLOCK_MONOTONIC, &ts0); t0 = (uint64_t)ts0.tv_sec*1000000000ULL + ts0.tv_nsec;
-#endif
-            demo_msg_publish_cbit(ctx);
-#if defined(_VXWORKS_)
-            {
-                unsigned long tk = tickGet();
-                int tr = sysClkRateGet();
-                t1 = (uint64_t)tk * (1000000000ULL / (tr > 0 ? tr : 1));
-            }
-#else
-            struct timespec ts1; clock_gettime(CLOCK_MONOTONIC, &ts1); t1 = (uint64_t)ts1.tv_sec*1000000000ULL + ts1.tv_nsec;
-#endif
-            ctx->pub_cbit_ns_total += (t1 > t0) ? (t1 - t0) : 0ULL;
-            ctx->pub_cbit_count++;
-#else
-            demo_msg_publish_cbit(ctx);
-#endif
-            ctx->last_1hz_tick = ctx->tick_count;
-        }
-    }
+    g_now_ns = timer_now_ns();
+    ctx->tick_count = (g_now_ns - g_timer_base_ns) / NS_PER_MS;
+    demo_wheel_advance(&g_wheel, ctx->tick_count);
 }
 
 /* ========================================================================
- * Simulation Update (Called every 1ms)
+ * Simulation Update (one 1ms step, integrated by the Signal topic)
  * ======================================================================== */
 
 void demo_timer_update_simulation(DemoAppContext* ctx) {
@@ -0,0 +1,130 @@
+/*
+ * demo_app_wheel.c - Hierarchical timer wheel
+ *
+ * Invariant: a timer at level L expires in a level-L block (expires >>
+ * (BITS*L)) after the wheel's current block and at most SLOTS blocks
+ * ahead, so each slot maps to exactly one upcoming block. The wheel
+ * cascades a slot when it enters that block and skips ticks in which no
+ * slot has work.
+ */
+
+#include "../include/demo_app_wheel.h"
+#include <string.h>
+
+#define SLOT_MASK ((uint64_t)(DEMO_WHEEL_SLOTS - 1))
+#define LEVEL_SHIFT(level) (DEMO_WHEEL_SLOT_BITS * (level))
+
+// Index of the lowest set bit (bits != 0)
+static int lowest_bit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int n = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static void wheel_link(DemoWheel* wheel, DemoWheelTimer* timer) {
+    uint64_t delta = timer->expires - wheel->now;
+    int level = 0;
+    while (level < DEMO_WHEEL_LEVELS - 1 && delta >= (1ULL << LEVEL_SHIFT(level + 1))) {
+        level++;
+    }
+    int slot = (int)((timer->expires >> LEVEL_SHIFT(level)) & SLOT_MASK);
+
+    timer->level = (uint8_t)level;
+    timer->slot = (uint8_t)slot;
+    timer->prev = NULL;
+    timer->next = wheel->slots[level][slot];
+    if (timer->next) timer->next->prev = timer;
+    wheel->slots[level][slot] = timer;
+    wheel->occupied[level] |= 1ULL << slot;
+}
+
+static void wheel_unlink(DemoWheel* wheel, DemoWheelTimer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        wheel->slots[timer->level][timer->slot] = timer->next;
+        if (!timer->next) wheel->occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+    if (timer->next) timer->next->prev = timer->prev;
+    timer->next = timer->prev = NULL;
+}
+
+void demo_wheel_init(DemoWheel* wheel, uint64_t now) {
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->now = now;
+}
+
+void demo_wheel_timer_init(DemoWheelTimer* timer, DemoWheelFn fn, void* arg) {
+    memset(timer, 0, sizeof(*timer));
+    timer->fn = fn;
+    timer->arg = arg;
+}
+
+void demo_wheel_arm(DemoWheel* wheel, DemoWheelTimer* timer, uint64_t expires) {
+    if (timer->armed) wheel_unlink(wheel, timer);
+    if (expires <= wheel->now) expires = wheel->now + 1;
+    if (expires - wheel->now > DEMO_WHEEL_MAX_DELAY) expires = wheel->now + DEMO_WHEEL_MAX_DELAY;
+    timer->expires = expires;
+    timer->armed = 1;
+    wheel_link(wheel, timer);
+}
+
+void demo_wheel_cancel(DemoWheel* wheel, DemoWheelTimer* timer) {
+    if (!timer->armed) return;
+    wheel_unlink(wheel, timer);
+    timer->armed = 0;
+}
+
+uint64_t demo_wheel_next(const DemoWheel* wheel) {
+    uint64_t next = DEMO_WHEEL_NEVER;
+    for (int level = 0; level < DEMO_WHEEL_LEVELS; ++level) {
+        uint64_t bits = wheel->occupied[level];
+        if (!bits) continue;
+        // First occupied slot from the block after the current one
+        uint64_t block = wheel->now >> LEVEL_SHIFT(level);
+        int start = (int)((block + 1) & SLOT_MASK);
+        uint64_t rotated = start ? ((bits >> start) | (bits << (DEMO_WHEEL_SLOTS - start))) : bits;
+        uint64_t tick = (block + 1 + (uint64_t)lowest_bit(rotated)) << LEVEL_SHIFT(level);
+        if (tick < next) next = tick;
+    }
+    return next;
+}
+
+void demo_wheel_advance(DemoWheel* wheel, uint64_t now) {
+    while (wheel->now < now) {
+        uint64_t tick = demo_wheel_next(wheel);
+        if (tick > now) {
+            wheel->now = now;
+            break;
+        }
+        wheel->now = tick;
+
+        // Cascade every level whose block starts at this tick, top down
+        for (int level = DEMO_WHEEL_LEVELS - 1; level > 0; --level) {
+            if (tick & ((1ULL << LEVEL_SHIFT(level)) - 1)) continue;
+            int slot = (int)((tick >> LEVEL_SHIFT(level)) & SLOT_MASK);
+            DemoWheelTimer* timer;
+            while ((timer = wheel->slots[level][slot]) != NULL) {
+                wheel_unlink(wheel, timer);
+                wheel_link(wheel, timer);
+            }
+        }
+
+        // Expire this tick's slot one timer at a time: callbacks may cancel
+        // other timers of the same slot
+        int slot = (int)(tick & SLOT_MASK);
+        DemoWheelTimer* timer;
+        while ((timer = wheel->slots[0][slot]) != NULL) {
+            wheel_unlink(wheel, timer);
+            timer->armed = 0;
+            timer->fn(wheel, timer, tick);
+        }
+    }
+}
@@ -24,7 +24,8 @@ typedef enum {
     LEGACY_ERR_TRANSPORT,
     LEGACY_ERR_TIMEOUT,
     LEGACY_ERR_PROTO,
-    LEGACY_ERR_CLOSED
+    LEGACY_ERR_CLOSED,
+    LEGACY_ERR_BUSY        // too many requests in flight (pending table full)
 } LegacyStatus;
 
 typedef void (*LegacyLogCb)(int level, const char* msg, void* user);
@@ -41,6 +42,17 @@ typedef struct {
 
     LegacyLogCb log_cb;
     void*       log_user;
+
+    /* Dispatch stage. With dispatch_workers > 0 the receive task only decodes
+     * and queues events; subscription callbacks run on that many worker tasks
+     * (tIpcDisp0..), sharded by topic so each topic keeps its arrival order.
+     * Replies and timeouts stay on the receive task. 0 = callbacks run on the
+     * receive task (default).
+     */
+    uint32_t    dispatch_workers;       // max LEGACY_DISPATCH_MAX_WORKERS
+    uint32_t    dispatch_queue_depth;   // events queued per worker (0 = 256); full queue drops
+    uint32_t    dispatch_task_priority; // VxWorks (0 = 110)
+    uint32_t    dispatch_task_stack;    // VxWorks (0 = 32768)
 } LegacyConfig;
 
 LegacyStatus legacy_agent_init(const LegacyConfig* cfg, LEGACY_HANDLE* outHandle);
@@ -53,14 +65,19 @@ void legacy_agent_get_log_callback(LegacyLogCb* out_cb, void** out_user);
 
 /* --- Performance Instrumentation Exposure --- */
 typedef struct {
-    uint64_t ipc_parse_ns_total;    // total time spent parsing JSON -> ns
+    uint64_t ipc_parse_ns_total;    // total time spent re-parsing JSON text -> ns (0 on DOM path)
     uint32_t ipc_parse_count;
     uint64_t ipc_cbor_ns_total;     // total time spent json::to_cbor -> ns
     uint32_t ipc_cbor_count;
     uint64_t transport_send_us_total; // total transport send time (microseconds)
-    uint32_t transport_send_count;
+    uint32_t transport_send_count;    // send syscalls (one sendmmsg per batch flush)
     uint64_t write_ns_total;        // total time spent in writeJson() (nanoseconds)
     uint32_t write_count;
+    uint32_t recv_wakeup_count;     // receive wakeups that returned at least one frame
+    uint32_t recv_msg_count;        // frames received (recv_msg_count / recv_wakeup_count = msgs per wakeup)
+    uint32_t send_batch_flush_count; // send batches flushed (legacy_agent_set_send_batching)
+    uint32_t send_batch_frame_count; // frames sent through those batches
+    uint32_t unmatched_reply_count;  // replies matching no pending request, dropped (always counted)
 } LegacyPerfStats;
 
 /* Query library-side accumulated perf counters. Returns LEGACY_OK if handle valid.
@@ -68,6 +85,24 @@ typedef struct {
  */
 LegacyStatus legacy_agent_get_perf_stats(LEGACY_HANDLE h, LegacyPerfStats* out_stats);
 
+/* Dispatch stage counters (always collected; all zero without workers) */
+#define LEGACY_DISPATCH_MAX_WORKERS 8
+
+typedef struct {
+    uint32_t workers;
+    uint32_t queue_capacity;                                // per worker
+    uint32_t queue_depth[LEGACY_DISPATCH_MAX_WORKERS];      // queued now (including the one running)
+    uint32_t queue_high_water[LEGACY_DISPATCH_MAX_WORKERS];
+    uint64_t dropped[LEGACY_DISPATCH_MAX_WORKERS];          // events dropped on a full queue
+    uint64_t enqueued_total;
+    uint64_t dropped_total;
+    uint64_t dispatched_total;
+    uint64_t latency_ns_total;      // queued -> callbacks started, summed over dispatched events
+    uint64_t latency_ns_max;
+} LegacyDispatchStats;
+
+LegacyStatus legacy_agent_get_dispatch_stats(LEGACY_HANDLE h, LegacyDispatchStats* out_stats);
+
 /* --- Common Response Structures --- */
 
 typedef uint32_t LegacyRequestId;
@@ -77,7 +112,8 @@ typedef struct {
     int         err;      // Response JSON 'err' (0 if missing)
     const char* msg;      // Response JSON 'msg' (NULL if missing)
 
-    const char* raw_json; // Full response JSON (optional, for debug)
+    const char* raw_json; // Always "": use legacy_result_raw_json() (serialized on demand)
+    const void* priv;     // Library internal (source of raw JSON); do not use
 } LegacySimpleResult;
 
 typedef void (*LegacySimpleCb)(LEGACY_HANDLE h,
@@ -85,6 +121,12 @@ typedef void (*LegacySimpleCb)(LEGACY_HANDLE h,
                                const LegacySimpleResult* res,
                                void* user);
 
+/* Full response JSON of the result being delivered (for debug). The text is
+ * produced on first call and cached for the rest of the callback; only valid
+ * inside the callback. NULL for timeouts and other locally generated results.
+ */
+const char* legacy_result_raw_json(const LegacySimpleResult* res);
+
 /* --- Control Plane API --- */
 
 // Hello
@@ -181,6 +223,122 @@ LegacyStatus legacy_agent_clear_dds_entities(
     LegacySimpleCb cb,
     void* user);
 
+/* --- Blocking Control Plane API ---
+ * Same requests as above, but the caller blocks until the matching reply
+ * arrives or timeout_ms (0 = 5000) expires, on a pooled per-call wait object.
+ * Returns LEGACY_OK when the agent replied ok, LEGACY_ERR_PROTO when it replied
+ * with ok=false (details in out_res), LEGACY_ERR_TIMEOUT when no reply came.
+ * out_res / out_proto are optional.
+ * Must not be called from a library callback (the receive task completes the
+ * wait): such calls return LEGACY_ERR_PARAM.
+ */
+typedef struct {
+    bool ok;        // Response 'ok'
+    int  err;       // Response 'err' (LEGACY_ERR_TIMEOUT on timeout)
+    char msg[128];  // Response 'msg', truncated ("timeout" on timeout)
+} LegacySyncResult;
+
+LegacyStatus legacy_agent_hello_sync(
+    LEGACY_HANDLE h,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res,
+    int* out_proto);
+
+LegacyStatus legacy_agent_create_participant_sync(
+    LEGACY_HANDLE h,
+    const LegacyParticipantConfig* cfg,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+LegacyStatus legacy_agent_create_publisher_sync(
+    LEGACY_HANDLE h,
+    const LegacyPublisherConfig* cfg,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+LegacyStatus legacy_agent_create_subscriber_sync(
+    LEGACY_HANDLE h,
+    const LegacySubscriberConfig* cfg,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+LegacyStatus legacy_agent_create_writer_sync(
+    LEGACY_HANDLE h,
+    const LegacyWriterConfig* cfg,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+LegacyStatus legacy_agent_create_reader_sync(
+    LEGACY_HANDLE h,
+    const LegacyReaderConfig* cfg,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+LegacyStatus legacy_agent_clear_dds_entities_sync(
+    LEGACY_HANDLE h,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_res);
+
+/* --- Bulk Entity Creation ---
+ * Creates many entities with one pipelined burst: every create request is
+ * registered and queued first, then all frames leave together (one sendmmsg on
+ * Linux). Requests keep their order, so a participant/publisher listed before
+ * the writers that use it is created first by the agent.
+ * Each entity still gets its own reply and timeout; 'cb' runs once when every
+ * entity has a result (results[i] matches descs[i]), normally on the receive
+ * task, or on the calling task if all replies arrived before the call returned.
+ * If no request could be sent the call fails and 'cb' is not called; entities
+ * that could not be queued report ok=false with err set to the LegacyStatus.
+ */
+typedef enum {
+    LEGACY_ENTITY_PARTICIPANT = 0,
+    LEGACY_ENTITY_PUBLISHER,
+    LEGACY_ENTITY_SUBSCRIBER,
+    LEGACY_ENTITY_WRITER,
+    LEGACY_ENTITY_READER
+} LegacyEntityKind;
+
+typedef struct {
+    LegacyEntityKind kind;
+    int         domain;
+    const char* name;   // publisher/subscriber: its name; writer: publisher; reader: subscriber
+    const char* topic;  // writer/reader only
+    const char* type;   // writer/reader only
+    const char* qos;
+} LegacyEntityDesc;
+
+typedef struct {
+    LegacyRequestId reqId;  // 0 if the request was never sent
+    bool        ok;
+    int         err;
+    const char* msg;        // valid during the callback only
+} LegacyEntityResult;
+
+typedef void (*LegacyBulkCb)(
+    LEGACY_HANDLE h,
+    const LegacyEntityResult* results,
+    size_t count,
+    void* user);
+
+LegacyStatus legacy_agent_create_entities(
+    LEGACY_HANDLE h,
+    const LegacyEntityDesc* descs,
+    size_t count,
+    uint32_t timeout_ms,
+    LegacyBulkCb cb,
+    void* user);
+
+/* Blocking variant. out_results (optional) receives 'count' entries.
+ * Returns LEGACY_OK when every entity was created, LEGACY_ERR_TIMEOUT when
+ * at least one got no reply, LEGACY_ERR_PROTO when the agent refused one.
+ */
+LegacyStatus legacy_agent_create_entities_sync(
+    LEGACY_HANDLE h,
+    const LegacyEntityDesc* descs,
+    size_t count,
+    uint32_t timeout_ms,
+    LegacySyncResult* out_results);
+
 /* --- QoS API --- */
 
 typedef struct {
@@ -229,6 +387,23 @@ LegacyStatus legacy_agent_set_qos_profile(
     LegacyQosSetCb cb,
     void* user);
 
+/* --- Topic Handles ---
+ * A topic/type pair is interned into a small integer handle the first time it
+ * is used (subscribe, type adapter registration, writer/reader creation, or
+ * legacy_agent_topic_handle). Handles stay valid until legacy_agent_close()
+ * and index the library's per-topic tables directly: the *_by_handle calls
+ * skip the name lookup done by their string-keyed counterparts.
+ * At most 512 pairs per LEGACY_HANDLE (LEGACY_ERR_BUSY beyond that).
+ */
+typedef uint32_t LegacyTopicHandle;
+#define LEGACY_TOPIC_INVALID 0
+
+LegacyStatus legacy_agent_topic_handle(
+    LEGACY_HANDLE h,
+    const char* topic,
+    const char* type,
+    LegacyTopicHandle* out_handle);
+
 /* --- Data Plane API (Write) --- */
 
 typedef struct {
@@ -254,6 +429,20 @@ LegacyStatus legacy_agent_write_json(
     LegacyWriteCb cb,
     void* user);
 
+/* Fire-and-forget write for periodic data. The request carries "ack":false in
+ * args so the agent does not reply, and no pending entry is registered (no
+ * callback, no timeout). A reply sent anyway by an agent that does not know
+ * "ack" matches no pending request (its corr_id is never registered).
+ */
+LegacyStatus legacy_agent_write_json_noack(
+    LEGACY_HANDLE h,
+    const LegacyWriteJsonOptions* opt);
+
+/* Write through the type adapter of topic/type_name. With a per-type codec
+ * or a descriptor (LegacyTypeAdapter::encode_cbor / desc) the struct is
+ * encoded straight to CBOR, every described field in descriptor order, enums
+ * by enumerator name; otherwise the adapter's encode() JSON text is sent.
+ */
 LegacyStatus legacy_agent_write_struct(
     LEGACY_HANDLE h,
     const char* topic,
@@ -263,13 +452,95 @@ LegacyStatus legacy_agent_write_struct(
     LegacyWriteCb cb,
     void* user);
 
+/* Writes by topic handle: same requests as write_json / write_json_noack /
+ * write_struct with domain 0 and no publisher/qos.
+ */
+LegacyStatus legacy_agent_write_json_by_handle(
+    LEGACY_HANDLE h,
+    LegacyTopicHandle topic,
+    const char* data_json,
+    uint32_t timeout_ms,
+    LegacyWriteCb cb,
+    void* user);
+
+LegacyStatus legacy_agent_write_json_noack_by_handle(
+    LEGACY_HANDLE h,
+    LegacyTopicHandle topic,
+    const char* data_json);
+
+LegacyStatus legacy_agent_write_struct_by_handle(
+    LEGACY_HANDLE h,
+    LegacyTopicHandle topic,
+    const void* user_struct,
+    uint32_t timeout_ms,
+    LegacyWriteCb cb,
+    void* user);
+
+/* Writer handles for repeated writes to one topic. open_writer encodes the
+ * constant part of the write request (args, op, target) once from opt
+ * (topic required; type, domain, publisher, qos as for write_json;
+ * data_json ignored). Each writer_write then only encodes the data. The
+ * request sent is identical to legacy_agent_write_json with the same options.
+ * open_writer does not create the DDS writer (see legacy_agent_create_writer).
+ * A writer may be used from several tasks; close it before legacy_agent_close.
+ */
+typedef struct LegacyWriterImpl* LEGACY_WRITER;
+
+LegacyStatus legacy_agent_open_writer(
+    LEGACY_HANDLE h,
+    const LegacyWriteJsonOptions* opt,
+    LEGACY_WRITER* out_writer);
+
+LegacyStatus legacy_agent_writer_write(
+    LEGACY_WRITER w,
+    const char* data_json,
+    uint32_t timeout_ms,
+    LegacyWriteCb cb,
+    void* user);
+
+LegacyStatus legacy_agent_writer_write_noack(
+    LEGACY_WRITER w,
+    const char* data_json);
+
+/* Encodes with the type adapter of opt->topic/opt->type (see write_struct). */
+LegacyStatus legacy_agent_writer_write_struct(
+    LEGACY_WRITER w,
+    const void* user_struct,
+    uint32_t timeout_ms,
+    LegacyWriteCb cb,
+    void* user);
+
+LegacyStatus legacy_agent_writer_write_struct_noack(
+    LEGACY_WRITER w,
+    const void* user_struct);
+
+void legacy_agent_close_writer(LEGACY_WRITER w);
+
+/* Opt-in send batching for high-rate writers.
+ * While enabled, encoded frames (per-frame header unchanged) are queued and sent
+ * together (sendmmsg on Linux) when max_frames are queued, when max_delay_ms has
+ * elapsed since the first queued frame (0 = no time limit), or on legacy_agent_flush().
+ * max_frames is capped at 64; max_frames <= 1 flushes and disables batching.
+ * Only writes are batched: control requests (hello/create/clear/qos) flush the
+ * queue and leave immediately. Pending frames are also flushed by legacy_agent_close().
+ */
+LegacyStatus legacy_agent_set_send_batching(
+    LEGACY_HANDLE h,
+    uint32_t max_frames,
+    uint32_t max_delay_ms);
+
+/* Send every queued frame now (no-op when nothing is queued). */
+LegacyStatus legacy_agent_flush(LEGACY_HANDLE h);
+
 /* --- Data Plane API (Events/Read) --- */
 
 typedef struct {
     const char* topic;
     const char* type;
     const char* data_json;
-    const char* raw_json;
+    const char* raw_json;   // Always "": use legacy_event_raw_json() (serialized on demand)
+    const void* priv;       // Library internal (source of raw JSON); do not use
+    LegacyTopicHandle topic_handle;
 } LegacyEvent;
 
 typedef void (*LegacyEventCb)(
@@ -277,6 +548,11 @@ typedef void (*LegacyEventCb)(
     const LegacyEvent* evt,
     void* user);
 
+/* Full event JSON (same rules as legacy_result_raw_json). Events are not
+ * re-serialized unless this is called; data_json is always available.
+ */
+const char* legacy_event_raw_json(const LegacyEvent* evt);
+
 LegacyStatus legacy_agent_subscribe_event(
     LEGACY_HANDLE h,
     const char* topic,
@@ -284,6 +560,11 @@ LegacyStatus legacy_agent_subscribe_event(
     LegacyEventCb cb,
     void* user);
 
+/* Typed events: user_struct is decoded by the adapter registered for the
+ * topic/type (see LegacyTypeAdapter) and is valid during the callback only.
+ * evt->data_json is NULL here; legacy_event_raw_json() still works.
+ * Events with no usable adapter are not delivered to typed callbacks.
+ */
 typedef void (*LegacyTypedEventCb)(
     LEGACY_HANDLE h,
     const LegacyEvent* evt,
@@ -297,6 +578,18 @@ LegacyStatus legacy_agent_subscribe_typed(
     LegacyTypedEventCb cb,
     void* user);
 
+LegacyStatus legacy_agent_subscribe_event_by_handle(
+    LEGACY_HANDLE h,
+    LegacyTopicHandle topic,
+    LegacyEventCb cb,
+    void* user);
+
+LegacyStatus legacy_agent_subscribe_typed_by_handle(
+    LEGACY_HANDLE h,
+    LegacyTopicHandle topic,
+    LegacyTypedEventCb cb,
+    void* user);
+
 /* --- Type Adapter API --- */
 
 typedef struct {
@@ -304,6 +597,84 @@ typedef struct {
     const char* type_name;
 } LegacyTypeKey;
 
+/* Field-offset descriptor of a user struct. With a descriptor registered
+ * (LegacyTypeAdapter::desc), typed events are decoded from the received CBOR
+ * straight into the struct, and write_struct encodes the struct straight to
+ * CBOR: no JSON text is produced or parsed either way.
+ * On receive, members without a descriptor entry, and keys missing from the
+ * data, are left zero; keys without an entry and values of another type are
+ * skipped. On write, only described members are sent.
+ */
+typedef enum {
+    LEGACY_FIELD_BOOL = 0,  // bool
+    LEGACY_FIELD_INT,       // signed integer, size 1/2/4/8
+    LEGACY_FIELD_UINT,      // unsigned integer, size 1/2/4/8
+    LEGACY_FIELD_FLOAT,     // float (size 4) or double (size 8)
+    LEGACY_FIELD_STRING,    // char[size], NUL-terminated, truncated to fit
+    LEGACY_FIELD_ENUM,      // C enum (size 1/2/4): enumerator name via 'enums', or a number
+    LEGACY_FIELD_STRUCT     // nested struct described by 'nested'
+} LegacyFieldType;
+
+typedef struct {
+    const char* name;       // enumerator text on the wire
+    int         value;
+} LegacyEnumEntry;
+
+typedef struct LegacyStructDesc LegacyStructDesc;
+
+typedef struct {
+    const char*     name;       // key in the data object
+    LegacyFieldType type;
+    size_t          offset;     // offsetof(struct, member)
+    size_t          size;       // size of one element (capacity for STRING)
+    size_t          count;      // 0/1: scalar; N: fixed array filled from a CBOR array
+    const LegacyEnumEntry*  enums;      // ENUM only
+    size_t                  enum_count;
+    const LegacyStructDesc* nested;     // STRUCT only
+} LegacyFieldDesc;
+
+struct LegacyStructDesc {
+    size_t                 size;        // sizeof(struct)
+    const LegacyFieldDesc* fields;
+    size_t                 field_count;
+};
+
+/* Per-type CBOR codec: encode/decode functions specialised for one struct
+ * (legacy_reflect.hpp generates them from the same field list as the
+ * descriptor). They follow the descriptor rules above and build on the
+ * primitives below, which run the library's own CBOR encoder/decoder.
+ * Readers return LEGACY_CBOR_OK (value read), LEGACY_CBOR_SKIPPED (null or
+ * an item of another kind, consumed) or LEGACY_CBOR_ERROR (malformed data:
+ * stop decoding).
+ */
+typedef struct LegacyCborWriter LegacyCborWriter;
+typedef struct LegacyCborReader LegacyCborReader;
+
+#define LEGACY_CBOR_OK        0
+#define LEGACY_CBOR_SKIPPED   1
+#define LEGACY_CBOR_ERROR    (-1)
+
+void legacy_cbor_write_map(LegacyCborWriter* w, size_t pairs);
+void legacy_cbor_write_array(LegacyCborWriter* w, size_t items);
+void legacy_cbor_write_text(LegacyCborWriter* w, const char* s, size_t len);
+void legacy_cbor_write_int(LegacyCborWriter* w, int64_t v);
+void legacy_cbor_write_uint(LegacyCborWriter* w, uint64_t v);
+void legacy_cbor_write_double(LegacyCborWriter* w, double v);
+void legacy_cbor_write_bool(LegacyCborWriter* w, bool v);
+
+int  legacy_cbor_read_map(LegacyCborReader* r, size_t* pairs);    // SKIPPED: not a map
+int  legacy_cbor_read_array(LegacyCborReader* r, size_t* items);  // SKIPPED: not an array
+// True while item 'i' of a map/array of 'count' items is left (handles indefinite lengths)
+bool legacy_cbor_read_next(LegacyCborReader* r, size_t count, size_t i);
+int  legacy_cbor_read_key(LegacyCborReader* r, const char** s, size_t* len);   // SKIPPED: non-text key
+int  legacy_cbor_read_bool(LegacyCborReader* r, bool* v);          // bools and numbers
+int  legacy_cbor_read_int(LegacyCborReader* r, int64_t* v);        // numbers (floats truncated)
+int  legacy_cbor_read_double(LegacyCborReader* r, double* v);      // numbers
+int  legacy_cbor_read_text(LegacyCborReader* r, const char** s, size_t* len);
+// Enum value: enumerator text (*s set) or a number (*s NULL, *v set)
+int  legacy_cbor_read_enum(LegacyCborReader* r, const char** s, size_t* len, int64_t* v);
+int  legacy_cbor_skip(LegacyCborReader* r);
+
 typedef struct LegacyTypeAdapter {
     LegacyTypeKey key;
 
@@ -312,6 +683,21 @@ typedef struct LegacyTypeAdapter {
     const char* (*make_default)(void* user_ctx);
 
     void* user_ctx;
+
+    /* Typed receive (legacy_agent_subscribe_typed) and write_struct. 'desc'
+     * (preferred) decodes/encodes CBOR directly; without it 'decode' gets the
+     * data JSON (struct_size sizes the struct) and 'encode' produces it. The
+     * descriptor is referenced, not copied: keep it alive (static) while
+     * registered.
+     */
+    const LegacyStructDesc* desc;
+    size_t                  struct_size;
+
+    /* Per-type codec, used in place of 'desc' when set (both or neither).
+     * The struct is sized by 'desc' when given, else by struct_size.
+     */
+    void (*encode_cbor)(LegacyCborWriter* w, const void* user_struct);
+    bool (*decode_cbor)(LegacyCborReader* r, void* out_user_struct);
 } LegacyTypeAdapter;
 
 LegacyStatus legacy_agent_register_type_adapter(
@@ -0,0 +1,408 @@
+#ifndef LEGACY_REFLECT_HPP
+#define LEGACY_REFLECT_HPP
+
+/* Compile-time struct reflection for the type adapter (C++11, header only).
+ *
+ * The field list of a struct is declared once. From it are generated, for
+ * write_struct and typed receive:
+ * - a per-type CBOR codec: encode/decode functions instantiated for the
+ *   struct, with every member's kind, offset, wire key and enumerator table
+ *   fixed at compile time (no descriptor walk at run time);
+ * - the matching LegacyStructDesc, as constant data (no registration-time
+ *   work, no allocation).
+ * Field kind, element size, array length, nested structs and enumerator
+ * tables are deduced from the member types, so they cannot drift from the
+ * struct.
+ *
+ *   LEGACY_REFLECT_ENUM_BEGIN(T_ModeType)
+ *       LEGACY_REFLECT_ENUMERATOR("L_ModeType_NORMAL", L_ModeType_NORMAL)
+ *       LEGACY_REFLECT_ENUMERATOR("L_ModeType_MANUAL", L_ModeType_MANUAL)
+ *   LEGACY_REFLECT_ENUM_END(T_ModeType)
+ *
+ *   LEGACY_REFLECT_STRUCT_BEGIN(MyCmd)
+ *       LEGACY_REFLECT_FIELD(A_pos)                   // key "A_pos"
+ *       LEGACY_REFLECT_FIELD_AS(mode, "A_mode")       // other wire key
+ *   LEGACY_REFLECT_STRUCT_END(MyCmd)
+ *
+ *   legacy::reflect::register_type<MyCmd>(h, "C_Command", "C_MyCmd");
+ *
+ * Member type mapping: bool -> BOOL, signed/unsigned integers -> INT/UINT,
+ * float/double -> FLOAT, char[N] -> STRING, enums -> ENUM (by name when the
+ * enum is reflected, else as a number), reflected structs -> STRUCT, T[N] ->
+ * N elements of T. Nested structs and enums must be reflected before the
+ * struct that uses them. Declarations go at global namespace scope.
+ */
+
+#include "legacy_agent.h"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace legacy {
+namespace reflect {
+
+// Reflected structs/enums specialize these (Tag keeps the static members of
+// a specialization a template, so they can be defined in a header)
+template<typename T, typename Tag = void> struct Struct;
+
+template<typename E, typename Tag = void> struct Enum {
+    static constexpr const LegacyEnumEntry* entries() { return nullptr; }
+    static const size_t count = 0;
+};
+
+namespace detail {
+
+template<LegacyFieldType K, typename T> struct Scalar {
+    static const LegacyFieldType kind = K;
+    static const size_t size = sizeof(T);
+    static const size_t count = 0;
+    static constexpr const LegacyEnumEntry* enums() { return nullptr; }
+    static const size_t enum_count = 0;
+    static constexpr const LegacyStructDesc* nested() { return nullptr; }
+};
+
+template<typename T, typename Enable = void> struct Field;
+
+template<> struct Field<bool> : Scalar<LEGACY_FIELD_BOOL, bool> {};
+
+template<typename T>
+struct Field<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+    : Scalar<std::is_signed<T>::value ? LEGACY_FIELD_INT : LEGACY_FIELD_UINT, T> {};
+
+template<typename T>
+struct Field<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+    : Scalar<LEGACY_FIELD_FLOAT, T> {};
+
+template<typename T>
+struct Field<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    : Scalar<LEGACY_FIELD_ENUM, T> {
+    static constexpr const LegacyEnumEntry* enums() { return Enum<T>::entries(); }
+    static const size_t enum_count = Enum<T>::count;
+};
+
+template<typename T>
+struct Field<T, typename std::enable_if<std::is_class<T>::value>::type>
+    : Scalar<LEGACY_FIELD_STRUCT, T> {
+    static constexpr const LegacyStructDesc* nested() { return &Struct<T>::desc; }
+};
+
+// char[N] is text; any other T[N] is an array of N elements
+template<size_t N> struct Field<char[N]> : Scalar<LEGACY_FIELD_STRING, char[N]> {};
+
+template<typename T, size_t N> struct Field<T[N]> : Field<T> {
+    static_assert(N > 1, "one-element arrays are not supported");
+    static const size_t count = N;
+};
+
+// Value codecs, one per member type. decode() returns a LEGACY_CBOR_* code
+// and leaves the member as is unless a value was read (descriptor rules).
+typedef void (*EncodeFn)(LegacyCborWriter* w, const void* src);
+typedef int  (*DecodeFn)(LegacyCborReader* r, void* dst);
+
+template<typename T, typename Enable = void> struct Value;
+
+template<> struct Value<bool> {
+    static void encode(LegacyCborWriter* w, const void* src) {
+        legacy_cbor_write_bool(w, *static_cast<const bool*>(src));
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        bool v;
+        int rc = legacy_cbor_read_bool(r, &v);
+        if (rc == LEGACY_CBOR_OK) *static_cast<bool*>(dst) = v;
+        return rc;
+    }
+};
+
+template<typename T>
+struct Value<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+    static void encode(LegacyCborWriter* w, const void* src) {
+        T v = *static_cast<const T*>(src);
+        if (std::is_signed<T>::value) {
+            legacy_cbor_write_int(w, (int64_t)v);
+        } else {
+            legacy_cbor_write_uint(w, (uint64_t)v);
+        }
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        int64_t v;
+        int rc = legacy_cbor_read_int(r, &v);
+        if (rc == LEGACY_CBOR_OK) *static_cast<T*>(dst) = (T)v;
+        return rc;
+    }
+};
+
+template<typename T>
+struct Value<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static void encode(LegacyCborWriter* w, const void* src) {
+        legacy_cbor_write_double(w, (double)*static_cast<const T*>(src));
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        double v;
+        int rc = legacy_cbor_read_double(r, &v);
+        if (rc == LEGACY_CBOR_OK) *static_cast<T*>(dst) = (T)v;
+        return rc;
+    }
+};
+
+// Enums go by enumerator name when reflected, as a number otherwise
+template<typename E>
+struct Value<E, typename std::enable_if<std::is_enum<E>::value>::type> {
+    typedef typename std::underlying_type<E>::type U;
+
+    static void encode(LegacyCborWriter* w, const void* src) {
+        // Read as signed, as the descriptor codec does
+        int64_t v = (int64_t)(typename std::make_signed<U>::type)*static_cast<const U*>(src);
+        const LegacyEnumEntry* e = Enum<E>::entries();
+        for (size_t i = 0; i < Enum<E>::count; ++i) {
+            if (e[i].value == v) {
+                legacy_cbor_write_text(w, e[i].name, strlen(e[i].name));
+                return;
+            }
+        }
+        legacy_cbor_write_int(w, v);
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        const char* s;
+        size_t len;
+        int64_t v;
+        int rc = legacy_cbor_read_enum(r, &s, &len, &v);
+        if (rc != LEGACY_CBOR_OK) return rc;
+        if (s) {
+            const LegacyEnumEntry* e = Enum<E>::entries();
+            size_t i = 0;
+            while (i < Enum<E>::count && !(strncmp(e[i].name, s, len) == 0 && e[i].name[len] == '\0')) ++i;
+            if (i == Enum<E>::count) return LEGACY_CBOR_SKIPPED;   // unknown enumerator
+            v = e[i].value;
+        }
+        *static_cast<U*>(dst) = (U)v;
+        return LEGACY_CBOR_OK;
+    }
+};
+
+template<typename T> struct Codec;
+
+template<typename T>
+struct Value<T, typename std::enable_if<std::is_class<T>::value>::type> {
+    static void encode(LegacyCborWriter* w, const void* src) { Codec<T>::encode(w, src); }
+    static int decode(LegacyCborReader* r, void* dst) { return Codec<T>::decodeMap(r, dst); }
+};
+
+template<size_t N> struct Value<char[N]> {
+    static void encode(LegacyCborWriter* w, const void* src) {
+        const char* s = static_cast<const char*>(src);
+        size_t len = 0;
+        while (len < N && s[len] != '\0') ++len;
+        legacy_cbor_write_text(w, s, len);
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        const char* s;
+        size_t len;
+        int rc = legacy_cbor_read_text(r, &s, &len);
+        if (rc != LEGACY_CBOR_OK) return rc;
+        if (len > N - 1) len = N - 1;
+        memcpy(dst, s, len);
+        static_cast<char*>(dst)[len] = '\0';
+        return LEGACY_CBOR_OK;
+    }
+};
+
+template<typename T, size_t N> struct Value<T[N]> {
+    static void encode(LegacyCborWriter* w, const void* src) {
+        const T* a = static_cast<const T*>(src);
+        legacy_cbor_write_array(w, N);
+        for (size_t i = 0; i < N; ++i) Value<T>::encode(w, &a[i]);
+    }
+    static int decode(LegacyCborReader* r, void* dst) {
+        T* a = static_cast<T*>(dst);
+        size_t items;
+        int rc = legacy_cbor_read_array(r, &items);
+        if (rc != LEGACY_CBOR_OK) return rc;
+        for (size_t i = 0; legacy_cbor_read_next(r, items, i); ++i) {
+            rc = (i < N) ? Value<T>::decode(r, &a[i]) : legacy_cbor_skip(r);
+            if (rc == LEGACY_CBOR_ERROR) return rc;
+        }
+        return LEGACY_CBOR_OK;
+    }
+};
+
+// One reflected member: its descriptor entry and the codec of its type
+struct Entry {
+    LegacyFieldDesc desc;
+    EncodeFn        encode;
+    DecodeFn        decode;
+};
+
+template<typename M>
+constexpr Entry entry(const char* name, size_t offset) {
+    return Entry{ LegacyFieldDesc{ name, Field<M>::kind, offset, Field<M>::size, Field<M>::count,
+                                   Field<M>::enums(), Field<M>::enum_count, Field<M>::nested() },
+                  &Value<M>::encode, &Value<M>::decode };
+}
+
+constexpr size_t length(const char* s) {
+    return *s ? 1 + length(s + 1) : 0;
+}
+
+template<size_t... I> struct Indices {};
+template<size_t N, size_t... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+template<size_t... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+// LegacyFieldDesc table of a reflected struct, gathered from its entries
+template<typename S, typename Seq> struct FieldTable;
+template<typename S, size_t... I> struct FieldTable<S, Indices<I...> > {
+    static constexpr LegacyFieldDesc value[] = { S::entries[I].desc... };
+};
+template<typename S, size_t... I> constexpr LegacyFieldDesc FieldTable<S, Indices<I...> >::value[];
+
+// Per-type codec. Every member is handled by code instantiated for it: keys
+// and their lengths are constants, and the decoder tries the member that
+// follows the last match first, as encoders emit keys in a fixed order.
+template<typename T> struct Codec {
+    typedef Struct<T> S;
+    static const size_t N = S::count;
+    typedef int (*MatchFn)(LegacyCborReader* r, const char* key, size_t len, unsigned char* base);
+
+    template<size_t I>
+    static void encodeField(LegacyCborWriter* w, const unsigned char* base) {
+        legacy_cbor_write_text(w, S::entries[I].desc.name,
+                               std::integral_constant<size_t, length(S::entries[I].desc.name)>::value);
+        S::entries[I].encode(w, base + S::entries[I].desc.offset);
+    }
+
+    // LEGACY_CBOR_SKIPPED here: the key is not member I
+    template<size_t I>
+    static int matchField(LegacyCborReader* r, const char* key, size_t len, unsigned char* base) {
+        if (len != std::integral_constant<size_t, length(S::entries[I].desc.name)>::value ||
+            memcmp(key, S::entries[I].desc.name, len) != 0) {
+            return LEGACY_CBOR_SKIPPED;
+        }
+        int rc = S::entries[I].decode(r, base + S::entries[I].desc.offset);
+        return rc == LEGACY_CBOR_ERROR ? rc : LEGACY_CBOR_OK;
+    }
+
+    template<size_t... I>
+    static void encodeFields(LegacyCborWriter* w, const unsigned char* base, Indices<I...>) {
+        int expand[] = { 0, (encodeField<I>(w, base), 0)... };
+        (void)expand;
+    }
+
+    template<size_t... I>
+    static const MatchFn* matchers(Indices<I...>) {
+        static const MatchFn table[] = { &matchField<I>... };
+        return table;
+    }
+
+    static void encode(LegacyCborWriter* w, const void* in) {
+        legacy_cbor_write_map(w, N);
+        encodeFields(w, static_cast<const unsigned char*>(in), typename MakeIndices<N>::type());
+    }
+
+    static int decodeMap(LegacyCborReader* r, void* out) {
+        unsigned char* base = static_cast<unsigned char*>(out);
+        const MatchFn* match = matchers(typename MakeIndices<N>::type());
+        size_t pairs;
+        int rc = legacy_cbor_read_map(r, &pairs);
+        if (rc != LEGACY_CBOR_OK) return rc;
+        size_t hint = 0;
+        for (size_t i = 0; legacy_cbor_read_next(r, pairs, i); ++i) {
+            const char* key;
+            size_t len;
+            rc = legacy_cbor_read_key(r, &key, &len);
+            if (rc == LEGACY_CBOR_ERROR) return rc;
+            if (rc == LEGACY_CBOR_OK) {
+                rc = LEGACY_CBOR_SKIPPED;
+                for (size_t n = 0; n < N && rc == LEGACY_CBOR_SKIPPED; ++n) {
+                    size_t idx = (hint + n < N) ? hint + n : hint + n - N;
+                    rc = match[idx](r, key, len, base);
+                    if (rc == LEGACY_CBOR_OK) hint = (idx + 1 < N) ? idx + 1 : 0;
+                }
+            }
+            if (rc == LEGACY_CBOR_SKIPPED) rc = legacy_cbor_skip(r);   // no such member
+            if (rc == LEGACY_CBOR_ERROR) return rc;
+        }
+        return LEGACY_CBOR_OK;
+    }
+
+    static bool decode(LegacyCborReader* r, void* out) {
+        return decodeMap(r, out) == LEGACY_CBOR_OK;
+    }
+};
+
+} // namespace detail
+
+template<typename M>
+constexpr LegacyFieldDesc field(const char* name, size_t offset) {
+    return detail::entry<M>(name, offset).desc;
+}
+
+// Descriptor of a reflected struct
+template<typename T>
+inline const LegacyStructDesc* desc() {
+    return &Struct<T>::desc;
+}
+
+// Type adapter of topic/type with the reflected codec and descriptor of T,
+// for callers that wrap a codec function before registering it
+template<typename T>
+inline LegacyTypeAdapter make_adapter(const char* topic, const char* type_name) {
+    LegacyTypeAdapter adapter;
+    memset(&adapter, 0, sizeof(adapter));
+    adapter.key.topic = topic;
+    adapter.key.type_name = type_name;
+    adapter.desc = &Struct<T>::desc;
+    adapter.struct_size = sizeof(T);
+    adapter.encode_cbor = &detail::Codec<T>::encode;
+    adapter.decode_cbor = &detail::Codec<T>::decode;
+    return adapter;
+}
+
+// Register the reflected codec (and descriptor) of T as the type adapter of topic/type
+template<typename T>
+inline LegacyStatus register_type(LEGACY_HANDLE h, const char* topic, const char* type_name) {
+    LegacyTypeAdapter adapter = make_adapter<T>(topic, type_name);
+    return legacy_agent_register_type_adapter(h, &adapter);
+}
+
+} // namespace reflect
+} // namespace legacy
+
+#define LEGACY_REFLECT_ENUM_BEGIN(E) \
+    namespace legacy { namespace reflect { \
+    template<typename Tag> struct Enum<E, Tag> { \
+        static constexpr LegacyEnumEntry table[] = {
+
+#define LEGACY_REFLECT_ENUMERATOR(name, value) { name, (int)(value) },
+
+#define LEGACY_REFLECT_ENUM_END(E) \
+        }; \
+        static constexpr const LegacyEnumEntry* entries() { return table; } \
+        static const size_t count = sizeof(table) / sizeof(table[0]); \
+    }; \
+    template<typename Tag> constexpr LegacyEnumEntry Enum<E, Tag>::table[]; \
+    } }
+
+#define LEGACY_REFLECT_STRUCT_BEGIN(S) \
+    namespace legacy { namespace reflect { \
+    template<typename Tag> struct Struct<S, Tag> { \
+        static_assert(std::is_standard_layout<S>::value, #S " must be standard-layout"); \
+        typedef S type; \
+        static constexpr ::legacy::reflect::detail::Entry entries[] = {
+
+#define LEGACY_REFLECT_FIELD_AS(member, key) \
+    ::legacy::reflect::detail::entry<decltype(((type*)0)->member)>(key, offsetof(type, member)),
+
+#define LEGACY_REFLECT_FIELD(member) LEGACY_REFLECT_FIELD_AS(member, #member)
+
+#define LEGACY_REFLECT_STRUCT_END(S) \
+        }; \
+        static const size_t count = sizeof(entries) / sizeof(entries[0]); \
+        static const LegacyStructDesc desc; \
+    }; \
+    template<typename Tag> constexpr ::legacy::reflect::detail::Entry Struct<S, Tag>::entries[]; \
+    template<typename Tag> const LegacyStructDesc Struct<S, Tag>::desc = { sizeof(S), \
+        ::legacy::reflect::detail::FieldTable<Struct<S, Tag>, \
+            typename ::legacy::reflect::detail::MakeIndices<Struct<S, Tag>::count>::type>::value, \
+        Struct<S, Tag>::count }; \
+    } }
+
+#endif /* LEGACY_REFLECT_HPP */
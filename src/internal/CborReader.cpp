@@ -0,0 +1,218 @@
+#include "CborReader.h"
+#include <cstring>
+#include <cmath>
+
+// Nesting limit for skip (recursion runs on the receive task stack)
+static const int kMaxSkipDepth = 32;
+
+static const uint8_t kInfoIndefinite = 31;
+
+static double half_to_double(uint16_t h) {
+    int exp = (h >> 10) & 0x1F;
+    int mant = h & 0x3FF;
+    double v;
+    if (exp == 0) {
+        v = std::ldexp((double)mant, -24);
+    } else if (exp != 31) {
+        v = std::ldexp((double)(mant + 1024), exp - 25);
+    } else {
+        v = mant == 0 ? HUGE_VAL : std::nan("");
+    }
+    return (h & 0x8000) ? -v : v;
+}
+
+CborReader::Kind CborReader::peek() const {
+    if (p_ >= end_) return KIND_INVALID;
+    uint8_t major = (uint8_t)(*p_ >> 5);
+    uint8_t info = (uint8_t)(*p_ & 0x1F);
+    switch (major) {
+    case 0: return KIND_UINT;
+    case 1: return KIND_NINT;
+    case 2: return KIND_BYTES;
+    case 3: return KIND_TEXT;
+    case 4: return KIND_ARRAY;
+    case 5: return KIND_MAP;
+    case 7:
+        if (info == 20 || info == 21) return KIND_BOOL;
+        if (info == 22 || info == 23) return KIND_NULL;   // null, undefined
+        if (info >= 25 && info <= 27) return KIND_FLOAT;
+        if (info == kInfoIndefinite) return KIND_BREAK;
+        return KIND_INVALID;
+    default:
+        return KIND_INVALID;                           // tags
+    }
+}
+
+bool CborReader::readHead(uint8_t& major, uint8_t& info, uint64_t& arg) {
+    if (p_ >= end_) return false;
+    major = (uint8_t)(*p_ >> 5);
+    info = (uint8_t)(*p_ & 0x1F);
+    ++p_;
+    if (info < 24) {
+        arg = info;
+        return true;
+    }
+    if (info == kInfoIndefinite) {
+        arg = 0;
+        return major >= 2 && major <= 5;
+    }
+    if (info > 27) return false;
+    size_t n = (size_t)1 << (info - 24);
+    if ((size_t)(end_ - p_) < n) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v = (v << 8) | p_[i];
+    }
+    p_ += n;
+    arg = v;
+    return true;
+}
+
+bool CborReader::readMap(size_t& pairs) {
+    if (peek() != KIND_MAP) return false;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg)) return false;
+    pairs = (info == kInfoIndefinite) ? kIndefinite : (size_t)arg;
+    return true;
+}
+
+bool CborReader::readArray(size_t& items) {
+    if (peek() != KIND_ARRAY) return false;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg)) return false;
+    items = (info == kInfoIndefinite) ? kIndefinite : (size_t)arg;
+    return true;
+}
+
+bool CborReader::readBreak() {
+    if (p_ < end_ && *p_ == 0xFF) {
+        ++p_;
+        return true;
+    }
+    return false;
+}
+
+bool CborReader::readText(const char*& s, size_t& len) {
+    if (peek() != KIND_TEXT) return false;
+    const uint8_t* start = p_;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg) || info == kInfoIndefinite || (uint64_t)(end_ - p_) < arg) {
+        p_ = start;    // chunked text is left for skip()
+        return false;
+    }
+    s = reinterpret_cast<const char*>(p_);
+    len = (size_t)arg;
+    p_ += len;
+    return true;
+}
+
+bool CborReader::readUInt(uint64_t& v) {
+    if (peek() != KIND_UINT) return false;
+    uint8_t major, info;
+    return readHead(major, info, v);
+}
+
+bool CborReader::readInt(int64_t& v) {
+    Kind k = peek();
+    if (k != KIND_UINT && k != KIND_NINT) return false;
+    const uint8_t* start = p_;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg)) return false;
+    if (arg > (uint64_t)INT64_MAX) {
+        p_ = start;
+        return false;
+    }
+    v = (k == KIND_UINT) ? (int64_t)arg : -1 - (int64_t)arg;
+    return true;
+}
+
+bool CborReader::readDouble(double& v) {
+    Kind k = peek();
+    if (k == KIND_UINT) {
+        uint64_t u;
+        if (!readUInt(u)) return false;
+        v = (double)u;
+        return true;
+    }
+    if (k == KIND_NINT) {
+        uint8_t major, info;
+        uint64_t arg;
+        if (!readHead(major, info, arg)) return false;
+        v = -1.0 - (double)arg;
+        return true;
+    }
+    if (k != KIND_FLOAT) return false;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg)) return false;
+    if (info == 25) {
+        v = half_to_double((uint16_t)arg);
+    } else if (info == 26) {
+        uint32_t bits = (uint32_t)arg;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        v = f;
+    } else {
+        memcpy(&v, &arg, sizeof(v));
+    }
+    return true;
+}
+
+bool CborReader::readBool(bool& v) {
+    if (peek() != KIND_BOOL) return false;
+    v = (*p_ & 0x1F) == 21;
+    ++p_;
+    return true;
+}
+
+bool CborReader::skip() {
+    return skipItem(0);
+}
+
+bool CborReader::skipItem(int depth) {
+    if (depth > kMaxSkipDepth) return false;
+    Kind k = peek();
+    if (k == KIND_INVALID || k == KIND_BREAK) return false;
+    uint8_t major, info;
+    uint64_t arg;
+    if (!readHead(major, info, arg)) return false;
+    switch (major) {
+    case 2:
+    case 3:
+        if (info == kInfoIndefinite) {
+            // Chunked string: definite chunks of the same major type
+            while (!readBreak()) {
+                if (p_ >= end_ || (*p_ >> 5) != major) return false;
+                if (!skipItem(depth + 1)) return false;
+            }
+            return true;
+        }
+        if ((uint64_t)(end_ - p_) < arg) return false;
+        p_ += (size_t)arg;
+        return true;
+    case 4:
+    case 5: {
+        uint64_t per_entry = (major == 5) ? 2 : 1;
+        if (info == kInfoIndefinite) {
+            while (!readBreak()) {
+                for (uint64_t i = 0; i < per_entry; ++i) {
+                    if (!skipItem(depth + 1)) return false;
+                }
+            }
+            return true;
+        }
+        // Every item takes at least one byte: reject counts the buffer cannot hold
+        if (arg > (uint64_t)(end_ - p_)) return false;
+        for (uint64_t i = 0; i < arg * per_entry; ++i) {
+            if (!skipItem(depth + 1)) return false;
+        }
+        return true;
+    }
+    default:
+        return true;   // integers, simple values and floats: head only
+    }
+}
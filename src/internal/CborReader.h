@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Pull-style CBOR decoder (RFC 8949) over a received payload. Items are read
+// in place: text values point into the buffer, nothing is allocated.
+//
+// Accepts what CborWriter and nlohmann::json::to_cbor produce plus
+// indefinite-length maps/arrays. Tags are rejected (as nlohmann does by
+// default), so a payload the reader refuses also fails on the DOM path.
+class CborReader {
+public:
+    enum Kind {
+        KIND_UINT, KIND_NINT, KIND_BYTES, KIND_TEXT, KIND_ARRAY, KIND_MAP,
+        KIND_BOOL, KIND_NULL, KIND_FLOAT, KIND_BREAK, KIND_INVALID
+    };
+    // Item count of an indefinite-length map/array: read until readBreak()
+    static const size_t kIndefinite = (size_t)-1;
+
+    CborReader(const uint8_t* data, size_t len) : p_(data), end_(data + len) {}
+
+    // Kind of the next item (KIND_INVALID at the end of the buffer)
+    Kind peek() const;
+
+    bool readMap(size_t& pairs);
+    bool readArray(size_t& items);
+    // True (and consumed) when the next byte ends an indefinite container
+    bool readBreak();
+    bool readText(const char*& s, size_t& len);   // definite length only; untouched on failure
+    bool readInt(int64_t& v);                     // integers that fit int64
+    bool readUInt(uint64_t& v);
+    bool readDouble(double& v);                   // floats and integers
+    bool readBool(bool& v);
+
+    // Step over one complete item of any kind
+    bool skip();
+
+    const uint8_t* pos() const { return p_; }
+    bool atEnd() const { return p_ >= end_; }
+
+private:
+    bool readHead(uint8_t& major, uint8_t& info, uint64_t& arg);
+    bool skipItem(int depth);
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+};
@@ -0,0 +1,336 @@
+#include "CborWriter.h"
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+
+// Nesting limit for writeJsonText (recursion runs on the caller's task stack)
+static const int kMaxJsonDepth = 32;
+
+static size_t head_size(uint64_t v) {
+    if (v < 24) return 1;
+    if (v <= 0xFFULL) return 2;
+    if (v <= 0xFFFFULL) return 3;
+    if (v <= 0xFFFFFFFFULL) return 5;
+    return 9;
+}
+
+static void put_head(uint8_t* dst, uint8_t major, uint64_t v) {
+    uint8_t mt = (uint8_t)(major << 5);
+    size_t n = head_size(v);
+    switch (n) {
+    case 1: dst[0] = (uint8_t)(mt | v); return;
+    case 2: dst[0] = mt | 24; break;
+    case 3: dst[0] = mt | 25; break;
+    case 5: dst[0] = mt | 26; break;
+    default: dst[0] = mt | 27; break;
+    }
+    for (size_t i = n - 1; i >= 1; --i) {
+        dst[i] = (uint8_t)(v & 0xFF);
+        v >>= 8;
+    }
+}
+
+static bool is_ws(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static void skip_ws(const char*& p) {
+    while (is_ws(*p)) ++p;
+}
+
+static int hex_val(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool read_hex4(const char* p, uint32_t* out) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        int h = hex_val(p[i]);
+        if (h < 0) return false;
+        v = (v << 4) | (uint32_t)h;
+    }
+    *out = v;
+    return true;
+}
+
+void CborWriter::writeHead(uint8_t major, uint64_t v) {
+    uint8_t tmp[9];
+    put_head(tmp, major, v);
+    out_.insert(out_.end(), tmp, tmp + head_size(v));
+}
+
+void CborWriter::patchHead(size_t pos, size_t reserved, uint8_t major, uint64_t v) {
+    size_t need = head_size(v);
+    if (need > reserved) {
+        out_.insert(out_.begin() + pos + reserved, need - reserved, 0);
+    } else if (need < reserved) {
+        out_.erase(out_.begin() + pos + need, out_.begin() + pos + reserved);
+    }
+    put_head(&out_[pos], major, v);
+}
+
+void CborWriter::writeText(const char* s) {
+    writeText(s, s ? strlen(s) : 0);
+}
+
+void CborWriter::writeText(const char* s, size_t len) {
+    writeHead(3, len);
+    if (len) out_.insert(out_.end(), (const uint8_t*)s, (const uint8_t*)s + len);
+}
+
+void CborWriter::writeInt(int64_t v) {
+    if (v >= 0) {
+        writeHead(0, (uint64_t)v);
+    } else {
+        writeHead(1, (uint64_t)(-1 - v));
+    }
+}
+
+void CborWriter::writeDouble(double v) {
+    if (std::isnan(v)) {
+        const uint8_t nan16[3] = { 0xF9, 0x7E, 0x00 };
+        out_.insert(out_.end(), nan16, nan16 + 3);
+        return;
+    }
+    if (std::isinf(v)) {
+        const uint8_t inf16[3] = { 0xF9, (uint8_t)(v > 0 ? 0x7C : 0xFC), 0x00 };
+        out_.insert(out_.end(), inf16, inf16 + 3);
+        return;
+    }
+    if (v >= (double)std::numeric_limits<float>::lowest() &&
+        v <= (double)(std::numeric_limits<float>::max)() &&
+        (double)(float)v == v) {
+        float f = (float)v;
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        uint8_t tmp[5] = { 0xFA, (uint8_t)(bits >> 24), (uint8_t)(bits >> 16),
+                           (uint8_t)(bits >> 8), (uint8_t)bits };
+        out_.insert(out_.end(), tmp, tmp + 5);
+        return;
+    }
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint8_t tmp[9];
+    tmp[0] = 0xFB;
+    for (int i = 8; i >= 1; --i) {
+        tmp[i] = (uint8_t)(bits & 0xFF);
+        bits >>= 8;
+    }
+    out_.insert(out_.end(), tmp, tmp + 9);
+}
+
+bool CborWriter::writeJsonText(const char* json) {
+    if (!json) return false;
+    size_t mark = out_.size();
+    const char* p = json;
+    skip_ws(p);
+    if (!jsonValue(p, 0)) {
+        out_.resize(mark);
+        return false;
+    }
+    skip_ws(p);
+    if (*p != '\0') {
+        out_.resize(mark);
+        return false;
+    }
+    return true;
+}
+
+bool CborWriter::jsonValue(const char*& p, int depth) {
+    switch (*p) {
+    case '{': {
+        if (depth >= kMaxJsonDepth) return false;
+        ++p;
+        size_t pos = out_.size();
+        out_.push_back(0);
+        uint64_t pairs = 0;
+        skip_ws(p);
+        if (*p == '}') {
+            ++p;
+        } else {
+            for (;;) {
+                skip_ws(p);
+                if (*p != '"' || !jsonString(p)) return false;
+                skip_ws(p);
+                if (*p != ':') return false;
+                ++p;
+                skip_ws(p);
+                if (!jsonValue(p, depth + 1)) return false;
+                ++pairs;
+                skip_ws(p);
+                if (*p == ',') { ++p; continue; }
+                if (*p == '}') { ++p; break; }
+                return false;
+            }
+        }
+        patchHead(pos, 1, 5, pairs);
+        return true;
+    }
+    case '[': {
+        if (depth >= kMaxJsonDepth) return false;
+        ++p;
+        size_t pos = out_.size();
+        out_.push_back(0);
+        uint64_t items = 0;
+        skip_ws(p);
+        if (*p == ']') {
+            ++p;
+        } else {
+            for (;;) {
+                skip_ws(p);
+                if (!jsonValue(p, depth + 1)) return false;
+                ++items;
+                skip_ws(p);
+                if (*p == ',') { ++p; continue; }
+                if (*p == ']') { ++p; break; }
+                return false;
+            }
+        }
+        patchHead(pos, 1, 4, items);
+        return true;
+    }
+    case '"':
+        return jsonString(p);
+    case 't':
+        if (strncmp(p, "true", 4) != 0) return false;
+        p += 4;
+        writeBool(true);
+        return true;
+    case 'f':
+        if (strncmp(p, "false", 5) != 0) return false;
+        p += 5;
+        writeBool(false);
+        return true;
+    case 'n':
+        if (strncmp(p, "null", 4) != 0) return false;
+        p += 4;
+        writeNull();
+        return true;
+    default:
+        return jsonNumber(p);
+    }
+}
+
+bool CborWriter::jsonString(const char*& p) {
+    ++p; // opening quote
+    size_t pos = out_.size();
+    out_.push_back(0);
+    for (;;) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"') {
+            ++p;
+            break;
+        }
+        if (c < 0x20) return false; // control char or end of input
+        if (c != '\\') {
+            out_.push_back(c);
+            ++p;
+            continue;
+        }
+        ++p;
+        switch (*p) {
+        case '"':  out_.push_back('"');  break;
+        case '\\': out_.push_back('\\'); break;
+        case '/':  out_.push_back('/');  break;
+        case 'b':  out_.push_back('\b'); break;
+        case 'f':  out_.push_back('\f'); break;
+        case 'n':  out_.push_back('\n'); break;
+        case 'r':  out_.push_back('\r'); break;
+        case 't':  out_.push_back('\t'); break;
+        case 'u': {
+            uint32_t cp;
+            if (!read_hex4(p + 1, &cp)) return false;
+            p += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                uint32_t lo;
+                if (p[1] != '\\' || p[2] != 'u' || !read_hex4(p + 3, &lo)) return false;
+                if (lo < 0xDC00 || lo > 0xDFFF) return false;
+                p += 6;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return false;
+            }
+            if (cp < 0x80) {
+                out_.push_back((uint8_t)cp);
+            } else if (cp < 0x800) {
+                out_.push_back((uint8_t)(0xC0 | (cp >> 6)));
+                out_.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                out_.push_back((uint8_t)(0xE0 | (cp >> 12)));
+                out_.push_back((uint8_t)(0x80 | ((cp >> 6) & 0x3F)));
+                out_.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+            } else {
+                out_.push_back((uint8_t)(0xF0 | (cp >> 18)));
+                out_.push_back((uint8_t)(0x80 | ((cp >> 12) & 0x3F)));
+                out_.push_back((uint8_t)(0x80 | ((cp >> 6) & 0x3F)));
+                out_.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+        ++p;
+    }
+    patchHead(pos, 1, 3, out_.size() - pos - 1);
+    return true;
+}
+
+bool CborWriter::jsonNumber(const char*& p) {
+    // Validate JSON number grammar first: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    const char* s = p;
+    const char* q = p;
+    bool is_float = false;
+    if (*q == '-') ++q;
+    if (*q == '0') {
+        ++q;
+    } else if (*q >= '1' && *q <= '9') {
+        while (*q >= '0' && *q <= '9') ++q;
+    } else {
+        return false;
+    }
+    if (*q == '.') {
+        is_float = true;
+        ++q;
+        if (!(*q >= '0' && *q <= '9')) return false;
+        while (*q >= '0' && *q <= '9') ++q;
+    }
+    if (*q == 'e' || *q == 'E') {
+        is_float = true;
+        ++q;
+        if (*q == '+' || *q == '-') ++q;
+        if (!(*q >= '0' && *q <= '9')) return false;
+        while (*q >= '0' && *q <= '9') ++q;
+    }
+
+    char* end = nullptr;
+    if (!is_float) {
+        // Integers that do not fit 64 bits fall back to double, like nlohmann
+        errno = 0;
+        if (*s == '-') {
+            long long v = strtoll(s, &end, 10);
+            if (errno == 0 && end == q) {
+                writeInt((int64_t)v);
+                p = q;
+                return true;
+            }
+        } else {
+            unsigned long long v = strtoull(s, &end, 10);
+            if (errno == 0 && end == q) {
+                writeUInt((uint64_t)v);
+                p = q;
+                return true;
+            }
+        }
+    }
+    double d = strtod(s, &end);
+    if (end != q) return false;
+    writeDouble(d);
+    p = q;
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Streaming CBOR encoder (RFC 8949) appending into a caller-owned buffer.
+// The buffer is never shrunk, so once it has grown to the working size
+// encoding a message performs no heap allocation.
+//
+// Output is canonical (shortest length headers, floats narrowed to single
+// precision when lossless), i.e. the same bytes nlohmann::json::to_cbor
+// produces for the same values in the same key order.
+class CborWriter {
+public:
+    explicit CborWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void beginMap(size_t pairs)   { writeHead(5, pairs); }
+    void beginArray(size_t items) { writeHead(4, items); }
+
+    void writeText(const char* s);
+    void writeText(const char* s, size_t len);
+    void writeUInt(uint64_t v)    { writeHead(0, v); }
+    void writeInt(int64_t v);
+    void writeDouble(double v);
+    void writeBool(bool v)        { out_.push_back(v ? 0xF5 : 0xF4); }
+    void writeNull()              { out_.push_back(0xF6); }
+
+    // Transcode one JSON text value into a single CBOR data item, in one
+    // pass and without building a DOM. On malformed input nothing is
+    // appended and false is returned.
+    bool writeJsonText(const char* json);
+
+    size_t size() const { return out_.size(); }
+
+private:
+    void writeHead(uint8_t major, uint64_t v);
+    // Rewrite the head at 'pos' (which currently occupies 'reserved' bytes)
+    // to its canonical width for value 'v', shifting the tail if needed.
+    void patchHead(size_t pos, size_t reserved, uint8_t major, uint64_t v);
+
+    bool jsonValue(const char*& p, int depth);
+    bool jsonString(const char*& p);
+    bool jsonNumber(const char*& p);
+
+    std::vector<uint8_t>& out_;
+};
@@ -0,0 +1,266 @@
+#include "DispatchPool.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <sysLib.h>
+#include <tickLib.h>
+}
+#else
+#include <chrono>
+#endif
+
+// Monotonic timestamp in ns for the dispatch latency counters
+static uint64_t dispatch_now_ns() {
+#if defined(_VXWORKS_)
+    unsigned long t = tickGet(); int r = sysClkRateGet();
+    return (uint64_t)t * (1000000000ULL / (r > 0 ? r : 1));
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void atomic_max(std::atomic<uint64_t>& a, uint64_t v) {
+    uint64_t cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+    }
+}
+
+DispatchPool::Worker::Worker()
+    : pool(nullptr)
+    , index(0)
+    , head(0)
+    , count(0)
+    , stop(false)
+#ifdef _VXWORKS_
+    , task(TASK_ID_ERROR)
+#endif
+    , depth(0)
+    , high_water(0)
+    , enqueued(0)
+    , dropped(0)
+    , dispatched(0)
+    , latency_ns_total(0)
+    , latency_ns_max(0)
+{
+#ifdef _VXWORKS_
+    lock = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+    items = semCCreate(SEM_Q_FIFO, 0);
+    done = semBCreate(SEM_Q_FIFO, SEM_EMPTY);
+#endif
+}
+
+DispatchPool::Worker::~Worker() {
+#ifdef _VXWORKS_
+    if (lock) semDelete(lock);
+    if (items) semDelete(items);
+    if (done) semDelete(done);
+#endif
+}
+
+DispatchPool::DispatchPool()
+    : queue_depth_(kDefaultQueueDepth)
+    , handler_(nullptr)
+    , ctx_(nullptr)
+{
+}
+
+DispatchPool::~DispatchPool() {
+    stop();
+}
+
+bool DispatchPool::start(uint32_t workers, uint32_t queue_depth, uint32_t task_priority, uint32_t task_stack,
+                         Handler handler, void* ctx) {
+    if (running() || workers == 0 || !handler) return false;
+    if (workers > LEGACY_DISPATCH_MAX_WORKERS) workers = LEGACY_DISPATCH_MAX_WORKERS;
+    queue_depth_ = (queue_depth > 0) ? queue_depth : kDefaultQueueDepth;
+    handler_ = handler;
+    ctx_ = ctx;
+
+    for (uint32_t i = 0; i < workers; ++i) {
+        Worker* w = new Worker();
+        w->pool = this;
+        w->index = i;
+        w->ring.resize(queue_depth_);
+        workers_.push_back(w);
+    }
+#ifdef _VXWORKS_
+    int priority = (task_priority > 0) ? (int)task_priority : 110;
+    int stackSize = (task_stack > 0) ? (int)task_stack : 32768;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        char name[16];
+        snprintf(name, sizeof(name), "tIpcDisp%u", (unsigned)i);
+        workers_[i]->task = taskSpawn(name, priority, 0, stackSize,
+                                      (FUNCPTR)&DispatchPool::taskEntry,
+                                      (int)(uintptr_t)workers_[i],
+                                      0, 0, 0, 0, 0, 0, 0, 0, 0);
+        if (workers_[i]->task == TASK_ID_ERROR) {
+            stop();
+            return false;
+        }
+    }
+#else
+    (void)task_priority;
+    (void)task_stack;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&DispatchPool::workerLoop, this, workers_[i]);
+    }
+#endif
+    return true;
+}
+
+void DispatchPool::stop() {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        Worker* w = workers_[i];
+#ifdef _VXWORKS_
+        if (w->task != TASK_ID_ERROR) {
+            semTake(w->lock, WAIT_FOREVER);
+            w->stop = true;
+            semGive(w->lock);
+            semGive(w->items);
+            // A callback still running gets a grace period, like tIpcRecv in close()
+            int rate = sysClkRateGet();
+            if (semTake(w->done, 2 * (rate > 0 ? rate : 60)) != OK && taskIdVerify(w->task) == OK) {
+                taskDelete(w->task);
+            }
+            w->task = TASK_ID_ERROR;
+        }
+#else
+        {
+            std::lock_guard<std::mutex> lk(w->lock);
+            w->stop = true;
+        }
+        w->cond.notify_one();
+        if (w->thread.joinable()) w->thread.join();
+#endif
+        delete w;
+    }
+    workers_.clear();
+}
+
+uint32_t DispatchPool::shardOf(const char* topic, size_t len) const {
+    if (workers_.size() <= 1) return 0;
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (uint8_t)topic[i];
+        h *= 16777619u;
+    }
+    return h % (uint32_t)workers_.size();
+}
+
+bool DispatchPool::enqueue(uint32_t worker, const uint8_t* payload, size_t len, const Item& spans) {
+    if (worker >= workers_.size()) return false;
+    Worker* w = workers_[worker];
+#ifdef _VXWORKS_
+    semTake(w->lock, WAIT_FOREVER);
+#else
+    std::unique_lock<std::mutex> lk(w->lock);
+#endif
+    if (w->count == w->ring.size()) {
+#ifdef _VXWORKS_
+        semGive(w->lock);
+#endif
+        w->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // The slot is free: the worker only touches items counted in 'count'
+    Item& it = w->ring[(w->head + w->count) % w->ring.size()];
+    it.payload.assign(payload, payload + len);
+    it.topic_off = spans.topic_off;
+    it.topic_len = spans.topic_len;
+    it.type_off = spans.type_off;
+    it.type_len = spans.type_len;
+    it.data_off = spans.data_off;
+    it.data_len = spans.data_len;
+    it.topic_handle = spans.topic_handle;
+    it.enqueue_ns = dispatch_now_ns();
+    uint32_t depth = (uint32_t)++w->count;
+    w->depth.store(depth, std::memory_order_relaxed);
+#ifdef _VXWORKS_
+    semGive(w->lock);
+    semGive(w->items);
+#else
+    lk.unlock();
+    w->cond.notify_one();
+#endif
+    if (depth > w->high_water.load(std::memory_order_relaxed)) {
+        w->high_water.store(depth, std::memory_order_relaxed);   // single producer
+    }
+    w->enqueued.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+#ifdef _VXWORKS_
+void DispatchPool::taskEntry(uintptr_t arg) {
+    Worker* w = reinterpret_cast<Worker*>(arg);
+    if (w) {
+        w->pool->workerLoop(w);
+        semGive(w->done);
+    }
+}
+#endif
+
+void DispatchPool::workerLoop(Worker* w) {
+    for (;;) {
+        const Item* item;
+#ifdef _VXWORKS_
+        semTake(w->items, WAIT_FOREVER);
+        semTake(w->lock, WAIT_FOREVER);
+        if (w->stop || w->count == 0) {
+            bool stop = w->stop;
+            semGive(w->lock);
+            if (stop) break;
+            continue;
+        }
+        item = &w->ring[w->head];
+        semGive(w->lock);
+#else
+        {
+            std::unique_lock<std::mutex> lk(w->lock);
+            w->cond.wait(lk, [w] { return w->stop || w->count > 0; });
+            if (w->stop) break;
+            item = &w->ring[w->head];
+        }
+#endif
+        uint64_t now = dispatch_now_ns();
+        uint64_t latency = (now > item->enqueue_ns) ? (now - item->enqueue_ns) : 0;
+        w->latency_ns_total.fetch_add(latency, std::memory_order_relaxed);
+        atomic_max(w->latency_ns_max, latency);
+
+        handler_(ctx_, w->index, *item);
+        w->dispatched.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef _VXWORKS_
+        semTake(w->lock, WAIT_FOREVER);
+#else
+        std::lock_guard<std::mutex> lk(w->lock);
+#endif
+        w->head = (w->head + 1) % w->ring.size();
+        --w->count;
+        w->depth.store((uint32_t)w->count, std::memory_order_relaxed);
+#ifdef _VXWORKS_
+        semGive(w->lock);
+#endif
+    }
+}
+
+void DispatchPool::getStats(LegacyDispatchStats* out) const {
+    memset(out, 0, sizeof(*out));
+    out->workers = (uint32_t)workers_.size();
+    out->queue_capacity = workers_.empty() ? 0 : queue_depth_;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        const Worker* w = workers_[i];
+        out->queue_depth[i] = w->depth.load(std::memory_order_relaxed);
+        out->queue_high_water[i] = w->high_water.load(std::memory_order_relaxed);
+        out->dropped[i] = w->dropped.load(std::memory_order_relaxed);
+        out->enqueued_total += w->enqueued.load(std::memory_order_relaxed);
+        out->dropped_total += out->dropped[i];
+        out->dispatched_total += w->dispatched.load(std::memory_order_relaxed);
+        out->latency_ns_total += w->latency_ns_total.load(std::memory_order_relaxed);
+        uint64_t m = w->latency_ns_max.load(std::memory_order_relaxed);
+        if (m > out->latency_ns_max) out->latency_ns_max = m;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "legacy_agent.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <vxWorks.h>
+#include <semLib.h>
+#include <taskLib.h>
+}
+#else
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+// Worker tasks that run subscription callbacks off the receive task.
+//
+// Each worker owns a bounded FIFO of received events. Events are sharded by
+// topic hash, so every topic is handled by one worker in arrival order while
+// different topics proceed in parallel. The receive task never blocks on a
+// full queue: the event is dropped and counted instead.
+class DispatchPool {
+public:
+    // One queued event: a copy of the CBOR payload plus the envelope fields
+    // located by the receive task (offsets into payload)
+    struct Item {
+        std::vector<uint8_t> payload;   // capacity is reused from slot to slot
+        uint32_t topic_off, topic_len;
+        uint32_t type_off, type_len;
+        uint32_t data_off, data_len;    // data_len 0: no "data" item
+        uint32_t topic_handle;          // TopicRegistry handle of topic/type
+        uint64_t enqueue_ns;
+    };
+    // Runs on worker 'worker' for every dequeued item
+    typedef void (*Handler)(void* ctx, uint32_t worker, const Item& item);
+
+    static const uint32_t kDefaultQueueDepth = 256;
+
+    DispatchPool();
+    ~DispatchPool();
+
+    // Spawn 'workers' tasks (capped at LEGACY_DISPATCH_MAX_WORKERS)
+    bool start(uint32_t workers, uint32_t queue_depth, uint32_t task_priority, uint32_t task_stack,
+               Handler handler, void* ctx);
+    // Stop and join the workers; events still queued are discarded
+    void stop();
+
+    bool running() const { return workers_.size() > 0; }
+    uint32_t workerCount() const { return (uint32_t)workers_.size(); }
+    uint32_t shardOf(const char* topic, size_t len) const;
+
+    // Receive task: copy the event into the worker's queue (false: queue full)
+    bool enqueue(uint32_t worker, const uint8_t* payload, size_t len, const Item& spans);
+
+    void getStats(LegacyDispatchStats* out) const;
+
+private:
+    struct Worker {
+        Worker();
+        ~Worker();
+        DispatchPool* pool;
+        uint32_t index;
+        std::vector<Item> ring;
+        size_t head;                    // next item to run
+        size_t count;                   // queued, including the one running
+        bool stop;
+#ifdef _VXWORKS_
+        SEM_ID lock;
+        SEM_ID items;                   // counting: one give per enqueued item
+        SEM_ID done;                    // given when the task leaves its loop
+        TASK_ID task;
+#else
+        std::mutex lock;
+        std::condition_variable cond;
+        std::thread thread;
+#endif
+        std::atomic<uint32_t> depth;
+        std::atomic<uint32_t> high_water;
+        std::atomic<uint64_t> enqueued;
+        std::atomic<uint64_t> dropped;
+        std::atomic<uint64_t> dispatched;
+        std::atomic<uint64_t> latency_ns_total;
+        std::atomic<uint64_t> latency_ns_max;
+    };
+
+#ifdef _VXWORKS_
+    static void taskEntry(uintptr_t arg);
+#endif
+    void workerLoop(Worker* w);
+
+    std::vector<Worker*> workers_;
+    uint32_t queue_depth_;
+    Handler handler_;
+    void* ctx_;
+
+    DispatchPool(const DispatchPool&) = delete;
+    DispatchPool& operator=(const DispatchPool&) = delete;
+};
@@ -66,7 +66,10 @@ static uint64_t now_ns() {
 }
 // ----------------------------
 
-DkmRtpIpc::DkmRtpIpc() : sock_(INVALID_SOCKET), initialized_(false) {
+DkmRtpIpc::DkmRtpIpc()
+    : sock_(INVALID_SOCKET), initialized_(false)
+    , batch_used_(0), batch_max_frames_(0), batch_delay_ms_(0), batch_first_ns_(0)
+    , burst_saved_max_frames_(-1) {
     memset(&dest_addr_, 0, sizeof(dest_addr_));
 }
 
@@ -119,6 +122,23 @@ bool DkmRtpIpc::init(const char* ip, uint16_t port) {
         return false;
     }
 
+    // Preallocate receive slots once; receiveBatch() never allocates
+    recv_slots_.assign((size_t)kRecvBatchSlots * kRecvSlotSize, 0);
+    recv_hdrs_.assign((size_t)kRecvBatchSlots * sizeof(Header), 0);
+#if defined(__linux__)
+    recv_iov_.resize((size_t)kRecvBatchSlots * 2);
+    recv_msgs_.resize(kRecvBatchSlots);
+    for (int i = 0; i < kRecvBatchSlots; ++i) {
+        recv_iov_[i * 2].iov_base = &recv_hdrs_[i * sizeof(Header)];
+        recv_iov_[i * 2].iov_len = sizeof(Header);
+        recv_iov_[i * 2 + 1].iov_base = &recv_slots_[i * kRecvSlotSize];
+        recv_iov_[i * 2 + 1].iov_len = kRecvSlotSize;
+        memset(&recv_msgs_[i], 0, sizeof(recv_msgs_[i]));
+        recv_msgs_[i].msg_hdr.msg_iov = &recv_iov_[i * 2];
+        recv_msgs_[i].msg_hdr.msg_iovlen = 2;
+    }
+#endif
+
     initialized_ = true;
     // Log via global legacy agent callback if present
     dap_log(2, "[DkmRtpIpc] Socket Initialized. Default Destination: %s:%u", ip, port);
@@ -127,6 +147,7 @@ bool DkmRtpIpc::init(const char* ip, uint16_t port) {
 
 void DkmRtpIpc::close() {
     if (sock_ != INVALID_SOCKET) {
+        flush();
         closesocket(sock_);
         sock_ = INVALID_SOCKET;
     }
@@ -150,6 +171,29 @@ bool DkmRtpIpc::send(const void* data, size_t len, uint16_t type, uint32_t corr_
     h.length = htonl((uint32_t)len);
     h.ts_ns = htonll(now_ns());
 
+    if (batch_max_frames_ > 1) {
+        size_t frame_len = sizeof(Header) + len;
+        if (frame_len <= kSendArenaSize) {
+            if (batch_used_ + frame_len > kSendArenaSize && !flush()) return false;
+            // Header and payload are packed back to back: one iovec per frame
+            BatchFrame f;
+            f.offset = batch_used_;
+            f.len = frame_len;
+            memcpy(&batch_arena_[batch_used_], &h, sizeof(Header));
+            if (len > 0) memcpy(&batch_arena_[batch_used_ + sizeof(Header)], data, len);
+            batch_used_ += frame_len;
+            if (batch_frames_.empty()) batch_first_ns_ = now_ns();
+            batch_frames_.push_back(f); // capacity reserved, no allocation
+            if ((int)batch_frames_.size() >= batch_max_frames_) return flush();
+            return true;
+        }
+        // Oversized frame: keep ordering, then send it on its own
+        if (!flush()) return false;
+    }
+    return sendDirect(&h, data, len);
+}
+
+bool DkmRtpIpc::sendDirect(const void* hdr, const void* data, size_t len) {
 #if defined(_WIN32)
     // For Windows use simple send() (WSASend alternative could be used)
 #else
@@ -162,14 +206,14 @@ bool DkmRtpIpc::send(const void* data, size_t len, uint16_t type, uint32_t corr_
 #if defined(_WIN32)
     // Fallback: keep existing simple send on Windows
     std::vector<uint8_t> packet(sizeof(Header) + len);
-    memcpy(packet.data(), &h, sizeof(Header));
+    memcpy(packet.data(), hdr, sizeof(Header));
     if (len > 0) memcpy(packet.data() + sizeof(Header), data, len);
     sent = ::send(sock_, (const char*)packet.data(), (int)packet.size(), 0);
 #else
     struct msghdr msg;
     struct iovec iov[2];
     memset(&msg, 0, sizeof(msg));
-    iov[0].iov_base = (void*)&h;
+    iov[0].iov_base = (void*)hdr;
     iov[0].iov_len = sizeof(Header);
     iov[1].iov_base = (void*)data;
     iov[1].iov_len = len;
@@ -203,6 +247,118 @@ bool DkmRtpIpc::send(const void* data, size_t len, uint16_t type, uint32_t corr_
     return true;
 }
 
+bool DkmRtpIpc::setSendBatching(int max_frames, uint32_t max_delay_ms) {
+    // Whatever is queued leaves under the old settings
+    bool ok = flush();
+    if (max_frames > kSendBatchMaxFrames) max_frames = kSendBatchMaxFrames;
+    if (max_frames <= 1) {
+        batch_max_frames_ = 0;
+        batch_delay_ms_ = 0;
+        dap_log(2, "[DkmRtpIpc] Send batching disabled");
+        return ok;
+    }
+    allocBatchArena();
+    batch_max_frames_ = max_frames;
+    batch_delay_ms_ = max_delay_ms;
+    dap_log(2, "[DkmRtpIpc] Send batching enabled: max_frames=%d, max_delay=%u ms", max_frames, max_delay_ms);
+    return ok;
+}
+
+void DkmRtpIpc::allocBatchArena() {
+    if (!batch_arena_.empty()) return;
+    batch_arena_.assign(kSendArenaSize, 0);
+    batch_frames_.reserve(kSendBatchMaxFrames);
+#if defined(__linux__)
+    batch_iov_.resize(kSendBatchMaxFrames);
+    batch_msgs_.resize(kSendBatchMaxFrames);
+    for (int i = 0; i < kSendBatchMaxFrames; ++i) {
+        memset(&batch_msgs_[i], 0, sizeof(batch_msgs_[i]));
+        batch_msgs_[i].msg_hdr.msg_iov = &batch_iov_[i];
+        batch_msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+void DkmRtpIpc::beginBurst() {
+    if (burst_saved_max_frames_ >= 0) return; // already in a burst
+    allocBatchArena();
+    burst_saved_max_frames_ = batch_max_frames_;
+    batch_max_frames_ = kSendBatchMaxFrames;
+}
+
+bool DkmRtpIpc::endBurst() {
+    if (burst_saved_max_frames_ < 0) return true;
+    bool ok = flush();
+    batch_max_frames_ = burst_saved_max_frames_;
+    burst_saved_max_frames_ = -1;
+    return ok;
+}
+
+bool DkmRtpIpc::flush() {
+    if (batch_frames_.empty()) return true;
+    size_t n = batch_frames_.size();
+    size_t bytes = batch_used_;
+    bool ok = initialized_ && sock_ != INVALID_SOCKET;
+
+#ifdef DEMO_PERF_INSTRUMENTATION
+    auto t0 = std::chrono::steady_clock::now();
+#endif
+    uint32_t calls = 0;
+#if defined(__linux__)
+    for (size_t i = 0; i < n; ++i) {
+        batch_iov_[i].iov_base = &batch_arena_[batch_frames_[i].offset];
+        batch_iov_[i].iov_len = batch_frames_[i].len;
+    }
+    size_t done = 0;
+    while (ok && done < n) {
+        int r = sendmmsg(sock_, &batch_msgs_[done], (unsigned int)(n - done), 0);
+        calls++;
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            dap_log(4, "[DkmRtpIpc] sendmmsg failed. Error: %d", errno);
+            ok = false;
+            break;
+        }
+        done += (size_t)r;
+    }
+#else
+    for (size_t i = 0; ok && i < n; ++i) {
+        calls++;
+        if (::send(sock_, (const char*)&batch_arena_[batch_frames_[i].offset], (int)batch_frames_[i].len, 0) == SOCKET_ERROR) {
+#ifdef _WIN32
+            dap_log(4, "[DkmRtpIpc] send failed. Error: %d", WSAGetLastError());
+#else
+            dap_log(4, "[DkmRtpIpc] send failed. Error: %d", errno);
+#endif
+            ok = false;
+        }
+    }
+#endif
+#ifdef DEMO_PERF_INSTRUMENTATION
+    auto t1 = std::chrono::steady_clock::now();
+    auto send_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    send_us_total_.fetch_add((uint64_t)send_us);
+    send_count_.fetch_add(calls);
+    batch_flush_count_.fetch_add(1);
+    batch_frame_count_.fetch_add((uint32_t)n);
+#else
+    (void)calls;
+#endif
+
+    dap_log(1, "[DkmRtpIpc] Flushed %zu frames (%zu bytes)", n, bytes);
+    // Frames are dropped on failure, as a failed datagram send would be
+    batch_frames_.clear();
+    batch_used_ = 0;
+    return ok;
+}
+
+bool DkmRtpIpc::flushIfDue() {
+    uint32_t delay_ms = batch_delay_ms_.load();
+    if (batch_frames_.empty() || delay_ms == 0) return true;
+    if (now_ns() - batch_first_ns_ < (uint64_t)delay_ms * 1000000ULL) return true;
+    return flush();
+}
+
 void DkmRtpIpc::getPerfStats(uint64_t* out_send_us_total, uint32_t* out_send_count) const {
     if (out_send_us_total) *out_send_us_total = 0;
     if (out_send_count) *out_send_count = 0;
@@ -212,7 +368,50 @@ void DkmRtpIpc::getPerfStats(uint64_t* out_send_us_total, uint32_t* out_send_cou
 #endif
 }
 
+void DkmRtpIpc::getBatchStats(uint32_t* out_flush_count, uint32_t* out_frame_count) const {
+    if (out_flush_count) *out_flush_count = 0;
+    if (out_frame_count) *out_frame_count = 0;
+#ifdef DEMO_PERF_INSTRUMENTATION
+    if (out_flush_count) *out_flush_count = batch_flush_count_.load();
+    if (out_frame_count) *out_frame_count = batch_frame_count_.load();
+#endif
+}
+
+// Validate a received header against the datagram size. Returns payload length,
+// or 0 if the frame must be ignored.
+static int validate_frame(const Header& h, int bytes, DkmRtpIpc::FrameInfo* info) {
+    if (bytes < (int)sizeof(Header)) {
+        dap_log(4, "[DkmRtpIpc] Received packet too small for header: %d", bytes);
+        return 0; // Ignore invalid packet
+    }
+
+    uint32_t magic = ntohl(h.magic);
+    if (magic != MAGIC_VALUE) {
+        dap_log(4, "[DkmRtpIpc] Invalid Magic: 0x%08x", magic);
+        return 0; // Ignore invalid packet
+    }
+
+    uint32_t payload_len = ntohl(h.length);
+    if ((uint32_t)(bytes - (int)sizeof(Header)) < payload_len) {
+        dap_log(4, "[DkmRtpIpc] Incomplete payload. Expected: %u, Got: %d", payload_len, (bytes - (int)sizeof(Header)));
+        return 0;
+    }
+
+    if (info) {
+        info->type = ntohs(h.type);
+        info->corr_id = ntohl(h.corr_id);
+        info->ts_ns = ntohll(h.ts_ns);
+    }
+
+    dap_log(1, "[DkmRtpIpc] Recv Valid Packet. Payload: %u bytes", payload_len);
+    return (int)payload_len;
+}
+
 int DkmRtpIpc::receive(void* buffer, size_t max_len, int timeout_ms) {
+    return receiveFrame(buffer, max_len, timeout_ms, nullptr);
+}
+
+int DkmRtpIpc::receiveFrame(void* buffer, size_t max_len, int timeout_ms, FrameInfo* info) {
     if (!initialized_ || sock_ == INVALID_SOCKET) return -1;
 
     fd_set readfds;
@@ -225,39 +424,40 @@ int DkmRtpIpc::receive(void* buffer, size_t max_len, int timeout_ms) {
 
     int ret = select((int)sock_ + 1, &readfds, NULL, NULL, &tv);
     if (ret > 0) {
-        // We need to read the full packet (Header + Payload)
-        // But the user buffer might be too small for both.
-        // For simplicity, let's peek or read into a temp buffer.
-        std::vector<uint8_t> recv_buf(sizeof(Header) + max_len); 
+        // Scatter the datagram: header into a stack struct, payload straight
+        // into the caller's buffer. A payload larger than max_len is truncated
+        // by the kernel and rejected by the length check in validate_frame().
+        Header h;
+        int bytes = 0;
+#ifdef _WIN32
+        WSABUF bufs[2];
+        bufs[0].buf = (char*)&h;
+        bufs[0].len = sizeof(Header);
+        bufs[1].buf = (char*)buffer;
+        bufs[1].len = (ULONG)max_len;
+        DWORD got = 0;
+        DWORD flags = 0;
+        if (WSARecv(sock_, bufs, 2, &got, &flags, NULL, NULL) == SOCKET_ERROR) {
+            // A truncated datagram still delivers the bytes that fit
+            bytes = (WSAGetLastError() == WSAEMSGSIZE) ? (int)got : SOCKET_ERROR;
+        } else {
+            bytes = (int)got;
+        }
+#else
+        struct msghdr msg;
+        struct iovec iov[2];
+        memset(&msg, 0, sizeof(msg));
+        iov[0].iov_base = (void*)&h;
+        iov[0].iov_len = sizeof(Header);
+        iov[1].iov_base = buffer;
+        iov[1].iov_len = max_len;
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        bytes = (int)recvmsg(sock_, &msg, 0);
+#endif
 
-        int bytes = ::recv(sock_, (char*)recv_buf.data(), (int)recv_buf.size(), 0);
-        
         if (bytes > 0) {
-            if (bytes < sizeof(Header)) {
-                    dap_log(4, "[DkmRtpIpc] Received packet too small for header: %d", bytes);
-                    return 0; // Ignore invalid packet
-                }
-
-            Header* h = (Header*)recv_buf.data();
-            uint32_t magic = ntohl(h->magic);
-            if (magic != MAGIC_VALUE) {
-                dap_log(4, "[DkmRtpIpc] Invalid Magic: 0x%08x", magic);
-                return 0; // Ignore invalid packet
-            }
-
-            uint32_t payload_len = ntohl(h->length);
-              if (bytes - sizeof(Header) < payload_len) {
-                  dap_log(4, "[DkmRtpIpc] Incomplete payload. Expected: %u, Got: %d", payload_len, (bytes - (int)sizeof(Header)));
-                  return 0;
-              }
-
-            // Copy payload to user buffer
-            size_t copy_len = (payload_len < max_len) ? payload_len : max_len;
-            memcpy(buffer, recv_buf.data() + sizeof(Header), copy_len);
-            
-            dap_log(1, "[DkmRtpIpc] Recv Valid Packet. Payload: %zu bytes", copy_len);
-            return (int)copy_len;
-
+            return validate_frame(h, bytes, info);
         } else if (bytes == SOCKET_ERROR) {
 #ifdef _WIN32
             int err = WSAGetLastError();
@@ -274,12 +474,60 @@ int DkmRtpIpc::receive(void* buffer, size_t max_len, int timeout_ms) {
         return bytes;
     } else if (ret == 0) {
         return 0; // Timeout
-        } else {
-    #ifdef _WIN32
+    } else {
+#ifdef _WIN32
         dap_log(4, "[DkmRtpIpc] select error: %d", WSAGetLastError());
-    #else
+#else
         dap_log(4, "[DkmRtpIpc] select error: %d", errno);
-    #endif
+#endif
         return -1; // Error
-        }
+    }
+}
+
+int DkmRtpIpc::receiveBatch(int timeout_ms, FrameView* out, int max_out) {
+    if (!initialized_ || sock_ == INVALID_SOCKET || !out || max_out <= 0) return -1;
+    if (max_out > kRecvBatchSlots) max_out = kRecvBatchSlots;
+
+#if defined(__linux__)
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    FD_SET(sock_, &readfds);
+
+    struct timeval tv;
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+    int ret = select((int)sock_ + 1, &readfds, NULL, NULL, &tv);
+    if (ret == 0) return 0; // Timeout
+    if (ret < 0) {
+        dap_log(4, "[DkmRtpIpc] select error: %d", errno);
+        return -1;
+    }
+
+    // One syscall drains everything already queued (up to max_out datagrams)
+    int n = recvmmsg(sock_, recv_msgs_.data(), (unsigned int)max_out, MSG_DONTWAIT, NULL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        dap_log(4, "[DkmRtpIpc] recvmmsg failed. Error: %d", errno);
+        return -1;
+    }
+
+    int valid = 0;
+    for (int i = 0; i < n; ++i) {
+        const Header* h = (const Header*)&recv_hdrs_[i * sizeof(Header)];
+        int len = validate_frame(*h, (int)recv_msgs_[i].msg_len, &out[valid].info);
+        if (len <= 0) continue;
+        out[valid].data = &recv_slots_[i * kRecvSlotSize];
+        out[valid].len = len;
+        ++valid;
+    }
+    return valid;
+#else
+    // No recvmmsg: one scatter receive into slot 0
+    int len = receiveFrame(recv_slots_.data(), kRecvSlotSize, timeout_ms, &out[0].info);
+    if (len <= 0) return len;
+    out[0].data = recv_slots_.data();
+    out[0].len = len;
+    return 1;
+#endif
 }
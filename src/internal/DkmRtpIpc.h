@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include <vector>
 #include <atomic>
 
 #ifdef _WIN32
@@ -24,6 +25,32 @@ typedef int DkmSocket;
 
 class DkmRtpIpc {
 public:
+    // Decoded protocol header of a received frame (host byte order)
+    struct FrameInfo {
+        uint16_t type;
+        uint32_t corr_id;
+        uint64_t ts_ns;
+    };
+
+    // Payload view of one frame taken by receiveBatch()
+    struct FrameView {
+        const uint8_t* data;
+        int len;
+        FrameInfo info;
+    };
+
+    // Preallocated receive slots (datagrams drained per wakeup) and slot payload size
+#if defined(__linux__)
+    static const int kRecvBatchSlots = 8;
+#else
+    static const int kRecvBatchSlots = 1;
+#endif
+    static const size_t kRecvSlotSize = 65535;
+
+    // Send batching limits: frames per flush and bytes (header+payload) per flush
+    static const int kSendBatchMaxFrames = 64;
+    static const size_t kSendArenaSize = 65536;
+
     DkmRtpIpc();
     ~DkmRtpIpc();
 
@@ -32,15 +59,67 @@ public:
     
     bool send(const void* data, size_t len, uint16_t type = 0x1000, uint32_t corr_id = 0);
     int receive(void* buffer, size_t max_len, int timeout_ms);
+    // Scatter receive: the header lands on the stack and the payload directly in
+    // 'buffer' (no intermediate allocation/copy). Returns payload length, 0 on
+    // timeout/invalid frame, -1 on error. 'info' (optional) gets the header fields.
+    int receiveFrame(void* buffer, size_t max_len, int timeout_ms, FrameInfo* info);
+    // Batched receive: waits up to timeout_ms, then drains up to max_out queued
+    // datagrams in one recvmmsg call (Linux; one frame per call elsewhere).
+    // Views point into transport-owned slots and stay valid until the next call.
+    // Returns number of valid frames, 0 on timeout, -1 on error.
+    int receiveBatch(int timeout_ms, FrameView* out, int max_out);
+    // Opt-in send batching. While enabled, send() packs frames (header unchanged,
+    // ts_ns stamped at enqueue) into an arena; they leave in one sendmmsg call
+    // (Linux; one send per frame elsewhere) when max_frames are queued, the arena
+    // is full, flushIfDue() sees max_delay_ms elapsed, or flush() is called.
+    // max_frames <= 1 disables batching after flushing what is queued.
+    // Not thread-safe: callers serialize send()/flush() (IpcJsonClient send lock).
+    bool setSendBatching(int max_frames, uint32_t max_delay_ms);
+    bool flush();
+    bool flushIfDue();
+    // Pipelined burst: frames sent between beginBurst() and endBurst() are
+    // queued (whatever the batching setting) and leave together at endBurst(),
+    // which restores the previous setting. Same locking rule as send().
+    void beginBurst();
+    bool endBurst();
+    uint32_t sendBatchDelayMs() const { return batch_delay_ms_.load(); }
     // Perf stats accessor (filled when DEMO_PERF_INSTRUMENTATION is enabled)
     void getPerfStats(uint64_t* out_send_us_total, uint32_t* out_send_count) const;
+    void getBatchStats(uint32_t* out_flush_count, uint32_t* out_frame_count) const;
 
 private:
     DkmSocket sock_;
     struct sockaddr_in dest_addr_;
     bool initialized_;
+    // Receive slots for receiveBatch() (allocated once in init)
+    std::vector<uint8_t> recv_slots_;
+    std::vector<uint8_t> recv_hdrs_;
+#if defined(__linux__)
+    std::vector<struct iovec> recv_iov_;
+    std::vector<struct mmsghdr> recv_msgs_;
+#endif
+    // Send batching state (arena and message arrays preallocated when enabled)
+    struct BatchFrame {
+        size_t offset;
+        size_t len;
+    };
+    std::vector<uint8_t> batch_arena_;
+    std::vector<BatchFrame> batch_frames_;
+    size_t batch_used_;
+    int batch_max_frames_;
+    std::atomic<uint32_t> batch_delay_ms_; // read by the receive task without the send lock
+    uint64_t batch_first_ns_;
+#if defined(__linux__)
+    std::vector<struct iovec> batch_iov_;
+    std::vector<struct mmsghdr> batch_msgs_;
+#endif
+    int burst_saved_max_frames_;           // batch_max_frames_ to restore, -1 outside a burst
+    void allocBatchArena();
+    bool sendDirect(const void* hdr, const void* data, size_t len);
     // Perf accumulation
     // Use atomics to avoid depending on std::mutex on all platforms
     mutable std::atomic<uint64_t> send_us_total_{0};
     mutable std::atomic<uint32_t> send_count_{0};
+    mutable std::atomic<uint32_t> batch_flush_count_{0};
+    mutable std::atomic<uint32_t> batch_frame_count_{0};
 };
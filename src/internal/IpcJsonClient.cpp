@@ -1,4 +1,7 @@
 #include "IpcJsonClient.h"
+#include "CborWriter.h"
+#include "CborReader.h"
+#include "StructCodec.h"
 #include <iostream>
 #include <cstring>
 #include <sstream>
@@ -9,24 +12,38 @@
 #include <sockLib.h>
 #include <inetLib.h>
 #include <tickLib.h>
-// VxWorks mbuf.h defines m_data and m_type macros which conflict with nlohmann json
-// Undefine them before including json.hpp
-#ifdef m_data
-#undef m_data
-#endif
-#ifdef m_type
-#undef m_type
-#endif
 #else
 #include <arpa/inet.h>
 #endif
 
-#include "json.hpp"
-
 using json = nlohmann::json;
 #include <chrono>
 #include <cstdarg>
 
+// Monotonic time in ms for request deadlines
+static uint64_t mono_ms() {
+#if defined(_VXWORKS_)
+    int r = sysClkRateGet();
+    return (uint64_t)tickGet() * 1000ULL / (uint64_t)(r > 0 ? r : 1);
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+#ifdef DEMO_PERF_INSTRUMENTATION
+// Monotonic timestamp in ns for perf accumulation
+static uint64_t perf_now_ns() {
+#if defined(_VXWORKS_)
+    unsigned long t = tickGet(); int r = sysClkRateGet();
+    return (uint64_t)t * (1000000000ULL / (r > 0 ? r : 1));
+#else
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+#endif
+
 // Simple JSON helper for Phase 1 (Replace with real lib later)
 static uint32_t extract_req_id(const std::string& json) {
     std::string key = "\"req_id\":";
@@ -74,18 +91,16 @@ IpcJsonClient::IpcJsonClient()
     , next_req_id_(1)
 {
 #ifdef _VXWORKS_
-    req_sem_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
-    sub_sem_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
     adapter_sem_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+    send_sem_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
 #endif
 }
 
 IpcJsonClient::~IpcJsonClient() {
     close();
 #ifdef _VXWORKS_
-    if (req_sem_) semDelete(req_sem_);
-    if (sub_sem_) semDelete(sub_sem_);
     if (adapter_sem_) semDelete(adapter_sem_);
+    if (send_sem_) semDelete(send_sem_);
 #endif
 }
 
@@ -97,6 +112,18 @@ LegacyStatus IpcJsonClient::init(const LegacyConfig* cfg) {
         return LEGACY_ERR_TRANSPORT;
     }
     
+    if (cfg->dispatch_workers > 0) {
+        uint32_t workers = (cfg->dispatch_workers > LEGACY_DISPATCH_MAX_WORKERS) ? LEGACY_DISPATCH_MAX_WORKERS : cfg->dispatch_workers;
+        worker_scratch_.resize(workers);
+        for (uint32_t i = 0; i < workers; ++i) worker_scratch_[i].reader = 1 + i;
+        if (!dispatch_.start(workers, cfg->dispatch_queue_depth, cfg->dispatch_task_priority,
+                             cfg->dispatch_task_stack, &IpcJsonClient::dispatchWorkerEntry, this)) {
+            transport_.close();
+            logError("[IpcJsonClient] Failed to start dispatch workers");
+            return LEGACY_ERR_TRANSPORT;
+        }
+    }
+
     running_ = true;
     
 #ifdef _VXWORKS_
@@ -116,6 +143,7 @@ LegacyStatus IpcJsonClient::init(const LegacyConfig* cfg) {
     
     if (recv_task_ == TASK_ID_ERROR) {
         running_ = false;
+        dispatch_.stop();
         transport_.close();
         logError("[IpcJsonClient] Failed to spawn receive task");
         return LEGACY_ERR_TRANSPORT;
@@ -159,206 +187,487 @@ void IpcJsonClient::close() {
         recv_thread_.join();
     }
 #endif
+    // Nothing is queued any more; events still waiting are discarded
+    dispatch_.stop();
     
-    transport_.close();
+    {
+        // Frames still queued by send batching leave before the socket closes
+#ifdef _VXWORKS_
+        SemLockGuard lock(send_sem_);
+#else
+        std::lock_guard<std::mutex> lock(send_mutex_);
+#endif
+        transport_.close();
+    }
     logInfo("[IpcJsonClient] Closed");
 }
 
 uint32_t IpcJsonClient::generateRequestId() {
-    return next_req_id_++;
+    uint32_t id = next_req_id_++;
+    if (id == 0) id = next_req_id_++; // 0 means "no id" in replies
+    return id;
 }
 
-void IpcJsonClient::registerRequest(uint32_t reqId, const PendingRequest& req) {
-#ifdef _VXWORKS_
-    SemLockGuard lock(req_sem_);
-#else
-    std::lock_guard<std::mutex> lock(req_mutex_);
-#endif
-    pending_requests_[reqId] = req;
+LegacyStatus IpcJsonClient::registerRequest(uint32_t& reqId, const PendingRequest& req, uint32_t timeout_ms) {
+    if (timeout_ms == 0) timeout_ms = kDefaultTimeoutMs;
+    PendingRequest entry = req;
+    entry.deadline_ms = mono_ms() + timeout_ms;
+
+    // Overflow policy: the slot for reqId still holds a request issued
+    // PendingTable::kCapacity ids ago. Skip to fresh ids a few times, then
+    // report the table as full instead of evicting anything.
+    for (int attempt = 0; attempt < kRegisterAttempts; ++attempt) {
+        if (pending_.insert(reqId, entry)) return LEGACY_OK;
+        reqId = generateRequestId();
+    }
+    logError("[IpcJsonClient] Pending request table full (%u in flight)", PendingTable::kCapacity);
+    if (req.waiter) req.waiter->disarm(); // never registered: nothing will complete it
+    return LEGACY_ERR_BUSY;
+}
+
+LegacyStatus IpcJsonClient::abortRequest(uint32_t reqId, SyncWaiter* waiter, LegacyStatus st) {
+    if (pending_.cancel(reqId)) {
+        if (waiter) waiter->disarm(); // withdrawn: nothing will complete it
+        return st;
+    }
+    // Expired while the send was blocked: its callback reports the timeout
+    logError("[IpcJsonClient] Request %u not sent (status %d), already completed", reqId, (int)st);
+    return LEGACY_OK;
+}
+
+void IpcJsonClient::expireRequests() {
+    expired_.clear();
+    pending_.expire(mono_ms(), expired_);
+
+    // Callbacks run like normal responses, on the receive task
+    for (size_t i = 0; i < expired_.size(); ++i) {
+        const PendingRequest& req = expired_[i].second;
+        uint32_t req_id = expired_[i].first;
+        logError("[IpcJsonClient] Request %u timed out", req_id);
+
+        LegacySimpleResult res;
+        res.ok = false;
+        res.err = LEGACY_ERR_TIMEOUT;
+        res.msg = "timeout";
+        res.raw_json = ""; // legacy field, see legacy_*_raw_json()
+        res.priv = NULL;
+        if (req.waiter) {
+            completeSync(req.waiter, &res, -1, true);
+        } else if (req.hello_cb) {
+            LegacyHelloInfo info;
+            info.proto = -1;
+            info.caps_raw_json = "{}";
+            req.hello_cb(nullptr, req_id, &res, &info, req.user);
+        } else if (req.qos_cb) {
+            LegacyQosList list = { NULL, 0, "" };
+            req.qos_cb(nullptr, req_id, &res, &list, req.user);
+        } else if (req.simple_cb) {
+            req.simple_cb(nullptr, req_id, &res, req.user);
+        }
+    }
 }
 
 LegacyStatus IpcJsonClient::sendRequest(const std::string& json_body, uint16_t type, uint32_t req_id) {
-    // DkmRtpIpc now handles the protocol header (24 bytes).
-    // We convert JSON string to CBOR payload.
+    // Text entry point: parse once, then share the DOM encoder below.
+    json j;
     try {
 #ifdef DEMO_PERF_INSTRUMENTATION
-    uint64_t p0 = 0, p1 = 0, c0 = 0, c1 = 0;
-#if defined(_VXWORKS_)
-    unsigned long _t0 = tickGet(); int _tr = sysClkRateGet(); p0 = (uint64_t)_t0 * (1000000000ULL / (_tr > 0 ? _tr : 1));
-#else
-    struct timespec _ts0; clock_gettime(CLOCK_MONOTONIC, &_ts0); p0 = (uint64_t)_ts0.tv_sec*1000000000ULL + _ts0.tv_nsec;
-#endif
+        uint64_t p0 = perf_now_ns();
 #endif
-        json j = json::parse(json_body);
+        j = json::parse(json_body);
 #ifdef DEMO_PERF_INSTRUMENTATION
-#if defined(_VXWORKS_)
-    unsigned long _t1 = tickGet(); int _tr1 = sysClkRateGet(); p1 = (uint64_t)_t1 * (1000000000ULL / (_tr1 > 0 ? _tr1 : 1));
-#else
-    struct timespec _ts1; clock_gettime(CLOCK_MONOTONIC, &_ts1); p1 = (uint64_t)_ts1.tv_sec*1000000000ULL + _ts1.tv_nsec;
+        uint64_t p1 = perf_now_ns();
+        uint64_t parse_ns = (p1 > p0) ? (p1 - p0) : 0ULL;
+        logDebug("[PERF] IpcJsonClient parse=%llu us", (unsigned long long)(parse_ns/1000ULL));
+        parse_ns_total_.fetch_add(parse_ns);
+        parse_count_.fetch_add(1);
 #endif
+    } catch (const std::exception& e) {
+        logError("[IpcJsonClient] Failed to parse JSON: %s", e.what());
+        return LEGACY_ERR_PARAM;
+    }
+    return sendRequest(j, type, req_id);
+}
+
+LegacyStatus IpcJsonClient::sendRequest(const json& body, uint16_t type, uint32_t req_id) {
+#ifdef _VXWORKS_
+    SemLockGuard lock(send_sem_);
+#else
+    std::lock_guard<std::mutex> lock(send_mutex_);
 #endif
-        std::vector<uint8_t> cbor = json::to_cbor(j);
+    LegacyStatus st = encodeAndSend(body, type, req_id);
+    if (st != LEGACY_OK) return st;
+    // Control requests (hello/create/clear/qos) never wait in the send batch:
+    // a caller may block on the reply. Flushing here also sends any writes
+    // queued before it, so frame order is kept.
+    if (!transport_.flush()) return LEGACY_ERR_TRANSPORT;
+    return LEGACY_OK;
+}
+
+LegacyStatus IpcJsonClient::encodeAndSend(const json& body, uint16_t type, uint32_t req_id) {
+    // DkmRtpIpc handles the protocol header (24 bytes).
+    // The DOM is encoded to CBOR directly into the reused per-instance buffer.
+    try {
 #ifdef DEMO_PERF_INSTRUMENTATION
-#if defined(_VXWORKS_)
-    unsigned long _t2 = tickGet(); int _tr2 = sysClkRateGet(); c1 = (uint64_t)_t2 * (1000000000ULL / (_tr2 > 0 ? _tr2 : 1));
-#else
-    struct timespec _ts2; clock_gettime(CLOCK_MONOTONIC, &_ts2); c1 = (uint64_t)_ts2.tv_sec*1000000000ULL + _ts2.tv_nsec;
+        uint64_t c0 = perf_now_ns();
 #endif
-    // Log parse/CBOR durations
-    uint64_t parse_ns = (p1 > p0) ? (p1 - p0) : 0ULL;
-    uint64_t cbor_ns = (c1 > p1) ? (c1 - p1) : 0ULL;
-         logDebug("[PERF] IpcJsonClient parse=%llu us, to_cbor=%llu us", (unsigned long long)(parse_ns/1000ULL), (unsigned long long)(cbor_ns/1000ULL));
-         // Accumulate into client-level perf counters
-        parse_ns_total_.fetch_add(parse_ns);
-        parse_count_.fetch_add(1);
+        cbor_buf_.clear();
+        json::to_cbor(body, cbor_buf_);
+#ifdef DEMO_PERF_INSTRUMENTATION
+        uint64_t c1 = perf_now_ns();
+        uint64_t cbor_ns = (c1 > c0) ? (c1 - c0) : 0ULL;
+        logDebug("[PERF] IpcJsonClient to_cbor=%llu us", (unsigned long long)(cbor_ns/1000ULL));
         cbor_ns_total_.fetch_add(cbor_ns);
         cbor_count_.fetch_add(1);
 #endif
-        
-        // Move CBOR into per-instance buffer to reuse capacity and avoid per-call allocations
-        cbor_buf_ = std::move(cbor);
-
-        if (!transport_.send(cbor_buf_.data(), cbor_buf_.size(), type, req_id)) {
-            return LEGACY_ERR_TRANSPORT;
-        }
     } catch (const std::exception& e) {
         logError("[IpcJsonClient] Failed to encode CBOR: %s", e.what());
         return LEGACY_ERR_PARAM;
     }
+
+    if (!transport_.send(cbor_buf_.data(), cbor_buf_.size(), type, req_id)) {
+        return LEGACY_ERR_TRANSPORT;
+    }
     return LEGACY_OK;
 }
 
 void IpcJsonClient::receiveLoop() {
-    std::vector<uint8_t> buffer(65535);
+    DkmRtpIpc::FrameView frames[DkmRtpIpc::kRecvBatchSlots];
     
     while (running_) {
-        int bytes = transport_.receive(buffer.data(), buffer.size(), 100); // 100ms timeout
-        if (bytes > 0) {
-            // DkmRtpIpc has already stripped the header and validated it.
-            // buffer contains the payload (CBOR).
-            
-            std::string json_payload;
-            json j;
-            try {
-                std::vector<uint8_t> cbor_data(buffer.begin(), buffer.begin() + bytes);
-                j = json::from_cbor(cbor_data);
-                json_payload = j.dump();
-                
-                logDebug("[IpcJsonClient] RECV: %s", json_payload.c_str());
-            } catch (const std::exception& e) {
-                logError("[IpcJsonClient] Failed to decode CBOR: %s", e.what());
-                continue;
-            }
-            
-            // Check if it is an event
-            bool is_event = false;
-            if (j.contains("evt") && j["evt"] == "data") {
-                is_event = true;
-            } else if (j.contains("op") && j["op"] == "data") {
-                is_event = true;
-            } else if (!j.contains("ok") && j.contains("topic") && j.contains("data")) {
-                // Implicit event (no op/evt, but has topic+data and NO ok)
-                is_event = true;
-            }
+        // With send batching on, wake up at least every max_delay to flush aged frames
+        int wait_ms = 100; // 100ms timeout
+        uint32_t batch_delay_ms = transport_.sendBatchDelayMs();
+        if (batch_delay_ms > 0 && batch_delay_ms < (uint32_t)wait_ms) wait_ms = (int)batch_delay_ms;
 
-            if (is_event) {
-                std::string topic = j.value("topic", "");
-                std::string type = j.value("type", "");
-                std::string data_json;
-                
-                if (j.contains("data")) {
-                    if (j["data"].is_string()) {
-                        data_json = j["data"];
-                    } else {
-                        data_json = j["data"].dump();
-                    }
-                }
-
-                std::string key = topic + "/" + type;
-                
+        // One wakeup drains every datagram already queued (recvmmsg on Linux)
+        int count = transport_.receiveBatch(wait_ms, frames, DkmRtpIpc::kRecvBatchSlots);
+        if (batch_delay_ms > 0) {
 #ifdef _VXWORKS_
-                SemLockGuard lock(sub_sem_);
+            SemLockGuard lock(send_sem_);
 #else
-                std::lock_guard<std::mutex> lock(sub_mutex_);
+            std::lock_guard<std::mutex> lock(send_mutex_);
 #endif
-                auto it = subscriptions_.find(key);
-                if (it != subscriptions_.end()) {
-                    LegacyEvent evt;
-                    evt.topic = topic.c_str();
-                    evt.type = type.c_str();
-                    evt.data_json = data_json.c_str();
-                    evt.raw_json = json_payload.c_str();
-
-                    for (const auto& sub : it->second) {
-                        if (sub.event_cb) {
-                            sub.event_cb(nullptr, &evt, sub.user);
-                        } else if (sub.typed_cb) {
-                            // ... (typed cb logic omitted)
-                        }
-                    }
-                }
+            transport_.flushIfDue();
+        }
+        if (count > 0) {
+#ifdef DEMO_PERF_INSTRUMENTATION
+            recv_wakeup_count_.fetch_add(1);
+            recv_msg_count_.fetch_add((uint32_t)count);
+#endif
+            for (int i = 0; i < count; ++i) {
+                dispatchMessage(frames[i].data, (size_t)frames[i].len, frames[i].info);
+            }
+        }
+        expireRequests();
+    }
+}
+
+void IpcJsonClient::dispatchMessage(const uint8_t* data, size_t len, const DkmRtpIpc::FrameInfo& frame) {
+    // DkmRtpIpc has already stripped the header and validated it.
+    // data points at the payload (CBOR), decoded in place.
+    logDebug("[IpcJsonClient] RECV: %u bytes CBOR (type=0x%x, corr_id=%u)",
+             (unsigned)len, (unsigned)frame.type, frame.corr_id);
+
+    // Events are routed from the envelope alone; typed subscribers decode the
+    // data straight from CBOR and the DOM is only built for JSON callbacks
+    EventEnvelope env;
+    if (scanEvent(data, len, env)) {
+        routeEvent(data, len, env);
+        return;
+    }
+
+    json j;
+    try {
+        j = json::from_cbor(data, data + len);
+    } catch (const std::exception& e) {
+        logError("[IpcJsonClient] Failed to decode CBOR: %s", e.what());
+        return;
+    }
+    // Serialized only if a callback asks for raw_json
+    RawJsonSource raw;
+    raw.doc = &j;
+
+    uint32_t req_id = 0;
+    if (j.contains("req_id")) {
+        req_id = j["req_id"];
+    } else if (j.contains("corr_id")) {
+         req_id = j["corr_id"];
+    } else {
+        // Agent echoes our request id in the frame header
+        req_id = frame.corr_id;
+    }
+    
+    PendingRequest req;
+    bool found = false;
+    if (req_id > 0) {
+        peer_correlates_ = true;
+        found = pending_.take(req_id, &req);
+    } else if (!peer_correlates_) {
+        // Legacy agent that echoes no id anywhere: it answers in order (FIFO)
+        found = pending_.takeOldest(&req_id, &req);
+    }
+
+    if (!found) {
+        // Late, cancelled or unsolicited (e.g. a noack write answered anyway)
+        unmatched_reply_count_.fetch_add(1, std::memory_order_relaxed);
+        logDebug("[IpcJsonClient] Reply %u matches no pending request, dropped", req_id);
+    } else {
+        // Construct result
+        LegacySimpleResult res;
+        res.ok = j.value("ok", false) || j.value("Ok", false);
+        res.err = j.value("err", 0);
+        std::string msg = j.value("msg", "OK");
+        res.msg = msg.c_str(); 
+        res.raw_json = ""; // legacy field, see legacy_*_raw_json()
+        res.priv = &raw;
+        
+        int proto = j.value("proto", -1);
+        if (j.contains("result") && j["result"].contains("proto")) {
+            proto = j["result"]["proto"];
+        }
+
+        if (req.waiter) {
+            completeSync(req.waiter, &res, proto, false);
+        } else if (req.hello_cb) {
+            LegacyHelloInfo info;
+            info.proto = proto;
+            info.caps_raw_json = "{}"; // Mock
+            req.hello_cb(nullptr, req_id, &res, &info, req.user);
+        } else if (req.qos_cb) {
+            // Profiles are not parsed; the reply is in legacy_result_raw_json(res)
+            LegacyQosList list = { NULL, 0, "" };
+            req.qos_cb(nullptr, req_id, &res, &list, req.user);
+        } else if (req.simple_cb) {
+            req.simple_cb(nullptr, req_id, &res, req.user);
+        }
+    }
+}
+
+static bool text_equals(const char* s, size_t len, const char* lit) {
+    return strncmp(s, lit, len) == 0 && lit[len] == '\0';
+}
+
+bool IpcJsonClient::scanEvent(const uint8_t* payload, size_t len, EventEnvelope& env) {
+    env.topic = "";
+    env.topic_len = 0;
+    env.type = "";
+    env.type_len = 0;
+    env.data = nullptr;
+    env.data_len = 0;
+
+    CborReader r(payload, len);
+    size_t pairs;
+    if (!r.readMap(pairs)) return false;
+
+    // Same rule as the reply path: evt/op "data", or topic+data without "ok"
+    bool tagged = false, has_ok = false, has_topic = false;
+    for (size_t i = 0; pairs == CborReader::kIndefinite ? !r.readBreak() : i < pairs; ++i) {
+        const char* key;
+        size_t klen;
+        if (!r.readText(key, klen)) return false;   // left to the DOM path
+
+        const char* s;
+        size_t slen;
+        if (text_equals(key, klen, "evt") || text_equals(key, klen, "op")) {
+            if (r.readText(s, slen)) {
+                if (text_equals(s, slen, "data")) tagged = true;
+                continue;
+            }
+        } else if (text_equals(key, klen, "ok")) {
+            has_ok = true;
+        } else if (text_equals(key, klen, "topic")) {
+            has_topic = true;
+            if (r.readText(s, slen)) {
+                env.topic = s;
+                env.topic_len = slen;
                 continue;
             }
+        } else if (text_equals(key, klen, "type")) {
+            if (r.readText(s, slen)) {
+                env.type = s;
+                env.type_len = slen;
+                continue;
+            }
+        } else if (text_equals(key, klen, "data")) {
+            const uint8_t* begin = r.pos();
+            if (!r.skip()) return false;
+            env.data = begin;
+            env.data_len = (size_t)(r.pos() - begin);
+            continue;
+        }
+        if (!r.skip()) return false;
+    }
+    return tagged || (!has_ok && has_topic && env.data);
+}
+
+void IpcJsonClient::routeEvent(const uint8_t* payload, size_t len, const EventEnvelope& env) {
+    // Never interned: nobody subscribed to this topic/type
+    uint32_t topic = topics_.find(env.topic, env.topic_len, env.type, env.type_len);
+    if (topic == 0) return;
+    if (!dispatch_.running()) {
+        deliverEvent(payload, len, env, topic, recv_scratch_);
+        return;
+    }
+    {
+        // Nothing is copied for topics nobody listens to
+        SubscriptionTable::Reader subs(subscriptions_, recv_scratch_.reader);
+        if (!subs.find(topic)) return;
+    }
+    DispatchPool::Item spans;
+    spans.topic_off = (uint32_t)((const uint8_t*)env.topic - payload);
+    spans.topic_len = (uint32_t)env.topic_len;
+    spans.type_off = (uint32_t)((const uint8_t*)env.type - payload);
+    spans.type_len = (uint32_t)env.type_len;
+    spans.data_off = env.data ? (uint32_t)(env.data - payload) : 0;
+    spans.data_len = env.data ? (uint32_t)env.data_len : 0;
+    spans.topic_handle = topic;
+    uint32_t worker = dispatch_.shardOf(env.topic, env.topic_len);
+    if (!dispatch_.enqueue(worker, payload, len, spans)) {
+        logDebug("[IpcJsonClient] Dispatch queue %u full, event dropped", worker);
+    }
+}
+
+void IpcJsonClient::dispatchWorkerEntry(void* ctx, uint32_t worker, const DispatchPool::Item& item) {
+    IpcJsonClient* self = static_cast<IpcJsonClient*>(ctx);
+    const uint8_t* payload = item.payload.data();
+    EventEnvelope env;
+    env.topic = reinterpret_cast<const char*>(payload + item.topic_off);
+    env.topic_len = item.topic_len;
+    env.type = reinterpret_cast<const char*>(payload + item.type_off);
+    env.type_len = item.type_len;
+    env.data = item.data_len ? payload + item.data_off : nullptr;
+    env.data_len = item.data_len;
+    self->deliverEvent(payload, item.payload.size(), env, item.topic_handle, self->worker_scratch_[worker]);
+}
+
+void IpcJsonClient::deliverEvent(const uint8_t* payload, size_t len, const EventEnvelope& env, uint32_t topic, DispatchScratch& scratch) {
+    // The snapshot stays pinned for the whole fan-out; callbacks that
+    // subscribe publish a new one without waiting for this task
+    SubscriptionTable::Reader subs(subscriptions_, scratch.reader);
+    const SubscriptionTable::List* list = subs.find(topic);
+    if (!list) return;
+    // Interned names: no per-event string copies
+    const char* topic_name = topics_.topic(topic);
+    const char* type_name = topics_.type(topic);
 
-            uint32_t req_id = 0;
-            if (j.contains("req_id")) {
-                req_id = j["req_id"];
-            } else if (j.contains("corr_id")) {
-                 req_id = j["corr_id"];
+    RawJsonSource raw;
+    raw.cbor = payload;
+    raw.cbor_len = len;
+
+    // data_json for JSON callbacks: string payloads are passed straight from
+    // the DOM, structured ones are serialized once
+    bool data_ready = false;
+    const char* data_json = nullptr;
+    std::string data_dump;
+    auto get_data_json = [&]() -> const char* {
+        if (data_ready) return data_json;
+        data_ready = true;
+        const json* doc = raw.document();
+        if (!doc) {
+            logError("[IpcJsonClient] Failed to decode CBOR event for %s/%s", topic_name, type_name);
+            return nullptr;
+        }
+        auto data_it = doc->find("data");
+        if (data_it == doc->end()) {
+            data_json = "";
+        } else if (data_it->is_string()) {
+            data_json = data_it->get_ref<const std::string&>().c_str();
+        } else {
+            try {
+                data_dump = data_it->dump();
+                data_json = data_dump.c_str();
+            } catch (const std::exception& e) {
+                logError("[IpcJsonClient] Failed to serialize event data: %s", e.what());
             }
-            
-            PendingRequest req;
-            bool found = false;
+        }
+        return data_json;
+    };
 
-            {
-#ifdef _VXWORKS_
-                SemLockGuard lock(req_sem_);
-#else
-                std::lock_guard<std::mutex> lock(req_mutex_);
-#endif
-                auto it = pending_requests_.end();
-
-                if (req_id > 0) {
-                    it = pending_requests_.find(req_id);
-                } else if (!pending_requests_.empty()) {
-                    // Fallback: Assume FIFO if req_id is missing in response
-                    it = pending_requests_.begin();
-                    req_id = it->first;
-                }
+    bool adapter_looked_up = false;
+    bool have_adapter = false;
+    LegacyTypeAdapter adapter;
 
-                if (it != pending_requests_.end()) {
-                    req = it->second;
-                    pending_requests_.erase(it);
-                    found = true;
-                }
+    LegacyEvent evt;
+    evt.topic = topic_name;
+    evt.type = type_name;
+    evt.data_json = NULL;
+    evt.raw_json = ""; // legacy field, see legacy_*_raw_json()
+    evt.priv = &raw;
+    evt.topic_handle = topic;
+
+    for (const auto& sub : *list) {
+        if (sub.event_cb) {
+            evt.data_json = get_data_json();
+            if (!evt.data_json) continue;
+            sub.event_cb(nullptr, &evt, sub.user);
+        } else if (sub.typed_cb) {
+            if (!adapter_looked_up) {
+                adapter_looked_up = true;
+                have_adapter = copyTypeAdapter(topic, &adapter);
+                if (!have_adapter) logDebug("[IpcJsonClient] No type adapter for typed event %s/%s", topic_name, type_name);
             }
+            if (!have_adapter) continue;
+            size_t size = adapter.desc ? adapter.desc->size : adapter.struct_size;
+            if (size == 0) continue;
 
-            if (found) {
-                // Construct result
-                LegacySimpleResult res;
-                res.ok = j.value("ok", false) || j.value("Ok", false);
-                res.err = j.value("err", 0);
-                std::string msg = j.value("msg", "OK");
-                res.msg = msg.c_str(); 
-                res.raw_json = json_payload.c_str();
-                
-                if (req.hello_cb) {
-                    LegacyHelloInfo info;
-                    info.proto = j.value("proto", -1);
-                    if (j.contains("result") && j["result"].contains("proto")) {
-                        info.proto = j["result"]["proto"];
-                    }
-                    info.caps_raw_json = "{}"; // Mock
-                    req.hello_cb(nullptr, req_id, &res, &info, req.user);
-                } else if (req.simple_cb) {
-                    req.simple_cb(nullptr, req_id, &res, req.user);
-                }
+            // Every typed callback gets a freshly decoded, zero-initialised struct
+            scratch.typed_buf.assign((size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+            void* obj = scratch.typed_buf.data();
+            bool decoded = false;
+            if (adapter.decode_cbor || adapter.desc) {
+                decoded = decodeTypedData(adapter, env, obj, scratch);
+            } else if (adapter.decode) {
+                const char* dj = get_data_json();
+                decoded = dj && adapter.decode(dj, obj, adapter.user_ctx);
             }
+            if (!decoded) {
+                logDebug("[IpcJsonClient] Typed decode failed for %s/%s", topic_name, type_name);
+                continue;
+            }
+            evt.data_json = NULL;
+            sub.typed_cb(nullptr, &evt, obj, sub.user);
         }
     }
 }
 
-LegacyStatus IpcJsonClient::sendHello(uint32_t timeout_ms, LegacyHelloCb cb, void* user) {
+static bool decode_struct(CborReader& r, const LegacyTypeAdapter& adapter, void* out) {
+    // A per-type codec replaces the descriptor walk
+    if (adapter.decode_cbor) return adapter.decode_cbor(reinterpret_cast<LegacyCborReader*>(&r), out);
+    return StructCodec::decode(r, adapter.desc, out);
+}
+
+bool IpcJsonClient::decodeTypedData(const LegacyTypeAdapter& adapter, const EventEnvelope& env, void* out, DispatchScratch& scratch) {
+    if (!env.data) return false;
+    CborReader r(env.data, env.data_len);
+    if (r.peek() == CborReader::KIND_TEXT) {
+        // Data forwarded as JSON text: transcode it once, then decode as usual
+        const char* s;
+        size_t slen;
+        if (!r.readText(s, slen)) return false;
+        std::string text(s, slen);
+        scratch.typed_cbor.clear();
+        CborWriter w(scratch.typed_cbor);
+        if (!w.writeJsonText(text.c_str())) return false;
+        CborReader tr(scratch.typed_cbor.data(), scratch.typed_cbor.size());
+        return decode_struct(tr, adapter, out);
+    }
+    return decode_struct(r, adapter, out);
+}
+
+const json* IpcJsonClient::RawJsonSource::document() {
+    if (!doc && cbor) {
+        try {
+            owned = json::from_cbor(cbor, cbor + cbor_len);
+            doc = &owned;
+        } catch (const std::exception&) {
+            cbor = nullptr;     // do not retry
+        }
+    }
+    return doc;
+}
+
+LegacyStatus IpcJsonClient::sendHello(uint32_t timeout_ms, LegacyHelloCb cb, void* user, SyncWaiter* waiter) {
     uint32_t req_id = generateRequestId();
     
     // Match Sample: {"args":null,"data":null,"op":"hello","proto":1,"target":{"kind":"agent"}}
@@ -369,141 +678,104 @@ LegacyStatus IpcJsonClient::sendHello(uint32_t timeout_ms, LegacyHelloCb cb, voi
     j["data"] = nullptr;
     j["proto"] = 1;
     
-    std::string json_str = j.dump();
-    
     PendingRequest req;
     req.hello_cb = cb;
     req.simple_cb = nullptr;
     req.user = user;
+    req.waiter = waiter;
     
-    registerRequest(req_id, req);
+    LegacyStatus reg = registerRequest(req_id, req, timeout_ms);
+    if (reg != LEGACY_OK) return reg;
     
     // Use MSG_FRAME_REQ (0x1000)
-    return sendRequest(json_str, 0x1000, req_id);
+    LegacyStatus st = sendRequest(j, 0x1000, req_id);
+    return (st == LEGACY_OK) ? st : abortRequest(req_id, req.waiter, st);
 }
 
-LegacyStatus IpcJsonClient::createParticipant(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
-    
+// Build the "create" request for one entity (shared by the single and bulk APIs)
+static bool build_entity_request(const LegacyEntityDesc& d, json& j) {
     // Match Sample: {"args":{"domain":0,"qos":"..."},"data":null,"op":"create","proto":1,"target":{"kind":"participant"}}
-    json j;
+    //               {"args":{...},"data":null,"op":"create","proto":1,"target":{"kind":"writer","topic":"...","type":"..."}}
     j["op"] = "create";
-    j["target"]["kind"] = "participant";
-    j["args"]["domain"] = cfg->domain;
-    if (cfg->qos) j["args"]["qos"] = cfg->qos;
+    j["args"]["domain"] = d.domain;
+    switch (d.kind) {
+    case LEGACY_ENTITY_PARTICIPANT:
+        j["target"]["kind"] = "participant";
+        break;
+    case LEGACY_ENTITY_PUBLISHER:
+        j["target"]["kind"] = "publisher";
+        if (d.name) j["args"]["publisher"] = d.name;
+        break;
+    case LEGACY_ENTITY_SUBSCRIBER:
+        j["target"]["kind"] = "subscriber";
+        if (d.name) j["args"]["subscriber"] = d.name;
+        break;
+    case LEGACY_ENTITY_WRITER:
+    case LEGACY_ENTITY_READER:
+        if (!d.topic || !d.type) return false;
+        j["target"]["kind"] = (d.kind == LEGACY_ENTITY_WRITER) ? "writer" : "reader";
+        j["target"]["topic"] = d.topic;
+        j["target"]["type"] = d.type;
+        if (d.name) j["args"][(d.kind == LEGACY_ENTITY_WRITER) ? "publisher" : "subscriber"] = d.name;
+        break;
+    default:
+        return false;
+    }
+    if (d.qos) j["args"]["qos"] = d.qos;
     j["data"] = nullptr;
     j["proto"] = 1;
-    
-    std::string json_str = j.dump();
-    
-    PendingRequest req;
-    req.simple_cb = cb;
-    req.hello_cb = nullptr;
-    req.user = user;
-    
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+    return true;
 }
 
-LegacyStatus IpcJsonClient::createPublisher(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
-    
+LegacyStatus IpcJsonClient::createEntity(const LegacyEntityDesc& desc, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
     json j;
-    j["op"] = "create";
-    j["target"]["kind"] = "publisher";
-    j["args"]["domain"] = cfg->domain;
-    if (cfg->name) j["args"]["publisher"] = cfg->name;
-    if (cfg->qos) j["args"]["qos"] = cfg->qos;
-    j["data"] = nullptr;
-    j["proto"] = 1;
-    
-    std::string json_str = j.dump();
+    if (!build_entity_request(desc, j)) {
+        if (waiter) waiter->disarm();
+        return LEGACY_ERR_PARAM;
+    }
+    if (desc.kind == LEGACY_ENTITY_WRITER || desc.kind == LEGACY_ENTITY_READER) {
+        topics_.intern(desc.topic, desc.type);
+    }
+    uint32_t req_id = generateRequestId();
     
     PendingRequest req;
     req.simple_cb = cb;
     req.hello_cb = nullptr;
     req.user = user;
+    req.waiter = waiter;
     
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+    LegacyStatus reg = registerRequest(req_id, req, timeout_ms);
+    if (reg != LEGACY_OK) return reg;
+    LegacyStatus st = sendRequest(j, 0x1000, req_id);
+    return (st == LEGACY_OK) ? st : abortRequest(req_id, req.waiter, st);
 }
 
-LegacyStatus IpcJsonClient::createSubscriber(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
-    
-    json j;
-    j["op"] = "create";
-    j["target"]["kind"] = "subscriber";
-    j["args"]["domain"] = cfg->domain;
-    if (cfg->name) j["args"]["subscriber"] = cfg->name;
-    if (cfg->qos) j["args"]["qos"] = cfg->qos;
-    j["data"] = nullptr;
-    j["proto"] = 1;
-    
-    std::string json_str = j.dump();
-    
-    PendingRequest req;
-    req.simple_cb = cb;
-    req.hello_cb = nullptr;
-    req.user = user;
-    
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+LegacyStatus IpcJsonClient::createParticipant(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
+    LegacyEntityDesc d = { LEGACY_ENTITY_PARTICIPANT, cfg->domain, nullptr, nullptr, nullptr, cfg->qos };
+    return createEntity(d, timeout_ms, cb, user, waiter);
 }
 
-LegacyStatus IpcJsonClient::createWriter(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
-    
-    // Match Sample: {"args":{...},"data":null,"op":"create","proto":1,"target":{"kind":"writer","topic":"...","type":"..."}}
-    json j;
-    j["op"] = "create";
-    j["target"]["kind"] = "writer";
-    j["target"]["topic"] = cfg->topic;
-    j["target"]["type"] = cfg->type;
-    j["args"]["domain"] = cfg->domain;
-    if (cfg->publisher) j["args"]["publisher"] = cfg->publisher;
-    if (cfg->qos) j["args"]["qos"] = cfg->qos;
-    j["data"] = nullptr;
-    j["proto"] = 1;
-    
-    std::string json_str = j.dump();
-    
-    PendingRequest req;
-    req.simple_cb = cb;
-    req.hello_cb = nullptr;
-    req.user = user;
-    
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+LegacyStatus IpcJsonClient::createPublisher(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
+    LegacyEntityDesc d = { LEGACY_ENTITY_PUBLISHER, cfg->domain, cfg->name, nullptr, nullptr, cfg->qos };
+    return createEntity(d, timeout_ms, cb, user, waiter);
 }
 
-LegacyStatus IpcJsonClient::createReader(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
-    
-    // Match Sample: {"args":{...},"data":null,"op":"create","proto":1,"target":{"kind":"reader","topic":"...","type":"..."}}
-    json j;
-    j["op"] = "create";
-    j["target"]["kind"] = "reader";
-    j["target"]["topic"] = cfg->topic;
-    j["target"]["type"] = cfg->type;
-    j["args"]["domain"] = cfg->domain;
-    if (cfg->subscriber) j["args"]["subscriber"] = cfg->subscriber;
-    if (cfg->qos) j["args"]["qos"] = cfg->qos;
-    j["data"] = nullptr;
-    j["proto"] = 1;
-    
-    std::string json_str = j.dump();
-    
-    PendingRequest req;
-    req.simple_cb = cb;
-    req.hello_cb = nullptr;
-    req.user = user;
-    
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+LegacyStatus IpcJsonClient::createSubscriber(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
+    LegacyEntityDesc d = { LEGACY_ENTITY_SUBSCRIBER, cfg->domain, cfg->name, nullptr, nullptr, cfg->qos };
+    return createEntity(d, timeout_ms, cb, user, waiter);
+}
+
+LegacyStatus IpcJsonClient::createWriter(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
+    LegacyEntityDesc d = { LEGACY_ENTITY_WRITER, cfg->domain, cfg->publisher, cfg->topic, cfg->type, cfg->qos };
+    return createEntity(d, timeout_ms, cb, user, waiter);
 }
 
-LegacyStatus IpcJsonClient::clearEntities(uint32_t timeout_ms, LegacySimpleCb cb, void* user) {
+LegacyStatus IpcJsonClient::createReader(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
+    LegacyEntityDesc d = { LEGACY_ENTITY_READER, cfg->domain, cfg->subscriber, cfg->topic, cfg->type, cfg->qos };
+    return createEntity(d, timeout_ms, cb, user, waiter);
+}
+
+LegacyStatus IpcJsonClient::clearEntities(uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter) {
     uint32_t req_id = generateRequestId();
     
     // Match Sample: {"args":null,"data":null,"op":"clear","proto":1,"target":{"kind":"dds_entities"}}
@@ -514,15 +786,307 @@ LegacyStatus IpcJsonClient::clearEntities(uint32_t timeout_ms, LegacySimpleCb cb
     j["data"] = nullptr;
     j["proto"] = 1;
     
-    std::string json_str = j.dump();
-    
     PendingRequest req;
     req.simple_cb = cb;
     req.hello_cb = nullptr;
     req.user = user;
+    req.waiter = waiter;
     
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+    LegacyStatus reg = registerRequest(req_id, req, timeout_ms);
+    if (reg != LEGACY_OK) return reg;
+    LegacyStatus st = sendRequest(j, 0x1000, req_id);
+    return (st == LEGACY_OK) ? st : abortRequest(req_id, req.waiter, st);
+}
+
+void IpcJsonClient::bulkEntryCb(LEGACY_HANDLE h, LegacyRequestId reqId, const LegacySimpleResult* res, void* user) {
+    (void)h;
+    (void)reqId;
+    BulkEntry* entry = static_cast<BulkEntry*>(user);
+    BulkOp* op = entry->op;
+    size_t i = entry->index;
+    op->msgs[i] = res->msg ? res->msg : "";
+    op->results[i].ok = res->ok;
+    op->results[i].err = res->err;
+    op->results[i].msg = op->msgs[i].c_str();
+    // Expiry reports carry no reply document
+    op->timed_out[i] = (!res->ok && res->priv == NULL) ? 1 : 0;
+    op->client->releaseBulk(op, 1);
+}
+
+void IpcJsonClient::releaseBulk(BulkOp* op, size_t n) {
+    if (op->refs.fetch_sub(n, std::memory_order_acq_rel) != n) return;
+
+    // Last result in: report once
+    if (op->waiter) {
+        bool all_ok = true;
+        bool any_timeout = false;
+        for (size_t i = 0; i < op->results.size(); ++i) {
+            if (!op->results[i].ok) all_ok = false;
+            if (op->timed_out[i]) any_timeout = true;
+        }
+        LegacySimpleResult sum;
+        sum.ok = all_ok;
+        sum.err = 0;
+        sum.msg = NULL;
+        sum.raw_json = ""; // legacy field, see legacy_*_raw_json()
+        sum.priv = NULL;
+        if (op->waiter->complete(&sum, -1, any_timeout)) return; // the caller reads and frees op
+        sync_waiters_.release(op->waiter);
+    } else if (op->cb) {
+        op->cb(nullptr, op->results.data(), op->results.size(), op->user);
+    }
+    delete op;
+}
+
+size_t IpcJsonClient::issueBulk(BulkOp* op, const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacyStatus* out_err) {
+    size_t sent = 0;
+    LegacyStatus first_err = LEGACY_OK;
+    {
+#ifdef _VXWORKS_
+        SemLockGuard lock(send_sem_);
+#else
+        std::lock_guard<std::mutex> lock(send_mutex_);
+#endif
+        // Every request is queued in order, then all leave in one flush
+        transport_.beginBurst();
+        for (size_t i = 0; i < count; ++i) {
+            LegacyStatus st = LEGACY_OK;
+            json j;
+            if (!build_entity_request(descs[i], j)) {
+                st = LEGACY_ERR_PARAM;
+            } else if (first_err == LEGACY_ERR_BUSY) {
+                st = LEGACY_ERR_BUSY; // table full: do not spin on the rest
+            } else {
+                if (descs[i].kind == LEGACY_ENTITY_WRITER || descs[i].kind == LEGACY_ENTITY_READER) {
+                    topics_.intern(descs[i].topic, descs[i].type);
+                }
+                uint32_t req_id = generateRequestId();
+                PendingRequest req;
+                req.simple_cb = &IpcJsonClient::bulkEntryCb;
+                req.hello_cb = nullptr;
+                req.user = &op->entries[i];
+                st = registerRequest(req_id, req, timeout_ms);
+                if (st == LEGACY_OK) {
+                    st = encodeAndSend(j, 0x1000, req_id);
+                    if (st == LEGACY_OK || abortRequest(req_id, nullptr, st) == LEGACY_OK) {
+                        // Registered: the entry completes by reply or by timeout
+                        op->results[i].reqId = req_id;
+                        sent++;
+                        continue;
+                    }
+                    logError("[IpcJsonClient] Bulk create: request %u not queued", req_id);
+                }
+            }
+            if (first_err == LEGACY_OK) first_err = st;
+            op->results[i].err = st;
+            op->results[i].msg = "not sent";
+        }
+        if (!transport_.endBurst()) {
+            logError("[IpcJsonClient] Bulk create: burst send failed, %u requests will time out", (unsigned)sent);
+        }
+    }
+    if (out_err) *out_err = first_err;
+    return sent;
+}
+
+LegacyStatus IpcJsonClient::createEntities(const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacyBulkCb cb, void* user) {
+    BulkOp* op = new BulkOp(this, count);
+    op->cb = cb;
+    op->user = user;
+
+    LegacyStatus err = LEGACY_OK;
+    size_t sent = issueBulk(op, descs, count, timeout_ms, &err);
+    if (sent == 0) {
+        delete op;
+        return err;
+    }
+    // Unsent entries already have their result; drop them and the issuer's reference
+    releaseBulk(op, count - sent + 1);
+    return LEGACY_OK;
+}
+
+LegacyStatus IpcJsonClient::createEntitiesSync(const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacySyncResult* out_results) {
+    if (out_results) {
+        for (size_t i = 0; i < count; ++i) {
+            out_results[i].ok = false;
+            out_results[i].err = 0;
+            out_results[i].msg[0] = '\0';
+        }
+    }
+    if (onReceiveTask()) {
+        logError("[IpcJsonClient] Blocking call from the receive task rejected");
+        return LEGACY_ERR_PARAM;
+    }
+    if (!running_) return LEGACY_ERR_CLOSED;
+
+    BulkOp* op = new BulkOp(this, count);
+    op->waiter = sync_waiters_.acquire();
+    op->waiter->arm();
+
+    LegacyStatus err = LEGACY_OK;
+    size_t sent = issueBulk(op, descs, count, timeout_ms, &err);
+    if (sent == 0) {
+        sync_waiters_.release(op->waiter);
+        delete op;
+        return err;
+    }
+    SyncWaiter* w = op->waiter;
+    releaseBulk(op, count - sent + 1);
+
+    uint32_t limit = (timeout_ms == 0 ? kDefaultTimeoutMs : timeout_ms) + kSyncWaitMarginMs;
+    if (!w->wait(limit) && w->abandon()) {
+        return LEGACY_ERR_TIMEOUT; // op and waiter are freed by the last completion
+    }
+
+    bool any_refused = false;
+    LegacyStatus st = LEGACY_OK;
+    for (size_t i = 0; i < count; ++i) {
+        const LegacyEntityResult& r = op->results[i];
+        if (out_results) {
+            out_results[i].ok = r.ok;
+            out_results[i].err = r.err;
+            strncpy(out_results[i].msg, r.msg ? r.msg : "", sizeof(out_results[i].msg) - 1);
+            out_results[i].msg[sizeof(out_results[i].msg) - 1] = '\0';
+        }
+        if (r.ok) continue;
+        if (op->timed_out[i]) st = LEGACY_ERR_TIMEOUT;
+        else if (r.reqId != 0) any_refused = true;
+    }
+    if (st == LEGACY_OK) st = any_refused ? LEGACY_ERR_PROTO : err;
+    sync_waiters_.release(w);
+    delete op;
+    return st;
+}
+
+const char* IpcJsonClient::rawJson(const void* priv) {
+    if (!priv) return NULL;
+    // Callbacks of one message run one after another on one task,
+    // so the cache needs no lock; later callbacks reuse the same text
+    RawJsonSource* src = const_cast<RawJsonSource*>(static_cast<const RawJsonSource*>(priv));
+    if (!src->serialized) {
+        const json* doc = src->document();
+        if (!doc) return NULL;
+        try {
+            src->text = doc->dump();
+        } catch (const std::exception&) {
+            return NULL; // invalid UTF-8 in a string value
+        }
+        src->serialized = true;
+    }
+    return src->text.c_str();
+}
+
+bool IpcJsonClient::onReceiveTask() const {
+#ifdef _VXWORKS_
+    return recv_task_ != TASK_ID_ERROR && taskIdSelf() == recv_task_;
+#else
+    return recv_thread_.get_id() == std::this_thread::get_id();
+#endif
+}
+
+void IpcJsonClient::completeSync(SyncWaiter* waiter, const LegacySimpleResult* res, int proto, bool timed_out) {
+    if (!waiter->complete(res, proto, timed_out)) {
+        // The caller stopped waiting (transport error or close); recycle here
+        sync_waiters_.release(waiter);
+    }
+}
+
+LegacyStatus IpcJsonClient::runSync(uint32_t timeout_ms, LegacySyncResult* out_res, int* out_proto,
+                                    const std::function<LegacyStatus(SyncWaiter*)>& issue) {
+    if (out_res) {
+        out_res->ok = false;
+        out_res->err = 0;
+        out_res->msg[0] = '\0';
+    }
+    if (out_proto) *out_proto = -1;
+    // Replies are completed on the receive task, so blocking it would deadlock
+    // (this includes calling a _sync API from inside a library callback)
+    if (onReceiveTask()) {
+        logError("[IpcJsonClient] Blocking call from the receive task rejected");
+        return LEGACY_ERR_PARAM;
+    }
+    if (!running_) return LEGACY_ERR_CLOSED;
+
+    SyncWaiter* w = sync_waiters_.acquire();
+    w->arm();
+    LegacyStatus st = issue(w);
+    if (!w->armed()) {
+        // Not registered, nothing refers to the waiter
+        sync_waiters_.release(w);
+        return st;
+    }
+
+    bool completed = false;
+    if (st == LEGACY_OK) {
+        // Normally woken by the reply or by the timeout wheel; the wait bound
+        // only matters when the receive task is gone (handle closed meanwhile)
+        uint32_t limit = (timeout_ms == 0 ? kDefaultTimeoutMs : timeout_ms) + kSyncWaitMarginMs;
+        completed = w->wait(limit);
+    }
+    if (!completed && w->abandon()) {
+        // Still registered: the receive task recycles the waiter when the
+        // request completes or expires
+        return (st != LEGACY_OK) ? st : LEGACY_ERR_TIMEOUT;
+    }
+    if (st != LEGACY_OK) {
+        // Send failed but the entry already completed (expired); report the send error
+        sync_waiters_.release(w);
+        return st;
+    }
+
+    if (out_res) {
+        out_res->ok = w->ok;
+        out_res->err = w->err;
+        memcpy(out_res->msg, w->msg, sizeof(out_res->msg));
+    }
+    if (out_proto) *out_proto = w->proto;
+
+    if (w->timed_out) st = LEGACY_ERR_TIMEOUT;
+    else if (!w->ok) st = LEGACY_ERR_PROTO;
+    sync_waiters_.release(w);
+    return st;
+}
+
+LegacyStatus IpcJsonClient::sendHelloSync(uint32_t timeout_ms, LegacySyncResult* out_res, int* out_proto) {
+    return runSync(timeout_ms, out_res, out_proto, [&](SyncWaiter* w) {
+        return sendHello(timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::createParticipantSync(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return createParticipant(cfg, timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::createPublisherSync(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return createPublisher(cfg, timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::createSubscriberSync(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return createSubscriber(cfg, timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::createWriterSync(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return createWriter(cfg, timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::createReaderSync(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return createReader(cfg, timeout_ms, nullptr, nullptr, w);
+    });
+}
+
+LegacyStatus IpcJsonClient::clearEntitiesSync(uint32_t timeout_ms, LegacySyncResult* out_res) {
+    return runSync(timeout_ms, out_res, nullptr, [&](SyncWaiter* w) {
+        return clearEntities(timeout_ms, nullptr, nullptr, w);
+    });
 }
 
 LegacyStatus IpcJsonClient::getQosList(bool include_builtin, bool detail, uint32_t timeout_ms, LegacyQosListCb cb, void* user) {
@@ -537,24 +1101,16 @@ LegacyStatus IpcJsonClient::getQosList(bool include_builtin, bool detail, uint32
     j["data"] = nullptr;
     j["proto"] = 1;
     
-    std::string json_str = j.dump();
-    
-    // Note: We need a way to handle QosList callback. 
-    // For now, we'll just use the generic request mechanism and maybe cast the callback or add a new type.
-    // But the current PendingRequest struct only has hello_cb and simple_cb.
-    // We should probably add qos_cb to PendingRequest or just use simple_cb and parse result in user code?
-    // The C API expects LegacyQosListCb.
-    // Let's assume for this task we just want to send the correct JSON.
-    // We will use simple_cb for now and let the user handle it or just print "OK".
-    // Ideally we should extend PendingRequest.
-    
     PendingRequest req;
-    req.simple_cb = (LegacySimpleCb)cb; // Cast for now, dangerous but works if signature matches enough or we don't call it with wrong args
+    req.simple_cb = nullptr;
     req.hello_cb = nullptr;
+    req.qos_cb = cb;
     req.user = user;
     
-    registerRequest(req_id, req);
-    return sendRequest(json_str, 0x1000, req_id);
+    LegacyStatus reg = registerRequest(req_id, req, timeout_ms);
+    if (reg != LEGACY_OK) return reg;
+    LegacyStatus st = sendRequest(j, 0x1000, req_id);
+    return (st == LEGACY_OK) ? st : abortRequest(req_id, req.waiter, st);
 }
 
 LegacyStatus IpcJsonClient::setQosProfile(const LegacyQosSetOptions* opt, uint32_t timeout_ms, LegacyQosSetCb cb, void* user) {
@@ -562,67 +1118,232 @@ LegacyStatus IpcJsonClient::setQosProfile(const LegacyQosSetOptions* opt, uint32
     return LEGACY_OK;
 }
 
-LegacyStatus IpcJsonClient::writeJson(const LegacyWriteJsonOptions* opt, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
-    uint32_t req_id = generateRequestId();
+// Write envelope (keys in sorted order, same as the DOM path):
+// {"args":{["ack":false,]"domain":..,"publisher":..,"qos":..},"data":<data_json>,"op":"write","proto":1,
+//  "target":{"kind":"writer","topic":..}}
+// Everything around the data value is fixed per writer: the head ends with
+// the "data" key, the tail starts at "op".
+static void encode_write_head(CborWriter& w, const LegacyWriteJsonOptions* opt, bool ack) {
+    w.beginMap(5);
 
-    // Build JSON payload
-    json j;
-    j["op"] = "write";
-    j["target"]["kind"] = "writer";
-    j["target"]["topic"] = opt->topic;
-    j["args"]["domain"] = opt->domain;
-    if (opt->publisher) j["args"]["publisher"] = opt->publisher;
-    if (opt->qos) j["args"]["qos"] = opt->qos;
+    w.writeText("args");
+    w.beginMap(1 + (ack ? 0 : 1) + (opt->publisher ? 1 : 0) + (opt->qos ? 1 : 0));
+    if (!ack) {
+        w.writeText("ack");
+        w.writeBool(false);
+    }
+    w.writeText("domain");
+    w.writeInt(opt->domain);
+    if (opt->publisher) {
+        w.writeText("publisher");
+        w.writeText(opt->publisher);
+    }
+    if (opt->qos) {
+        w.writeText("qos");
+        w.writeText(opt->qos);
+    }
+    w.writeText("data");
+}
+
+static void encode_write_data(CborWriter& w, const char* data_json, const LegacyStructDesc* desc,
+                              void (*encode_cbor)(LegacyCborWriter*, const void*), const void* obj) {
+    // A struct is encoded by its codec or field by field, no text involved
+    if (encode_cbor) {
+        encode_cbor(reinterpret_cast<LegacyCborWriter*>(&w), obj);
+        return;
+    }
+    if (desc) {
+        StructCodec::encode(w, desc, obj);
+        return;
+    }
+    // data_json is transcoded in a single pass; text that is not valid JSON
+    // is sent as a plain string (same fallback as before)
+    if (!data_json) {
+        w.writeNull();
+    } else if (!w.writeJsonText(data_json)) {
+        w.writeText(data_json);
+    }
+}
+
+static void encode_write_tail(CborWriter& w, const char* topic) {
+    w.writeText("op");
+    w.writeText("write");
+    w.writeText("proto");
+    w.writeInt(1);
 
+    w.writeText("target");
+    w.beginMap(2);
+    w.writeText("kind");
+    w.writeText("writer");
+    w.writeText("topic");
+    w.writeText(topic);
+}
+
+LegacyStatus IpcJsonClient::sendWriteRequest(const LegacyWriteJsonOptions* opt, const WriterTemplate* tmpl,
+                                             const WriteData& data, uint32_t req_id, bool ack) {
+#ifdef _VXWORKS_
+    SemLockGuard lock(send_sem_);
+#else
+    std::lock_guard<std::mutex> lock(send_mutex_);
+#endif
 #ifdef DEMO_PERF_INSTRUMENTATION
-    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = perf_now_ns();
 #endif
-    try {
-        j["data"] = json::parse(opt->data_json);
-    } catch (...) {
-        j["data"] = opt->data_json;
+    if (tmpl) {
+        // Pre-encoded writer: only the data value is encoded per sample
+        const std::vector<uint8_t>& head = ack ? tmpl->head : tmpl->head_noack;
+        cbor_buf_.assign(head.begin(), head.end());
+        CborWriter w(cbor_buf_);
+        encode_write_data(w, data.json, data.desc, data.encode_cbor, data.obj);
+        cbor_buf_.insert(cbor_buf_.end(), tmpl->tail.begin(), tmpl->tail.end());
+    } else {
+        cbor_buf_.clear();
+        CborWriter w(cbor_buf_);
+        encode_write_head(w, opt, ack);
+        encode_write_data(w, data.json, data.desc, data.encode_cbor, data.obj);
+        encode_write_tail(w, opt->topic);
     }
 #ifdef DEMO_PERF_INSTRUMENTATION
-    auto t1 = std::chrono::steady_clock::now();
-    auto parse_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
-    logDebug("[PERF] IpcJsonClient::parse data_json took %llu us", (unsigned long long)parse_us);
+    uint64_t c1 = perf_now_ns();
+    uint64_t cbor_ns = (c1 > c0) ? (c1 - c0) : 0ULL;
+    cbor_ns_total_.fetch_add(cbor_ns);
+    cbor_count_.fetch_add(1);
 #endif
 
-    j["proto"] = 1;
-    std::string json_str = j.dump();
+    if (!transport_.send(cbor_buf_.data(), cbor_buf_.size(), 0x1000, req_id)) {
+        return LEGACY_ERR_TRANSPORT;
+    }
+    return LEGACY_OK;
+}
 
-    PendingRequest req;
-    req.simple_cb = cb;
-    req.hello_cb = nullptr;
-    req.user = user;
+LegacyStatus IpcJsonClient::issueWrite(const LegacyWriteJsonOptions* opt, const WriterTemplate* tmpl, const WriteData& data,
+                                       bool ack, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    uint32_t req_id = generateRequestId();
 
-    registerRequest(req_id, req);
+    // Unacknowledged: the id still goes out as header corr_id for tracing, but
+    // nothing is registered: no req lock, no table insert/erase, no timeout entry.
+    if (ack) {
+        PendingRequest req;
+        req.simple_cb = cb;
+        req.hello_cb = nullptr;
+        req.user = user;
+
+        LegacyStatus reg = registerRequest(req_id, req, timeout_ms);
+        if (reg != LEGACY_OK) return reg;
+    }
 
 #ifdef DEMO_PERF_INSTRUMENTATION
     auto tw0 = std::chrono::steady_clock::now();
 #endif
-    LegacyStatus st = sendRequest(json_str, 0x1000, req_id);
+    LegacyStatus st = sendWriteRequest(opt, tmpl, data, req_id, ack);
 #ifdef DEMO_PERF_INSTRUMENTATION
     auto tw1 = std::chrono::steady_clock::now();
     auto write_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tw1 - tw0).count();
     write_ns_total_.fetch_add((uint64_t)write_ns);
     write_count_.fetch_add(1);
-    logDebug("[PERF] IpcJsonClient::writeJson total=%llu us", (unsigned long long)(write_ns/1000ULL));
+    if (ack) logDebug("[PERF] IpcJsonClient::writeJson total=%llu us", (unsigned long long)(write_ns/1000ULL));
 #endif
+    if (ack && st != LEGACY_OK) return abortRequest(req_id, nullptr, st);
     return st;
 }
 
+LegacyStatus IpcJsonClient::writeJson(const LegacyWriteJsonOptions* opt, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    WriteData data = { opt->data_json, nullptr, nullptr, nullptr };
+    return issueWrite(opt, nullptr, data, true, timeout_ms, cb, user);
+}
+
+LegacyStatus IpcJsonClient::writeJsonNoAck(const LegacyWriteJsonOptions* opt) {
+    WriteData data = { opt->data_json, nullptr, nullptr, nullptr };
+    return issueWrite(opt, nullptr, data, false, 0, nullptr, nullptr);
+}
+
+LegacyStatus IpcJsonClient::openWriter(const LegacyWriteJsonOptions* opt, WriterTemplate* out) {
+    if (!opt->topic) return LEGACY_ERR_PARAM;
+    // Without a type there is no adapter to look up: write_struct is refused
+    out->topic = opt->type ? topics_.intern(opt->topic, opt->type) : 0;
+
+    out->head.clear();
+    CborWriter head(out->head);
+    encode_write_head(head, opt, true);
+
+    out->head_noack.clear();
+    CborWriter head_noack(out->head_noack);
+    encode_write_head(head_noack, opt, false);
+
+    out->tail.clear();
+    CborWriter tail(out->tail);
+    encode_write_tail(tail, opt->topic);
+    return LEGACY_OK;
+}
+
+LegacyStatus IpcJsonClient::writerWrite(const WriterTemplate& w, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    WriteData data = { data_json, nullptr, nullptr, nullptr };
+    return issueWrite(nullptr, &w, data, true, timeout_ms, cb, user);
+}
+
+LegacyStatus IpcJsonClient::writerWriteNoAck(const WriterTemplate& w, const char* data_json) {
+    WriteData data = { data_json, nullptr, nullptr, nullptr };
+    return issueWrite(nullptr, &w, data, false, 0, nullptr, nullptr);
+}
+
+LegacyStatus IpcJsonClient::structData(uint32_t topic, const void* user_struct, WriteData* out) {
+    LegacyTypeAdapter adapter;
+    if (!copyTypeAdapter(topic, &adapter)) return LEGACY_ERR_PARAM; // No adapter found
+
+    // Codec or descriptor: encoded straight from the struct while the request is built
+    if (adapter.encode_cbor || adapter.desc) {
+        out->json = nullptr;
+        out->desc = adapter.desc;
+        out->obj = user_struct;
+        out->encode_cbor = adapter.encode_cbor;
+        return LEGACY_OK;
+    }
+    if (!adapter.encode) return LEGACY_ERR_PARAM;
+    out->json = adapter.encode(user_struct, adapter.user_ctx);
+    out->desc = nullptr;
+    out->obj = nullptr;
+    out->encode_cbor = nullptr;
+    return out->json ? LEGACY_OK : LEGACY_ERR_PARAM;
+}
+
+LegacyStatus IpcJsonClient::writerWriteStruct(const WriterTemplate& w, const void* user_struct, bool ack,
+                                              uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    WriteData data;
+    LegacyStatus st = structData(w.topic, user_struct, &data);
+    if (st != LEGACY_OK) return st;
+    return issueWrite(nullptr, &w, data, ack, timeout_ms, cb, user);
+}
+
 LegacyStatus IpcJsonClient::writeStruct(const char* topic, const char* type_name, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
-    const LegacyTypeAdapter* adapter = findTypeAdapter(topic, type_name);
-    if (!adapter || !adapter->encode) return LEGACY_ERR_PARAM; // No adapter found
+    uint32_t handle = topics_.find(topic, strlen(topic), type_name, strlen(type_name));
+    if (handle == 0) return LEGACY_ERR_PARAM; // Never registered: no adapter
+    return writeStructByHandle(handle, user_struct, timeout_ms, cb, user);
+}
 
-    const char* json_data = adapter->encode(user_struct, adapter->user_ctx);
-    if (!json_data) return LEGACY_ERR_PARAM;
+LegacyStatus IpcJsonClient::writeStructByHandle(uint32_t topic, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!topics_.valid(topic)) return LEGACY_ERR_PARAM;
+    WriteData data;
+    LegacyStatus st = structData(topic, user_struct, &data);
+    if (st != LEGACY_OK) return st;
 
     LegacyWriteJsonOptions opt;
-    opt.topic = topic;
-    opt.type = type_name;
-    opt.data_json = json_data;
+    opt.topic = topics_.topic(topic);
+    opt.type = topics_.type(topic);
+    opt.data_json = data.json;
+    opt.domain = 0; // Default
+    opt.publisher = NULL;
+    opt.qos = NULL;
+
+    return issueWrite(&opt, nullptr, data, true, timeout_ms, cb, user);
+}
+
+LegacyStatus IpcJsonClient::writeJsonByHandle(uint32_t topic, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!topics_.valid(topic)) return LEGACY_ERR_PARAM;
+
+    LegacyWriteJsonOptions opt;
+    opt.topic = topics_.topic(topic);
+    opt.type = topics_.type(topic);
+    opt.data_json = data_json;
     opt.domain = 0; // Default
     opt.publisher = NULL;
     opt.qos = NULL;
@@ -630,77 +1351,140 @@ LegacyStatus IpcJsonClient::writeStruct(const char* topic, const char* type_name
     return writeJson(&opt, timeout_ms, cb, user);
 }
 
-LegacyStatus IpcJsonClient::subscribeEvent(const char* topic, const char* type, LegacyEventCb cb, void* user) {
-    std::string key = std::string(topic) + "/" + std::string(type);
-    
+LegacyStatus IpcJsonClient::writeJsonNoAckByHandle(uint32_t topic, const char* data_json) {
+    if (!topics_.valid(topic)) return LEGACY_ERR_PARAM;
+
+    LegacyWriteJsonOptions opt;
+    opt.topic = topics_.topic(topic);
+    opt.type = topics_.type(topic);
+    opt.data_json = data_json;
+    opt.domain = 0; // Default
+    opt.publisher = NULL;
+    opt.qos = NULL;
+
+    return writeJsonNoAck(&opt);
+}
+
+LegacyStatus IpcJsonClient::setSendBatching(uint32_t max_frames, uint32_t max_delay_ms) {
 #ifdef _VXWORKS_
-    SemLockGuard lock(sub_sem_);
+    SemLockGuard lock(send_sem_);
 #else
-    std::lock_guard<std::mutex> lock(sub_mutex_);
+    std::lock_guard<std::mutex> lock(send_mutex_);
 #endif
-    Subscription sub;
-    sub.event_cb = cb;
-    sub.typed_cb = nullptr;
-    sub.user = user;
-    subscriptions_[key].push_back(sub);
-    
+    int frames = (max_frames > (uint32_t)DkmRtpIpc::kSendBatchMaxFrames) ? DkmRtpIpc::kSendBatchMaxFrames : (int)max_frames;
+    if (!transport_.setSendBatching(frames, max_delay_ms)) {
+        return LEGACY_ERR_TRANSPORT;
+    }
     return LEGACY_OK;
 }
 
-LegacyStatus IpcJsonClient::subscribeTyped(const char* topic, const char* type_name, LegacyTypedEventCb cb, void* user) {
-    std::string key = std::string(topic) + "/" + std::string(type_name);
-    
+LegacyStatus IpcJsonClient::flush() {
 #ifdef _VXWORKS_
-    SemLockGuard lock(sub_sem_);
+    SemLockGuard lock(send_sem_);
 #else
-    std::lock_guard<std::mutex> lock(sub_mutex_);
+    std::lock_guard<std::mutex> lock(send_mutex_);
 #endif
+    return transport_.flush() ? LEGACY_OK : LEGACY_ERR_TRANSPORT;
+}
+
+LegacyStatus IpcJsonClient::topicHandle(const char* topic, const char* type, uint32_t* out_handle) {
+    uint32_t handle = topics_.intern(topic, type);
+    if (handle == 0) {
+        logError("[IpcJsonClient] Topic registry full, %s/%s not interned", topic, type);
+        return LEGACY_ERR_BUSY;
+    }
+    *out_handle = handle;
+    return LEGACY_OK;
+}
+
+LegacyStatus IpcJsonClient::addSubscription(uint32_t topic, const Subscription& sub) {
+    if (!topics_.valid(topic)) return LEGACY_ERR_PARAM;
+    subscriptions_.add(topic, sub);
+    return LEGACY_OK;
+}
+
+LegacyStatus IpcJsonClient::subscribeEvent(const char* topic, const char* type, LegacyEventCb cb, void* user) {
+    uint32_t handle = 0;
+    LegacyStatus st = topicHandle(topic, type, &handle);
+    if (st != LEGACY_OK) return st;
+    return subscribeEventByHandle(handle, cb, user);
+}
+
+LegacyStatus IpcJsonClient::subscribeTyped(const char* topic, const char* type_name, LegacyTypedEventCb cb, void* user) {
+    uint32_t handle = 0;
+    LegacyStatus st = topicHandle(topic, type_name, &handle);
+    if (st != LEGACY_OK) return st;
+    return subscribeTypedByHandle(handle, cb, user);
+}
+
+LegacyStatus IpcJsonClient::subscribeEventByHandle(uint32_t topic, LegacyEventCb cb, void* user) {
+    Subscription sub;
+    sub.event_cb = cb;
+    sub.typed_cb = nullptr;
+    sub.user = user;
+    return addSubscription(topic, sub);
+}
+
+LegacyStatus IpcJsonClient::subscribeTypedByHandle(uint32_t topic, LegacyTypedEventCb cb, void* user) {
     Subscription sub;
     sub.event_cb = nullptr;
     sub.typed_cb = cb;
     sub.user = user;
-    subscriptions_[key].push_back(sub);
-    
-    return LEGACY_OK;
+    return addSubscription(topic, sub);
 }
 
 LegacyStatus IpcJsonClient::registerTypeAdapter(const LegacyTypeAdapter* adapter) {
-    if (!adapter) return LEGACY_ERR_PARAM;
-    std::string key = std::string(adapter->key.topic) + "/" + std::string(adapter->key.type_name);
+    if (!adapter || !adapter->key.topic || !adapter->key.type_name) return LEGACY_ERR_PARAM;
+    if (!adapter->encode_cbor != !adapter->decode_cbor) return LEGACY_ERR_PARAM;
+    if (adapter->desc && !StructCodec::validate(adapter->desc)) {
+        logError("[IpcJsonClient] Invalid struct descriptor for %s/%s", adapter->key.topic, adapter->key.type_name);
+        return LEGACY_ERR_PARAM;
+    }
+    uint32_t handle = 0;
+    LegacyStatus st = topicHandle(adapter->key.topic, adapter->key.type_name, &handle);
+    if (st != LEGACY_OK) return st;
     
 #ifdef _VXWORKS_
     SemLockGuard lock(adapter_sem_);
 #else
     std::lock_guard<std::mutex> lock(adapter_mutex_);
 #endif
-    type_adapters_[key] = *adapter;
+    if (type_adapters_.size() <= handle) {
+        AdapterSlot empty;
+        memset(&empty, 0, sizeof(empty));
+        type_adapters_.resize(handle + 1, empty);
+    }
+    type_adapters_[handle].set = true;
+    type_adapters_[handle].adapter = *adapter;
     return LEGACY_OK;
 }
 
 LegacyStatus IpcJsonClient::unregisterTypeAdapter(const char* topic, const char* type_name) {
-    std::string key = std::string(topic) + "/" + std::string(type_name);
+    uint32_t handle = topics_.find(topic, strlen(topic), type_name, strlen(type_name));
+    if (handle == 0) return LEGACY_OK;
     
 #ifdef _VXWORKS_
     SemLockGuard lock(adapter_sem_);
 #else
     std::lock_guard<std::mutex> lock(adapter_mutex_);
 #endif
-    type_adapters_.erase(key);
+    if (handle < type_adapters_.size()) type_adapters_[handle].set = false;
     return LEGACY_OK;
 }
 
-const LegacyTypeAdapter* IpcJsonClient::findTypeAdapter(const char* topic, const char* type_name) {
-    std::string key = std::string(topic) + "/" + std::string(type_name);
+void IpcJsonClient::getDispatchStats(LegacyDispatchStats* out_stats) {
+    dispatch_.getStats(out_stats);
+}
+
+bool IpcJsonClient::copyTypeAdapter(uint32_t topic, LegacyTypeAdapter* out) {
 #ifdef _VXWORKS_
     SemLockGuard lock(adapter_sem_);
 #else
     std::lock_guard<std::mutex> lock(adapter_mutex_);
 #endif
-    auto it = type_adapters_.find(key);
-    if (it != type_adapters_.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    if (topic >= type_adapters_.size() || !type_adapters_[topic].set) return false;
+    *out = type_adapters_[topic].adapter;
+    return true;
 }
 
 void IpcJsonClient::logInfo(const char* fmt, ...) {
@@ -768,10 +1552,14 @@ void IpcJsonClient::getPerfStats(LegacyPerfStats* out_stats) {
     out_stats->ipc_cbor_count = cbor_count_.load();
     out_stats->write_ns_total = write_ns_total_.load();
     out_stats->write_count = write_count_.load();
+    out_stats->recv_wakeup_count = recv_wakeup_count_.load();
+    out_stats->recv_msg_count = recv_msg_count_.load();
     uint64_t send_us_total = 0; uint32_t send_count = 0;
     transport_.getPerfStats(&send_us_total, &send_count);
     out_stats->transport_send_us_total = send_us_total;
     out_stats->transport_send_count = send_count;
+    transport_.getBatchStats(&out_stats->send_batch_flush_count, &out_stats->send_batch_frame_count);
+    out_stats->unmatched_reply_count = unmatched_reply_count_.load();
 #else
     out_stats->ipc_parse_ns_total = 0;
     out_stats->ipc_parse_count = 0;
@@ -779,7 +1567,12 @@ void IpcJsonClient::getPerfStats(LegacyPerfStats* out_stats) {
     out_stats->ipc_cbor_count = 0;
     out_stats->write_ns_total = 0;
     out_stats->write_count = 0;
+    out_stats->recv_wakeup_count = 0;
+    out_stats->recv_msg_count = 0;
     out_stats->transport_send_us_total = 0;
     out_stats->transport_send_count = 0;
+    out_stats->send_batch_flush_count = 0;
+    out_stats->send_batch_frame_count = 0;
+    out_stats->unmatched_reply_count = unmatched_reply_count_.load();
 #endif
 }
@@ -1,12 +1,28 @@
 #pragma once
 #include "DkmRtpIpc.h"
+#include "PendingTable.h"
+#include "SyncWaiter.h"
+#include "DispatchPool.h"
+#include "TopicRegistry.h"
+#include "SubscriptionTable.h"
 #include "legacy_agent.h"
 #include <string>
 #include <vector>
-#include <map>
 #include <atomic>
 #include <functional>
 
+#ifdef _VXWORKS_
+// VxWorks mbuf.h (pulled in via sockLib.h) defines m_data and m_type macros
+// which conflict with nlohmann json. Undefine them before including json.hpp
+#ifdef m_data
+#undef m_data
+#endif
+#ifdef m_type
+#undef m_type
+#endif
+#endif
+#include "json.hpp"
+
 #ifdef _VXWORKS_
 extern "C" {
 #include <vxWorks.h>
@@ -34,13 +50,6 @@ private:
 #include <mutex>
 #endif
 
-struct PendingRequest {
-    LegacySimpleCb simple_cb;
-    LegacyHelloCb hello_cb;
-    void* user;
-    // Add other callback types as needed
-};
-
 class IpcJsonClient {
 public:
     IpcJsonClient();
@@ -49,15 +58,28 @@ public:
     LegacyStatus init(const LegacyConfig* cfg);
     void close();
 
-    // Control Plane
-    LegacyStatus sendHello(uint32_t timeout_ms, LegacyHelloCb cb, void* user);
+    // Control Plane (waiter != nullptr: completion goes to a blocked _sync caller)
+    LegacyStatus sendHello(uint32_t timeout_ms, LegacyHelloCb cb, void* user, SyncWaiter* waiter = nullptr);
     
-    LegacyStatus createParticipant(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user);
-    LegacyStatus createPublisher(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user);
-    LegacyStatus createSubscriber(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user);
-    LegacyStatus createWriter(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user);
-    LegacyStatus createReader(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user);
-    LegacyStatus clearEntities(uint32_t timeout_ms, LegacySimpleCb cb, void* user);
+    LegacyStatus createParticipant(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+    LegacyStatus createPublisher(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+    LegacyStatus createSubscriber(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+    LegacyStatus createWriter(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+    LegacyStatus createReader(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+    LegacyStatus clearEntities(uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter = nullptr);
+
+    // Bulk creation: one pipelined burst, one aggregated completion
+    LegacyStatus createEntities(const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacyBulkCb cb, void* user);
+    LegacyStatus createEntitiesSync(const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacySyncResult* out_results);
+
+    // Blocking control calls: return once the reply (or the timeout) arrived
+    LegacyStatus sendHelloSync(uint32_t timeout_ms, LegacySyncResult* out_res, int* out_proto);
+    LegacyStatus createParticipantSync(const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res);
+    LegacyStatus createPublisherSync(const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res);
+    LegacyStatus createSubscriberSync(const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res);
+    LegacyStatus createWriterSync(const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res);
+    LegacyStatus createReaderSync(const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res);
+    LegacyStatus clearEntitiesSync(uint32_t timeout_ms, LegacySyncResult* out_res);
 
     // QoS
     LegacyStatus getQosList(bool include_builtin, bool detail, uint32_t timeout_ms, LegacyQosListCb cb, void* user);
@@ -65,11 +87,38 @@ public:
 
     // Data Plane
     LegacyStatus writeJson(const LegacyWriteJsonOptions* opt, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+    // Unacknowledged write: no pending entry, agent is asked not to reply
+    LegacyStatus writeJsonNoAck(const LegacyWriteJsonOptions* opt);
     LegacyStatus writeStruct(const char* topic, const char* type_name, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+    LegacyStatus writeJsonByHandle(uint32_t topic, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+    LegacyStatus writeJsonNoAckByHandle(uint32_t topic, const char* data_json);
+    LegacyStatus writeStructByHandle(uint32_t topic, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+
+    // Pre-encoded write envelope of one writer (legacy_agent_open_writer)
+    struct WriterTemplate {
+        uint32_t topic;                     // topic handle for write_struct (0: no type given)
+        std::vector<uint8_t> head;          // map head, "args":{..}, "data" key
+        std::vector<uint8_t> head_noack;    // same with "ack":false in args
+        std::vector<uint8_t> tail;          // "op", "proto", "target"
+    };
+    LegacyStatus openWriter(const LegacyWriteJsonOptions* opt, WriterTemplate* out);
+    LegacyStatus writerWrite(const WriterTemplate& w, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+    LegacyStatus writerWriteNoAck(const WriterTemplate& w, const char* data_json);
+    LegacyStatus writerWriteStruct(const WriterTemplate& w, const void* user_struct, bool ack,
+                                   uint32_t timeout_ms, LegacyWriteCb cb, void* user);
     
+    // Send batching (frames queued in the transport, flushed together)
+    LegacyStatus setSendBatching(uint32_t max_frames, uint32_t max_delay_ms);
+    LegacyStatus flush();
+
+    // Topic handles (see TopicRegistry)
+    LegacyStatus topicHandle(const char* topic, const char* type, uint32_t* out_handle);
+
     // Events
     LegacyStatus subscribeEvent(const char* topic, const char* type, LegacyEventCb cb, void* user);
     LegacyStatus subscribeTyped(const char* topic, const char* type_name, LegacyTypedEventCb cb, void* user);
+    LegacyStatus subscribeEventByHandle(uint32_t topic, LegacyEventCb cb, void* user);
+    LegacyStatus subscribeTypedByHandle(uint32_t topic, LegacyTypedEventCb cb, void* user);
 
     // Type Adapters
     LegacyStatus registerTypeAdapter(const LegacyTypeAdapter* adapter);
@@ -80,8 +129,79 @@ private:
     static void recvTaskEntry(uintptr_t arg);
 #endif
     void receiveLoop();
+    // Decode one received payload and route it to a subscription or pending request
+    void dispatchMessage(const uint8_t* data, size_t len, const DkmRtpIpc::FrameInfo& frame);
+
+    // Fields of a data event located by scanning the CBOR envelope in place
+    struct EventEnvelope {
+        const char* topic;
+        size_t topic_len;
+        const char* type;
+        size_t type_len;
+        const uint8_t* data;        // the "data" item (NULL if absent)
+        size_t data_len;
+    };
+    static bool scanEvent(const uint8_t* payload, size_t len, EventEnvelope& env);
+    // Receive task: deliver inline, or queue for the worker owning the topic
+    void routeEvent(const uint8_t* payload, size_t len, const EventEnvelope& env);
+    // Run the callbacks of one event; a DOM is built only if a callback needs JSON
+    struct DispatchScratch;
+    void deliverEvent(const uint8_t* payload, size_t len, const EventEnvelope& env, uint32_t topic, DispatchScratch& scratch);
+    static void dispatchWorkerEntry(void* ctx, uint32_t worker, const DispatchPool::Item& item);
+    // Decode the event data into a struct by descriptor
+    bool decodeTypedData(const LegacyTypeAdapter& adapter, const EventEnvelope& env, void* out, DispatchScratch& scratch);
     uint32_t generateRequestId();
-    void registerRequest(uint32_t reqId, const PendingRequest& req);
+    // Claims a pending slot; on a slot collision reqId is replaced by a fresh id
+    LegacyStatus registerRequest(uint32_t& reqId, const PendingRequest& req, uint32_t timeout_ms);
+    // Withdraw a registered request whose send failed (st): returns st when no
+    // callback will follow, LEGACY_OK when the request completed meanwhile
+    LegacyStatus abortRequest(uint32_t reqId, SyncWaiter* waiter, LegacyStatus st);
+    // Fail requests whose deadline passed (receive task only)
+    void expireRequests();
+    // Issue a request carrying a pooled waiter and block until it completes
+    LegacyStatus runSync(uint32_t timeout_ms, LegacySyncResult* out_res, int* out_proto,
+                         const std::function<LegacyStatus(SyncWaiter*)>& issue);
+    // Hand a reply/timeout to a blocked caller (receive task only)
+    void completeSync(SyncWaiter* waiter, const LegacySimpleResult* res, int proto, bool timed_out);
+    bool onReceiveTask() const;
+
+    LegacyStatus createEntity(const LegacyEntityDesc& desc, uint32_t timeout_ms, LegacySimpleCb cb, void* user, SyncWaiter* waiter);
+
+    // One bulk creation in flight. Each entity is its own pending request whose
+    // user pointer is its BulkEntry; 'refs' counts outstanding entities plus one
+    // for the issuing task, and whoever drops it to zero reports the results.
+    struct BulkOp;
+    struct BulkEntry {
+        BulkOp* op;
+        size_t index;
+    };
+    struct BulkOp {
+        BulkOp(IpcJsonClient* c, size_t count)
+            : client(c), cb(nullptr), user(nullptr), waiter(nullptr)
+            , entries(count), results(count), msgs(count), timed_out(count, 0), refs(count + 1) {
+            for (size_t i = 0; i < count; ++i) {
+                entries[i].op = this;
+                entries[i].index = i;
+                results[i].reqId = 0;
+                results[i].ok = false;
+                results[i].err = 0;
+                results[i].msg = "";
+            }
+        }
+        IpcJsonClient* client;
+        LegacyBulkCb cb;
+        void* user;
+        SyncWaiter* waiter;           // set for createEntitiesSync
+        std::vector<BulkEntry> entries;
+        std::vector<LegacyEntityResult> results;
+        std::vector<std::string> msgs;
+        std::vector<uint8_t> timed_out;
+        std::atomic<size_t> refs;
+    };
+    static void bulkEntryCb(LEGACY_HANDLE h, LegacyRequestId reqId, const LegacySimpleResult* res, void* user);
+    // Register and queue every entity of a bulk op; returns how many were registered
+    size_t issueBulk(BulkOp* op, const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacyStatus* out_err);
+    void releaseBulk(BulkOp* op, size_t n);
     
     // Logging helper (printf-style)
     void logInfo(const char* fmt, ...);
@@ -90,9 +210,32 @@ private:
     
     // Helper to send raw JSON with header
     LegacyStatus sendRequest(const std::string& json_body, uint16_t type = 0x1000, uint32_t req_id = 0);
+    // Encode an already built DOM straight into cbor_buf_ (no dump/re-parse)
+    LegacyStatus sendRequest(const nlohmann::json& body, uint16_t type = 0x1000, uint32_t req_id = 0);
+    // Same, for callers already holding the send lock
+    LegacyStatus encodeAndSend(const nlohmann::json& body, uint16_t type, uint32_t req_id);
+    // Data value of a write: JSON text, or a struct encoded by its codec/descriptor
+    struct WriteData {
+        const char* json;
+        const LegacyStructDesc* desc;   // set: 'obj' is encoded, 'json' unused
+        const void* obj;
+        void (*encode_cbor)(LegacyCborWriter* w, const void* obj);  // set: used instead of 'desc'
+    };
+    // Stream a write envelope (and its data) into cbor_buf_ without a DOM;
+    // with a writer template only the data is encoded
+    LegacyStatus sendWriteRequest(const LegacyWriteJsonOptions* opt, const WriterTemplate* tmpl,
+                                  const WriteData& data, uint32_t req_id, bool ack);
+    // Register (when acked) and send one write
+    LegacyStatus issueWrite(const LegacyWriteJsonOptions* opt, const WriterTemplate* tmpl, const WriteData& data,
+                            bool ack, uint32_t timeout_ms, LegacyWriteCb cb, void* user);
+    // Data of a write_struct through the topic's adapter (descriptor or encode())
+    LegacyStatus structData(uint32_t topic, const void* user_struct, WriteData* out);
 
     // Type Adapter Helper
-    const LegacyTypeAdapter* findTypeAdapter(const char* topic, const char* type_name);
+    bool copyTypeAdapter(uint32_t topic, LegacyTypeAdapter* out);
+
+    typedef SubscriptionTable::Subscription Subscription;
+    LegacyStatus addSubscription(uint32_t topic, const Subscription& sub);
 
 private:
     DkmRtpIpc transport_;
@@ -105,36 +248,46 @@ private:
 #endif
     std::atomic<bool> running_;
     
-#ifdef _VXWORKS_
-    SEM_ID req_sem_;
-#else
-    std::mutex req_mutex_;
-#endif
-    std::map<uint32_t, PendingRequest> pending_requests_;
+    // In-flight requests: lock-free insert from any task, completion/expiry
+    // on the receive task only (see PendingTable)
+    static const uint32_t kDefaultTimeoutMs = 5000; // used when timeout_ms is 0
+    static const int kRegisterAttempts = 8;         // fresh ids tried on slot collision
+    PendingTable pending_;
     std::atomic<uint32_t> next_req_id_;
+    std::vector<std::pair<uint32_t, PendingRequest>> expired_; // receive task scratch
 
-    // Event Subscriptions
-    struct Subscription {
-        LegacyEventCb event_cb;
-        LegacyTypedEventCb typed_cb;
-        void* user;
+    // Wait objects for _sync calls; the extra wait covers wheel tick + receive poll
+    static const uint32_t kSyncWaitMarginMs = 500;
+    SyncWaiterPool sync_waiters_;
+
+    // Interned topic/type pairs; the tables below are indexed by handle
+    TopicRegistry topics_;
+
+    // Event Subscriptions: read without locking by the delivering tasks
+    SubscriptionTable subscriptions_;
+
+    // Per delivering task (receive task or one dispatch worker)
+    struct DispatchScratch {
+        DispatchScratch() : reader(0) {}
+        uint32_t reader;                    // SubscriptionTable reader slot
+        std::vector<uint64_t> typed_buf;    // decoded typed struct (8-byte aligned)
+        std::vector<uint8_t> typed_cbor;    // CBOR form of data that arrived as JSON text
     };
-    // Key: "topic/type"
-#ifdef _VXWORKS_
-    SEM_ID sub_sem_;
-#else
-    std::mutex sub_mutex_;
-#endif
-    std::map<std::string, std::vector<Subscription>> subscriptions_;
+    DispatchScratch recv_scratch_;
+    std::vector<DispatchScratch> worker_scratch_;
+    DispatchPool dispatch_;
 
     // Type Adapters
-    // Key: "topic/type"
+    struct AdapterSlot {
+        bool set;
+        LegacyTypeAdapter adapter;
+    };
 #ifdef _VXWORKS_
     SEM_ID adapter_sem_;
 #else
     std::mutex adapter_mutex_;
 #endif
-    std::map<std::string, LegacyTypeAdapter> type_adapters_;
+    std::vector<AdapterSlot> type_adapters_;
     // Perf accumulation (when DEMO_PERF_INSTRUMENTATION enabled)
     std::atomic<uint64_t> parse_ns_total_{0};
     std::atomic<uint32_t> parse_count_{0};
@@ -142,11 +295,42 @@ private:
     std::atomic<uint32_t> cbor_count_{0};
     std::atomic<uint64_t> write_ns_total_{0};
     std::atomic<uint32_t> write_count_{0};
+    std::atomic<uint32_t> recv_wakeup_count_{0};
+    std::atomic<uint32_t> recv_msg_count_{0};
+    std::atomic<uint32_t> unmatched_reply_count_{0};
+    // Receive task only: set once a reply carried a request id. Replies
+    // without one are then never matched by age (see dispatchMessage).
+    bool peer_correlates_ = false;
 
-    // Per-instance reusable CBOR buffer to avoid per-call allocations
+    // Per-instance reusable CBOR buffer to avoid per-call allocations.
+    // Guarded by send lock: callers may write from several tasks.
+#ifdef _VXWORKS_
+    SEM_ID send_sem_;
+#else
+    std::mutex send_mutex_;
+#endif
     std::vector<uint8_t> cbor_buf_;
 
 public:
     // Fill a LegacyPerfStats structure with accumulated library perf counters
     void getPerfStats(LegacyPerfStats* out_stats);
+    void getDispatchStats(LegacyDispatchStats* out_stats);
+
+    // Backing for legacy_result_raw_json / legacy_event_raw_json: 'priv' of a
+    // result or event delivered to a callback (NULL when there is no document)
+    static const char* rawJson(const void* priv);
+
+private:
+    // Received document whose text form is produced on first request. Events
+    // start with only the CBOR payload; the DOM is decoded on first use too.
+    struct RawJsonSource {
+        RawJsonSource() : cbor(nullptr), cbor_len(0), doc(nullptr), serialized(false) {}
+        const nlohmann::json* document();   // NULL if the payload does not decode
+        const uint8_t* cbor;
+        size_t cbor_len;
+        const nlohmann::json* doc;
+        nlohmann::json owned;
+        bool serialized;
+        std::string text;
+    };
 };
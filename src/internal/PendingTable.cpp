@@ -0,0 +1,163 @@
+#include "PendingTable.h"
+
+PendingTable::PendingTable()
+    : incoming_head_(kNil)
+    , wheel_tick_(0)
+{
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+        slots_[i].state.store(SLOT_FREE, std::memory_order_relaxed);
+        slots_[i].req_id = 0;
+        slots_[i].incoming_next = kNil;
+        slots_[i].wheel_prev = kNil;
+        slots_[i].wheel_next = kNil;
+        slots_[i].wheel_bucket = kNil;
+    }
+    for (uint32_t b = 0; b < kWheelSlots; ++b) {
+        wheel_heads_[b] = kNil;
+    }
+}
+
+bool PendingTable::insert(uint32_t req_id, const PendingRequest& req) {
+    uint32_t idx = req_id & (kCapacity - 1);
+    Slot& s = slots_[idx];
+
+    uint32_t expected = SLOT_FREE;
+    if (!s.state.compare_exchange_strong(expected, SLOT_CLAIMED, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return false; // older request with the same index still in flight
+    }
+    s.req_id = req_id;
+    s.req = req;
+
+    // Hand the slot to the receive task (Treiber push; the consumer takes the
+    // whole stack with one exchange, so there is no ABA on pop)
+    uint32_t head = incoming_head_.load(std::memory_order_relaxed);
+    do {
+        s.incoming_next = head;
+    } while (!incoming_head_.compare_exchange_weak(head, idx, std::memory_order_release, std::memory_order_relaxed));
+
+    // Matchable only once it is reachable through the incoming stack
+    s.state.store(SLOT_ACTIVE, std::memory_order_release);
+    return true;
+}
+
+bool PendingTable::cancel(uint32_t req_id) {
+    uint32_t idx = req_id & (kCapacity - 1);
+    Slot& s = slots_[idx];
+    // The slot is not reused before it is completed or expired, and then the
+    // CAS below fails; the id check only rejects a stale id
+    if (s.req_id != req_id) return false;
+    uint32_t expected = SLOT_ACTIVE;
+    return s.state.compare_exchange_strong(expected, SLOT_CANCELLED, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+void PendingTable::collectNew() {
+    uint32_t idx = incoming_head_.exchange(kNil, std::memory_order_acquire);
+    while (idx != kNil) {
+        Slot& s = slots_[idx];
+        uint32_t next = s.incoming_next;
+        if (s.state.load(std::memory_order_acquire) == SLOT_CANCELLED) {
+            s.state.store(SLOT_FREE, std::memory_order_release); // never filed
+        } else {
+            wheelLink(idx);
+        }
+        idx = next;
+    }
+}
+
+void PendingTable::wheelLink(uint32_t idx) {
+    Slot& s = slots_[idx];
+    // Round the deadline up to a tick so a bucket is never visited before
+    // the deadlines it holds; never file into a bucket already passed
+    uint64_t tick = (s.req.deadline_ms + kWheelTickMs - 1) / kWheelTickMs;
+    if (tick <= wheel_tick_) tick = wheel_tick_ + 1;
+    uint32_t b = (uint32_t)(tick % kWheelSlots);
+
+    s.wheel_bucket = b;
+    s.wheel_prev = kNil;
+    s.wheel_next = wheel_heads_[b];
+    if (s.wheel_next != kNil) slots_[s.wheel_next].wheel_prev = idx;
+    wheel_heads_[b] = idx;
+}
+
+void PendingTable::wheelUnlink(uint32_t idx) {
+    Slot& s = slots_[idx];
+    if (s.wheel_prev != kNil) {
+        slots_[s.wheel_prev].wheel_next = s.wheel_next;
+    } else {
+        wheel_heads_[s.wheel_bucket] = s.wheel_next;
+    }
+    if (s.wheel_next != kNil) slots_[s.wheel_next].wheel_prev = s.wheel_prev;
+    s.wheel_prev = kNil;
+    s.wheel_next = kNil;
+    s.wheel_bucket = kNil;
+}
+
+// Receive task: take the slot over from the sender (ACTIVE -> CLAIMED);
+// fails when the sender cancelled it first
+bool PendingTable::claim(uint32_t idx) {
+    uint32_t expected = SLOT_ACTIVE;
+    return slots_[idx].state.compare_exchange_strong(expected, SLOT_CLAIMED, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+void PendingTable::release(uint32_t idx, uint32_t* out_id, PendingRequest* out) {
+    Slot& s = slots_[idx];
+    // A claimed slot was pushed; file it first if not collected yet
+    if (s.wheel_bucket == kNil) collectNew();
+    wheelUnlink(idx);
+    if (out_id) *out_id = s.req_id;
+    if (out) *out = s.req;
+    s.state.store(SLOT_FREE, std::memory_order_release);
+}
+
+bool PendingTable::take(uint32_t req_id, PendingRequest* out) {
+    uint32_t idx = req_id & (kCapacity - 1);
+    Slot& s = slots_[idx];
+    if (s.state.load(std::memory_order_acquire) != SLOT_ACTIVE || s.req_id != req_id) {
+        return false; // unknown, already completed/expired, or slot reused
+    }
+    if (!claim(idx)) return false; // cancelled by the sender; expiry frees it
+    release(idx, nullptr, out);
+    return true;
+}
+
+bool PendingTable::takeOldest(uint32_t* out_id, PendingRequest* out) {
+    uint32_t best = kNil;
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+        if (slots_[i].state.load(std::memory_order_acquire) != SLOT_ACTIVE) continue;
+        if (best == kNil || slots_[i].req_id < slots_[best].req_id) best = i;
+    }
+    if (best == kNil || !claim(best)) return false;
+    release(best, out_id, out);
+    return true;
+}
+
+void PendingTable::expire(uint64_t now_ms, std::vector<std::pair<uint32_t, PendingRequest>>& out) {
+    collectNew();
+
+    uint64_t now_tick = now_ms / kWheelTickMs;
+    if (now_tick <= wheel_tick_) return;
+    // A full revolution visits every bucket; no need to walk further
+    uint64_t first = wheel_tick_ + 1;
+    if (now_tick - wheel_tick_ > kWheelSlots) first = now_tick - kWheelSlots + 1;
+
+    for (uint64_t t = first; t <= now_tick; ++t) {
+        uint32_t idx = wheel_heads_[t % kWheelSlots];
+        while (idx != kNil) {
+            Slot& s = slots_[idx];
+            uint32_t next = s.wheel_next;
+            // Cancelled entries are dropped silently. Later-round entries stay,
+            // and so does a slot still being published.
+            bool drop = s.state.load(std::memory_order_acquire) == SLOT_CANCELLED;
+            if (!drop && s.req.deadline_ms <= now_ms && s.state.load(std::memory_order_acquire) == SLOT_ACTIVE) {
+                if (claim(idx)) out.push_back(std::make_pair(s.req_id, s.req));
+                drop = true; // expired, or cancelled just now
+            }
+            if (drop) {
+                wheelUnlink(idx);
+                s.state.store(SLOT_FREE, std::memory_order_release);
+            }
+            idx = next;
+        }
+    }
+    wheel_tick_ = now_tick;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "legacy_agent.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <atomic>
+
+class SyncWaiter;
+
+struct PendingRequest {
+    LegacySimpleCb simple_cb;
+    LegacyHelloCb hello_cb;
+    LegacyQosListCb qos_cb = nullptr;
+    void* user;
+    uint64_t deadline_ms;   // monotonic ms; expired by the receive task
+    SyncWaiter* waiter = nullptr; // blocking (_sync) call: completed instead of a callback
+    // Add other callback types as needed
+};
+
+// Fixed-capacity table of in-flight requests, indexed by req_id & (kCapacity-1).
+//
+// Threading model:
+//  - insert() may be called from any task and is lock-free and allocation-free:
+//    a slot is claimed with one CAS (FREE -> CLAIMED), filled, published as
+//    ACTIVE and pushed on a lock-free "incoming" stack.
+//  - cancel() is called by the task that inserted the request when its send
+//    failed: one CAS (ACTIVE -> CANCELLED). The receive task claims a slot the
+//    same way (ACTIVE -> CLAIMED) before completing it, so exactly one side
+//    wins and a cancelled request never gets a callback.
+//  - Everything else (take, takeOldest, collectNew, expire) runs on the receive
+//    task only. That task owns the timeout wheel, so completion and expiry need
+//    no locks either; a slot returns to FREE only after leaving the wheel.
+//    Cancelled slots are dropped silently when collected or visited by expiry.
+//
+// The req_id stored in a slot is its generation tag: a reply whose id maps to a
+// slot now holding a newer request is not matched.
+class PendingTable {
+public:
+    static const uint32_t kCapacity = 1024;      // power of two
+    static const uint32_t kWheelTickMs = 50;
+    static const uint32_t kWheelSlots = 128;     // 6.4 s per revolution
+
+    PendingTable();
+
+    // Producer side. Fails (false) when the slot for req_id is still occupied by
+    // an older in-flight request; callers then retry with a fresh id.
+    bool insert(uint32_t req_id, const PendingRequest& req);
+    // Producer side: withdraw a request whose send failed. False when the
+    // receive task already completed or expired it (its callback then runs).
+    bool cancel(uint32_t req_id);
+
+    // Receive task: file newly inserted requests into the timeout wheel.
+    void collectNew();
+    // Receive task: remove the request with this id (reply matched).
+    bool take(uint32_t req_id, PendingRequest* out);
+    // Receive task: remove the oldest request (replies carrying no id). O(capacity).
+    bool takeOldest(uint32_t* out_id, PendingRequest* out);
+    // Receive task: remove every request whose deadline passed, O(1) each.
+    void expire(uint64_t now_ms, std::vector<std::pair<uint32_t, PendingRequest>>& out);
+
+private:
+    enum : uint32_t { SLOT_FREE = 0, SLOT_CLAIMED = 1, SLOT_ACTIVE = 2, SLOT_CANCELLED = 3 };
+    static const uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Slot {
+        std::atomic<uint32_t> state;
+        uint32_t req_id;
+        PendingRequest req;
+        uint32_t incoming_next;   // link in the incoming stack
+        // Wheel links (receive task only)
+        uint32_t wheel_prev;
+        uint32_t wheel_next;
+        uint32_t wheel_bucket;    // kNil when not filed
+    };
+
+    void wheelLink(uint32_t idx);
+    void wheelUnlink(uint32_t idx);
+    bool claim(uint32_t idx);
+    void release(uint32_t idx, uint32_t* out_id, PendingRequest* out);
+
+    Slot slots_[kCapacity];
+    std::atomic<uint32_t> incoming_head_;
+    uint32_t wheel_heads_[kWheelSlots];
+    uint64_t wheel_tick_;         // last visited tick
+};
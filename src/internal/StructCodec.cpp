@@ -0,0 +1,405 @@
+#include "StructCodec.h"
+#include <cstring>
+
+// Nesting limits (decoding runs on the receive task stack)
+static const int kMaxStructDepth = 8;
+
+static bool int_size_ok(size_t size) {
+    return size == 1 || size == 2 || size == 4 || size == 8;
+}
+
+static void store_int(uint8_t* dst, size_t size, int64_t v) {
+    switch (size) {
+    case 1: { int8_t x = (int8_t)v; memcpy(dst, &x, 1); break; }
+    case 2: { int16_t x = (int16_t)v; memcpy(dst, &x, 2); break; }
+    case 4: { int32_t x = (int32_t)v; memcpy(dst, &x, 4); break; }
+    default: memcpy(dst, &v, 8); break;
+    }
+}
+
+static int64_t load_int(const uint8_t* src, size_t size) {
+    switch (size) {
+    case 1: { int8_t x; memcpy(&x, src, 1); return x; }
+    case 2: { int16_t x; memcpy(&x, src, 2); return x; }
+    case 4: { int32_t x; memcpy(&x, src, 4); return x; }
+    default: { int64_t x; memcpy(&x, src, 8); return x; }
+    }
+}
+
+static uint64_t load_uint(const uint8_t* src, size_t size) {
+    switch (size) {
+    case 1: { uint8_t x; memcpy(&x, src, 1); return x; }
+    case 2: { uint16_t x; memcpy(&x, src, 2); return x; }
+    case 4: { uint32_t x; memcpy(&x, src, 4); return x; }
+    default: { uint64_t x; memcpy(&x, src, 8); return x; }
+    }
+}
+
+// Integer value of a number item; floats are truncated (when in range)
+static bool read_integer(CborReader& r, int64_t& v, bool& handled) {
+    handled = true;
+    switch (r.peek()) {
+    case CborReader::KIND_UINT: {
+        if (r.readInt(v)) return true;
+        uint64_t u;
+        if (!r.readUInt(u)) return false;
+        v = (int64_t)u;                 // above INT64_MAX: keep the bit pattern (UINT fields)
+        return true;
+    }
+    case CborReader::KIND_NINT:
+        if (r.readInt(v)) return true;
+        handled = false;                // below INT64_MIN
+        return r.skip();
+    case CborReader::KIND_FLOAT: {
+        double d;
+        if (!r.readDouble(d)) return false;
+        if (!(d > -9.2e18 && d < 9.2e18)) {
+            handled = false;            // NaN or out of range
+            return true;
+        }
+        v = (int64_t)d;
+        return true;
+    }
+    default:
+        handled = false;
+        return r.skip();
+    }
+}
+
+static const LegacyFieldDesc* find_field(const LegacyStructDesc* desc, const char* key, size_t len, size_t& hint) {
+    // Encoders emit keys in a fixed order, so start after the last match
+    size_t n = desc->field_count;
+    for (size_t i = 0; i < n; ++i) {
+        size_t idx = hint + i;
+        if (idx >= n) idx -= n;
+        const char* name = desc->fields[idx].name;
+        if (strncmp(name, key, len) == 0 && name[len] == '\0') {
+            hint = (idx + 1 < n) ? idx + 1 : 0;
+            return &desc->fields[idx];
+        }
+    }
+    return nullptr;
+}
+
+bool StructCodec::validate(const LegacyStructDesc* desc) {
+    return validateStruct(desc, 0);
+}
+
+bool StructCodec::validateStruct(const LegacyStructDesc* desc, int depth) {
+    if (!desc || desc->size == 0 || depth > kMaxStructDepth) return false;
+    if (desc->field_count > 0 && !desc->fields) return false;
+    for (size_t i = 0; i < desc->field_count; ++i) {
+        const LegacyFieldDesc& f = desc->fields[i];
+        if (!f.name) return false;
+        size_t count = f.count ? f.count : 1;
+        if (f.size == 0 || f.offset > desc->size || count > (desc->size - f.offset) / f.size) return false;
+        switch (f.type) {
+        case LEGACY_FIELD_BOOL:
+        case LEGACY_FIELD_INT:
+        case LEGACY_FIELD_UINT:
+            if (!int_size_ok(f.size)) return false;
+            break;
+        case LEGACY_FIELD_FLOAT:
+            if (f.size != sizeof(float) && f.size != sizeof(double)) return false;
+            break;
+        case LEGACY_FIELD_STRING:
+            break;
+        case LEGACY_FIELD_ENUM:
+            if (f.size != 1 && f.size != 2 && f.size != 4) return false;
+            if (f.enum_count > 0 && !f.enums) return false;
+            break;
+        case LEGACY_FIELD_STRUCT:
+            if (!f.nested || f.nested->size > f.size) return false;
+            if (!validateStruct(f.nested, depth + 1)) return false;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StructCodec::decode(CborReader& r, const LegacyStructDesc* desc, void* out) {
+    return decodeStruct(r, desc, static_cast<uint8_t*>(out), 0);
+}
+
+bool StructCodec::decodeStruct(CborReader& r, const LegacyStructDesc* desc, uint8_t* base, int depth) {
+    size_t pairs;
+    if (depth > kMaxStructDepth || !r.readMap(pairs)) return false;
+    size_t hint = 0;
+    for (size_t i = 0; pairs == CborReader::kIndefinite ? !r.readBreak() : i < pairs; ++i) {
+        const char* key;
+        size_t klen;
+        const LegacyFieldDesc* f = nullptr;
+        if (r.readText(key, klen)) {
+            f = find_field(desc, key, klen, hint);
+        } else if (!r.skip()) {
+            return false;               // non-text keys are never fields
+        }
+        if (!f) {
+            if (!r.skip()) return false;
+            continue;
+        }
+        if (!decodeField(r, *f, base + f->offset, depth)) return false;
+    }
+    return true;
+}
+
+bool StructCodec::decodeField(CborReader& r, const LegacyFieldDesc& f, uint8_t* dst, int depth) {
+    if (f.count <= 1) return decodeScalar(r, f, dst, depth);
+
+    size_t items;
+    if (r.peek() != CborReader::KIND_ARRAY) return r.skip();
+    if (!r.readArray(items)) return false;
+    for (size_t i = 0; items == CborReader::kIndefinite ? !r.readBreak() : i < items; ++i) {
+        bool ok = (i < f.count) ? decodeScalar(r, f, dst + i * f.size, depth) : r.skip();
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool StructCodec::decodeScalar(CborReader& r, const LegacyFieldDesc& f, uint8_t* dst, int depth) {
+    CborReader::Kind k = r.peek();
+    if (k == CborReader::KIND_NULL) return r.skip();
+
+    switch (f.type) {
+    case LEGACY_FIELD_BOOL: {
+        bool b;
+        if (k == CborReader::KIND_BOOL) {
+            if (!r.readBool(b)) return false;
+        } else {
+            int64_t v;
+            bool handled;
+            if (!read_integer(r, v, handled)) return false;
+            if (!handled) return true;
+            b = (v != 0);
+        }
+        if (f.size == sizeof(bool)) {
+            memcpy(dst, &b, sizeof(bool));
+        } else {
+            store_int(dst, f.size, b ? 1 : 0);
+        }
+        return true;
+    }
+    case LEGACY_FIELD_INT:
+    case LEGACY_FIELD_UINT: {
+        int64_t v;
+        bool handled;
+        if (!read_integer(r, v, handled)) return false;
+        if (handled) store_int(dst, f.size, v);
+        return true;
+    }
+    case LEGACY_FIELD_FLOAT: {
+        double d;
+        if (k != CborReader::KIND_FLOAT && k != CborReader::KIND_UINT && k != CborReader::KIND_NINT) {
+            return r.skip();
+        }
+        if (!r.readDouble(d)) return false;
+        if (f.size == sizeof(float)) {
+            float x = (float)d;
+            memcpy(dst, &x, sizeof(float));
+        } else {
+            memcpy(dst, &d, sizeof(double));
+        }
+        return true;
+    }
+    case LEGACY_FIELD_STRING: {
+        const char* s;
+        size_t len;
+        if (!r.readText(s, len)) return r.skip();
+        if (len > f.size - 1) len = f.size - 1;
+        memcpy(dst, s, len);
+        dst[len] = '\0';
+        return true;
+    }
+    case LEGACY_FIELD_ENUM: {
+        const char* s;
+        size_t len;
+        if (r.readText(s, len)) {
+            for (size_t i = 0; i < f.enum_count; ++i) {
+                const char* name = f.enums[i].name;
+                if (name && strncmp(name, s, len) == 0 && name[len] == '\0') {
+                    store_int(dst, f.size, f.enums[i].value);
+                    break;
+                }
+            }
+            return true;                // unknown enumerator: left as is
+        }
+        int64_t v;
+        bool handled;
+        if (!read_integer(r, v, handled)) return false;
+        if (handled) store_int(dst, f.size, v);
+        return true;
+    }
+    case LEGACY_FIELD_STRUCT:
+        if (k != CborReader::KIND_MAP) return r.skip();
+        return decodeStruct(r, f.nested, dst, depth + 1);
+    default:
+        return r.skip();
+    }
+}
+
+void StructCodec::encode(CborWriter& w, const LegacyStructDesc* desc, const void* in) {
+    encodeStruct(w, desc, static_cast<const uint8_t*>(in));
+}
+
+void StructCodec::encodeStruct(CborWriter& w, const LegacyStructDesc* desc, const uint8_t* base) {
+    // Depth is bounded by validate()
+    w.beginMap(desc->field_count);
+    for (size_t i = 0; i < desc->field_count; ++i) {
+        const LegacyFieldDesc& f = desc->fields[i];
+        w.writeText(f.name);
+        const uint8_t* src = base + f.offset;
+        if (f.count <= 1) {
+            encodeScalar(w, f, src);
+            continue;
+        }
+        w.beginArray(f.count);
+        for (size_t n = 0; n < f.count; ++n) {
+            encodeScalar(w, f, src + n * f.size);
+        }
+    }
+}
+
+void StructCodec::encodeScalar(CborWriter& w, const LegacyFieldDesc& f, const uint8_t* src) {
+    switch (f.type) {
+    case LEGACY_FIELD_BOOL:
+        if (f.size == sizeof(bool)) {
+            bool b;
+            memcpy(&b, src, sizeof(bool));
+            w.writeBool(b);
+        } else {
+            w.writeBool(load_uint(src, f.size) != 0);
+        }
+        break;
+    case LEGACY_FIELD_INT:
+        w.writeInt(load_int(src, f.size));
+        break;
+    case LEGACY_FIELD_UINT:
+        w.writeUInt(load_uint(src, f.size));
+        break;
+    case LEGACY_FIELD_FLOAT:
+        if (f.size == sizeof(float)) {
+            float x;
+            memcpy(&x, src, sizeof(float));
+            w.writeDouble(x);
+        } else {
+            double d;
+            memcpy(&d, src, sizeof(double));
+            w.writeDouble(d);
+        }
+        break;
+    case LEGACY_FIELD_STRING: {
+        const char* s = reinterpret_cast<const char*>(src);
+        size_t len = 0;
+        while (len < f.size && s[len] != '\0') ++len;
+        w.writeText(s, len);
+        break;
+    }
+    case LEGACY_FIELD_ENUM: {
+        int64_t v = load_int(src, f.size);
+        for (size_t i = 0; i < f.enum_count; ++i) {
+            if (f.enums[i].name && f.enums[i].value == v) {
+                w.writeText(f.enums[i].name);
+                return;
+            }
+        }
+        w.writeInt(v);                  // no enumerator: sent as a number
+        break;
+    }
+    case LEGACY_FIELD_STRUCT:
+        encodeStruct(w, f.nested, src);
+        break;
+    default:
+        w.writeNull();
+        break;
+    }
+}
+
+// Primitives of per-type codecs (legacy_agent.h): the opaque handles are the
+// encoder/decoder of the request or event being processed. Readers follow
+// the same conversions as decodeScalar.
+
+static CborWriter* writer(LegacyCborWriter* w) { return reinterpret_cast<CborWriter*>(w); }
+static CborReader* reader(LegacyCborReader* r) { return reinterpret_cast<CborReader*>(r); }
+
+static int skipped(CborReader* r) {
+    return r->skip() ? LEGACY_CBOR_SKIPPED : LEGACY_CBOR_ERROR;
+}
+
+void legacy_cbor_write_map(LegacyCborWriter* w, size_t pairs) { writer(w)->beginMap(pairs); }
+void legacy_cbor_write_array(LegacyCborWriter* w, size_t items) { writer(w)->beginArray(items); }
+void legacy_cbor_write_text(LegacyCborWriter* w, const char* s, size_t len) { writer(w)->writeText(s, len); }
+void legacy_cbor_write_int(LegacyCborWriter* w, int64_t v) { writer(w)->writeInt(v); }
+void legacy_cbor_write_uint(LegacyCborWriter* w, uint64_t v) { writer(w)->writeUInt(v); }
+void legacy_cbor_write_double(LegacyCborWriter* w, double v) { writer(w)->writeDouble(v); }
+void legacy_cbor_write_bool(LegacyCborWriter* w, bool v) { writer(w)->writeBool(v); }
+
+int legacy_cbor_read_map(LegacyCborReader* r, size_t* pairs) {
+    CborReader* cr = reader(r);
+    if (cr->peek() != CborReader::KIND_MAP) return skipped(cr);
+    return cr->readMap(*pairs) ? LEGACY_CBOR_OK : LEGACY_CBOR_ERROR;
+}
+
+int legacy_cbor_read_array(LegacyCborReader* r, size_t* items) {
+    CborReader* cr = reader(r);
+    if (cr->peek() != CborReader::KIND_ARRAY) return skipped(cr);
+    return cr->readArray(*items) ? LEGACY_CBOR_OK : LEGACY_CBOR_ERROR;
+}
+
+bool legacy_cbor_read_next(LegacyCborReader* r, size_t count, size_t i) {
+    return count == CborReader::kIndefinite ? !reader(r)->readBreak() : i < count;
+}
+
+int legacy_cbor_read_key(LegacyCborReader* r, const char** s, size_t* len) {
+    CborReader* cr = reader(r);
+    if (cr->readText(*s, *len)) return LEGACY_CBOR_OK;
+    return skipped(cr);                 // non-text keys are never fields
+}
+
+int legacy_cbor_read_bool(LegacyCborReader* r, bool* v) {
+    CborReader* cr = reader(r);
+    CborReader::Kind k = cr->peek();
+    if (k == CborReader::KIND_NULL) return skipped(cr);
+    if (k == CborReader::KIND_BOOL) return cr->readBool(*v) ? LEGACY_CBOR_OK : LEGACY_CBOR_ERROR;
+    int64_t n;
+    bool handled;
+    if (!read_integer(*cr, n, handled)) return LEGACY_CBOR_ERROR;
+    if (!handled) return LEGACY_CBOR_SKIPPED;
+    *v = (n != 0);
+    return LEGACY_CBOR_OK;
+}
+
+int legacy_cbor_read_int(LegacyCborReader* r, int64_t* v) {
+    CborReader* cr = reader(r);
+    if (cr->peek() == CborReader::KIND_NULL) return skipped(cr);
+    bool handled;
+    if (!read_integer(*cr, *v, handled)) return LEGACY_CBOR_ERROR;
+    return handled ? LEGACY_CBOR_OK : LEGACY_CBOR_SKIPPED;
+}
+
+int legacy_cbor_read_double(LegacyCborReader* r, double* v) {
+    CborReader* cr = reader(r);
+    CborReader::Kind k = cr->peek();
+    if (k != CborReader::KIND_FLOAT && k != CborReader::KIND_UINT && k != CborReader::KIND_NINT) {
+        return skipped(cr);
+    }
+    return cr->readDouble(*v) ? LEGACY_CBOR_OK : LEGACY_CBOR_ERROR;
+}
+
+int legacy_cbor_read_text(LegacyCborReader* r, const char** s, size_t* len) {
+    CborReader* cr = reader(r);
+    if (cr->readText(*s, *len)) return LEGACY_CBOR_OK;
+    return skipped(cr);
+}
+
+int legacy_cbor_read_enum(LegacyCborReader* r, const char** s, size_t* len, int64_t* v) {
+    CborReader* cr = reader(r);
+    if (cr->readText(*s, *len)) return LEGACY_CBOR_OK;
+    *s = NULL;
+    return legacy_cbor_read_int(r, v);
+}
+
+int legacy_cbor_skip(LegacyCborReader* r) {
+    return reader(r)->skip() ? LEGACY_CBOR_OK : LEGACY_CBOR_ERROR;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "legacy_agent.h"
+#include "CborReader.h"
+#include "CborWriter.h"
+
+// Converts between CBOR data items and user structs described by a
+// LegacyStructDesc (field name -> offset/size/type table).
+class StructCodec {
+public:
+    // Check a descriptor before it is registered: sizes match the field
+    // types and every field lies inside the struct (nested ones included).
+    static bool validate(const LegacyStructDesc* desc);
+
+    // Decode the map at the reader position into 'out' (desc->size bytes,
+    // zeroed by the caller). Unknown keys and values of another type are
+    // skipped; false only when the CBOR itself is malformed or not a map.
+    static bool decode(CborReader& r, const LegacyStructDesc* desc, void* out);
+
+    // Encode 'in' as one map with every described field, in descriptor
+    // order (desc must have passed validate). Enums are written by name
+    // when the value is in 'enums', as a number otherwise.
+    static void encode(CborWriter& w, const LegacyStructDesc* desc, const void* in);
+
+private:
+    static bool decodeStruct(CborReader& r, const LegacyStructDesc* desc, uint8_t* base, int depth);
+    static bool decodeField(CborReader& r, const LegacyFieldDesc& f, uint8_t* dst, int depth);
+    static bool decodeScalar(CborReader& r, const LegacyFieldDesc& f, uint8_t* dst, int depth);
+    static bool validateStruct(const LegacyStructDesc* desc, int depth);
+    static void encodeStruct(CborWriter& w, const LegacyStructDesc* desc, const uint8_t* base);
+    static void encodeScalar(CborWriter& w, const LegacyFieldDesc& f, const uint8_t* src);
+};
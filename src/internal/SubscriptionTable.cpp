@@ -0,0 +1,78 @@
+#include "SubscriptionTable.h"
+
+// All epoch/pointer accesses are seq_cst: a reader's slot store must be
+// ordered before its snapshot load, and a writer's pointer swap before its
+// slot scan, so that either the writer sees the slot or the reader sees the
+// new snapshot.
+
+SubscriptionTable::SubscriptionTable()
+    : current_(new Snapshot())
+    , epoch_(1)
+{
+    for (uint32_t i = 0; i < kMaxReaders; ++i) reader_epoch_[i].store(0);
+#ifdef _VXWORKS_
+    lock_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+#endif
+}
+
+SubscriptionTable::~SubscriptionTable() {
+    // Readers are gone (receive task and workers are joined before this)
+    for (size_t i = 0; i < retired_.size(); ++i) delete retired_[i].first;
+    delete current_.load();
+#ifdef _VXWORKS_
+    if (lock_) semDelete(lock_);
+#endif
+}
+
+void SubscriptionTable::add(uint32_t topic, const Subscription& sub) {
+#ifdef _VXWORKS_
+    semTake(lock_, WAIT_FOREVER);
+#else
+    std::lock_guard<std::mutex> lock(lock_);
+#endif
+    Snapshot* next = new Snapshot(*current_.load());
+    if (next->size() <= topic) next->resize(topic + 1);
+    (*next)[topic].push_back(sub);
+
+    const Snapshot* prev = current_.exchange(next);
+    // Readers announcing this epoch or later load 'next'
+    uint32_t replaced_at = epoch_.fetch_add(1) + 1;
+    retired_.push_back(std::make_pair(prev, replaced_at));
+    reclaim();
+#ifdef _VXWORKS_
+    semGive(lock_);
+#endif
+}
+
+void SubscriptionTable::reclaim() {
+    uint32_t oldest = 0;
+    for (uint32_t i = 0; i < kMaxReaders; ++i) {
+        uint32_t e = reader_epoch_[i].load();
+        if (e != 0 && (oldest == 0 || e < oldest)) oldest = e;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_.size(); ++i) {
+        if (oldest == 0 || oldest >= retired_[i].second) {
+            delete retired_[i].first;
+        } else {
+            retired_[kept++] = retired_[i];
+        }
+    }
+    retired_.resize(kept);
+}
+
+SubscriptionTable::Reader::Reader(SubscriptionTable& table, uint32_t slot)
+    : slot_(table.reader_epoch_[slot])
+{
+    slot_.store(table.epoch_.load());
+    snapshot_ = table.current_.load();
+}
+
+SubscriptionTable::Reader::~Reader() {
+    slot_.store(0);
+}
+
+const SubscriptionTable::List* SubscriptionTable::Reader::find(uint32_t topic) const {
+    if (topic >= snapshot_->size() || (*snapshot_)[topic].empty()) return nullptr;
+    return &(*snapshot_)[topic];
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "legacy_agent.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <atomic>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <vxWorks.h>
+#include <semLib.h>
+}
+#else
+#include <mutex>
+#endif
+
+// Event subscriptions indexed by topic handle (see TopicRegistry).
+//
+// The table is an immutable snapshot behind an atomic pointer. Subscribing
+// copies the current snapshot, adds the entry and swaps the pointer; only
+// writers take the lock. Delivering tasks read through a Reader, which is
+// wait-free: it announces the current epoch in its own slot, reads the
+// snapshot and clears the slot on exit. A replaced snapshot is freed once
+// no slot still announces an epoch older than its replacement.
+//
+// Reader slots are fixed: 0 for the receive task, 1 + n for dispatch worker
+// n. A slot must not be used by two tasks at once, nor nested on one task.
+class SubscriptionTable {
+public:
+    struct Subscription {
+        LegacyEventCb event_cb;
+        LegacyTypedEventCb typed_cb;
+        void* user;
+    };
+    typedef std::vector<Subscription> List;
+
+    static const uint32_t kMaxReaders = 1 + LEGACY_DISPATCH_MAX_WORKERS;
+
+    SubscriptionTable();
+    ~SubscriptionTable();
+
+    // Any task, including from a callback
+    void add(uint32_t topic, const Subscription& sub);
+
+    // Pins the current snapshot for the lifetime of the object
+    class Reader {
+    public:
+        Reader(SubscriptionTable& table, uint32_t slot);
+        ~Reader();
+        // Subscribers of a topic (NULL: none)
+        const List* find(uint32_t topic) const;
+    private:
+        std::atomic<uint32_t>& slot_;
+        const std::vector<List>* snapshot_;
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+    };
+
+private:
+    typedef std::vector<List> Snapshot;     // index: topic handle
+
+    // Free retired snapshots no reader can still hold (writer lock held)
+    void reclaim();
+
+    std::atomic<const Snapshot*> current_;
+    std::atomic<uint32_t> epoch_;                       // starts at 1; 0 marks an idle slot
+    std::atomic<uint32_t> reader_epoch_[kMaxReaders];
+    std::vector<std::pair<const Snapshot*, uint32_t>> retired_;   // snapshot, epoch of its replacement
+
+#ifdef _VXWORKS_
+    SEM_ID lock_;
+#else
+    std::mutex lock_;
+#endif
+
+    SubscriptionTable(const SubscriptionTable&) = delete;
+    SubscriptionTable& operator=(const SubscriptionTable&) = delete;
+};
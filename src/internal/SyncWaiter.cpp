@@ -0,0 +1,157 @@
+#include "SyncWaiter.h"
+#include <cstring>
+#include <chrono>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <sysLib.h>
+}
+#endif
+
+SyncWaiter::SyncWaiter()
+    : timed_out(false)
+    , ok(false)
+    , err(0)
+    , proto(-1)
+    , next_free(nullptr)
+    , state_(STATE_IDLE)
+#ifndef _VXWORKS_
+    , signalled_(false)
+#endif
+{
+    msg[0] = '\0';
+#ifdef _VXWORKS_
+    sem_ = semBCreate(SEM_Q_PRIORITY, SEM_EMPTY);
+#endif
+}
+
+SyncWaiter::~SyncWaiter() {
+#ifdef _VXWORKS_
+    if (sem_) semDelete(sem_);
+#endif
+}
+
+void SyncWaiter::arm() {
+    timed_out = false;
+    ok = false;
+    err = 0;
+    proto = -1;
+    msg[0] = '\0';
+#ifndef _VXWORKS_
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        signalled_ = false;
+    }
+#endif
+    state_.store(STATE_ARMED, std::memory_order_release);
+}
+
+void SyncWaiter::disarm() {
+    state_.store(STATE_IDLE, std::memory_order_release);
+}
+
+bool SyncWaiter::complete(const LegacySimpleResult* res, int reply_proto, bool reply_timed_out) {
+    // Written before the state change publishes them to the caller
+    timed_out = reply_timed_out;
+    ok = res ? res->ok : false;
+    err = res ? res->err : 0;
+    proto = reply_proto;
+    msg[0] = '\0';
+    if (res && res->msg) {
+        strncpy(msg, res->msg, sizeof(msg) - 1);
+        msg[sizeof(msg) - 1] = '\0';
+    }
+
+    int expected = STATE_ARMED;
+    if (!state_.compare_exchange_strong(expected, STATE_DONE, std::memory_order_acq_rel)) {
+        return false; // caller already gave up
+    }
+#ifdef _VXWORKS_
+    semGive(sem_);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        signalled_ = true;
+    }
+    cond_.notify_one();
+#endif
+    return true;
+}
+
+bool SyncWaiter::wait(uint32_t timeout_ms) {
+#ifdef _VXWORKS_
+    int rate = sysClkRateGet();
+    int ticks = (int)((uint64_t)timeout_ms * (uint64_t)(rate > 0 ? rate : 1) / 1000ULL) + 1;
+    return semTake(sem_, ticks) == OK;
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return signalled_; });
+#endif
+}
+
+bool SyncWaiter::abandon() {
+    int expected = STATE_ARMED;
+    if (state_.compare_exchange_strong(expected, STATE_ABANDONED, std::memory_order_acq_rel)) {
+        return true;
+    }
+    // Completed concurrently: consume the wakeup so the next use starts clean
+#ifdef _VXWORKS_
+    semTake(sem_, WAIT_FOREVER);
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return signalled_; });
+#endif
+    return false;
+}
+
+SyncWaiterPool::SyncWaiterPool()
+    : free_(nullptr)
+{
+#ifdef _VXWORKS_
+    sem_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+#endif
+}
+
+SyncWaiterPool::~SyncWaiterPool() {
+    for (size_t i = 0; i < all_.size(); ++i) {
+        delete all_[i];
+    }
+#ifdef _VXWORKS_
+    if (sem_) semDelete(sem_);
+#endif
+}
+
+SyncWaiter* SyncWaiterPool::acquire() {
+#ifdef _VXWORKS_
+    semTake(sem_, WAIT_FOREVER);
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+#endif
+    SyncWaiter* w = free_;
+    if (w) {
+        free_ = w->next_free;
+    } else {
+        w = new SyncWaiter();
+        all_.push_back(w);
+    }
+#ifdef _VXWORKS_
+    semGive(sem_);
+#endif
+    w->next_free = nullptr;
+    return w;
+}
+
+void SyncWaiterPool::release(SyncWaiter* w) {
+    if (!w) return;
+    w->disarm();
+#ifdef _VXWORKS_
+    semTake(sem_, WAIT_FOREVER);
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+#endif
+    w->next_free = free_;
+    free_ = w;
+#ifdef _VXWORKS_
+    semGive(sem_);
+#endif
+}
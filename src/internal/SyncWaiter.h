@@ -0,0 +1,84 @@
+#pragma once
+#include "legacy_agent.h"
+#include <cstdint>
+#include <vector>
+#include <atomic>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <vxWorks.h>
+#include <semLib.h>
+}
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+// One-shot wait object for a blocking (_sync) control call. It is attached to
+// the pending slot of the request; the receive task records the reply (or the
+// timeout) in it and wakes the caller.
+//
+// Life cycle: IDLE (from the pool) -> ARMED (in the pending table) -> DONE
+// (completed, caller wakes) or ABANDONED (caller gave up first; whoever sees
+// the completion returns the waiter to the pool instead).
+class SyncWaiter {
+public:
+    SyncWaiter();
+    ~SyncWaiter();
+
+    // Caller side
+    void arm();
+    void disarm();               // registration failed, back to IDLE
+    bool armed() const { return state_.load(std::memory_order_acquire) != STATE_IDLE; }
+    bool wait(uint32_t timeout_ms); // true once completed
+    // Give up waiting. False when the completion won the race: the wakeup is
+    // then already given and wait() returns immediately.
+    bool abandon();
+
+    // Receive task: record the outcome and wake the caller. False when the
+    // caller abandoned the wait; the waiter must then go back to the pool.
+    bool complete(const LegacySimpleResult* res, int proto, bool timed_out);
+
+    // Outcome (valid after wait() returned true)
+    bool timed_out;
+    bool ok;
+    int  err;
+    int  proto;
+    char msg[128];
+
+    SyncWaiter* next_free;
+
+private:
+    enum : int { STATE_IDLE = 0, STATE_ARMED, STATE_DONE, STATE_ABANDONED };
+    std::atomic<int> state_;
+#ifdef _VXWORKS_
+    SEM_ID sem_;                 // binary, given once per completion
+#else
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool signalled_;
+#endif
+
+    SyncWaiter(const SyncWaiter&) = delete;
+    SyncWaiter& operator=(const SyncWaiter&) = delete;
+};
+
+// Grow-only pool: waiters are created on first use and recycled, so steady
+// state sync calls create no semaphores and allocate nothing.
+class SyncWaiterPool {
+public:
+    SyncWaiterPool();
+    ~SyncWaiterPool();
+
+    SyncWaiter* acquire();
+    void release(SyncWaiter* w);
+
+private:
+#ifdef _VXWORKS_
+    SEM_ID sem_;
+#else
+    std::mutex mutex_;
+#endif
+    SyncWaiter* free_;
+    std::vector<SyncWaiter*> all_;
+};
@@ -0,0 +1,88 @@
+#include "TopicRegistry.h"
+#include <cstring>
+
+TopicRegistry::TopicRegistry()
+    : count_(0)
+{
+    for (uint32_t i = 0; i < kMaxTopics; ++i) entries_[i] = nullptr;
+    for (uint32_t i = 0; i < kTableSize; ++i) slots_[i].store(0, std::memory_order_relaxed);
+#ifdef _VXWORKS_
+    lock_ = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+#endif
+}
+
+TopicRegistry::~TopicRegistry() {
+    for (uint32_t i = 0; i < kMaxTopics; ++i) delete entries_[i];
+#ifdef _VXWORKS_
+    if (lock_) semDelete(lock_);
+#endif
+}
+
+uint32_t TopicRegistry::hashOf(const char* topic, size_t topic_len, const char* type, size_t type_len) {
+    // FNV-1a over "topic\0type"
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < topic_len; ++i) {
+        h ^= (uint8_t)topic[i];
+        h *= 16777619u;
+    }
+    h *= 16777619u;
+    for (size_t i = 0; i < type_len; ++i) {
+        h ^= (uint8_t)type[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+uint32_t TopicRegistry::probe(uint32_t hash, const char* topic, size_t topic_len, const char* type, size_t type_len,
+                              uint32_t* free_slot) const {
+    for (uint32_t i = 0; i < kTableSize; ++i) {
+        uint32_t slot = (hash + i) & (kTableSize - 1);
+        uint32_t handle = slots_[slot].load(std::memory_order_acquire);
+        if (handle == 0) {
+            if (free_slot) *free_slot = slot;
+            return 0;
+        }
+        const Entry* e = entries_[handle - 1];
+        if (e->hash == hash &&
+            e->topic.size() == topic_len && memcmp(e->topic.data(), topic, topic_len) == 0 &&
+            e->type.size() == type_len && memcmp(e->type.data(), type, type_len) == 0) {
+            return handle;
+        }
+    }
+    return 0;   // unreachable: the table is never more than half full
+}
+
+uint32_t TopicRegistry::find(const char* topic, size_t topic_len, const char* type, size_t type_len) const {
+    if (!topic || !type) return 0;
+    return probe(hashOf(topic, topic_len, type, type_len), topic, topic_len, type, type_len, nullptr);
+}
+
+uint32_t TopicRegistry::intern(const char* topic, const char* type) {
+    if (!topic || !type) return 0;
+    size_t topic_len = strlen(topic);
+    size_t type_len = strlen(type);
+    uint32_t hash = hashOf(topic, topic_len, type, type_len);
+
+#ifdef _VXWORKS_
+    semTake(lock_, WAIT_FOREVER);
+#else
+    std::lock_guard<std::mutex> lock(lock_);
+#endif
+    uint32_t free_slot = kTableSize;
+    uint32_t handle = probe(hash, topic, topic_len, type, type_len, &free_slot);
+    uint32_t n = count_.load(std::memory_order_relaxed);
+    if (handle == 0 && n < kMaxTopics && free_slot < kTableSize) {
+        Entry* e = new Entry();
+        e->topic.assign(topic, topic_len);
+        e->type.assign(type, type_len);
+        e->hash = hash;
+        entries_[n] = e;
+        handle = n + 1;
+        count_.store(handle, std::memory_order_release);
+        slots_[free_slot].store(handle, std::memory_order_release);
+    }
+#ifdef _VXWORKS_
+    semGive(lock_);
+#endif
+    return handle;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <atomic>
+
+#ifdef _VXWORKS_
+extern "C" {
+#include <vxWorks.h>
+#include <semLib.h>
+}
+#else
+#include <mutex>
+#endif
+
+// Interned topic/type pairs.
+//
+// Every pair gets a small integer handle (1..kMaxTopics) the first time it is
+// seen at subscribe, adapter registration or writer/reader creation. Handles
+// are never released, so per-topic state can live in flat arrays indexed by
+// handle. Lookup by name is lock-free and allocation-free (open addressing
+// over the name bytes), so the receive task can map the topic/type spans of
+// an incoming event straight to a handle.
+class TopicRegistry {
+public:
+    static const uint32_t kMaxTopics = 512;
+
+    TopicRegistry();
+    ~TopicRegistry();
+
+    // Handle of the pair, interned on first use (0: registry full or bad name)
+    uint32_t intern(const char* topic, const char* type);
+    // Handle of an already interned pair (0: unknown); any task, never blocks
+    uint32_t find(const char* topic, size_t topic_len, const char* type, size_t type_len) const;
+
+    bool valid(uint32_t handle) const {
+        return handle != 0 && handle <= count_.load(std::memory_order_acquire);
+    }
+    // Interned names (stable for the registry lifetime); handle must be valid
+    const char* topic(uint32_t handle) const { return entries_[handle - 1]->topic.c_str(); }
+    const char* type(uint32_t handle) const { return entries_[handle - 1]->type.c_str(); }
+
+private:
+    static const uint32_t kTableSize = kMaxTopics * 2;     // power of two, load <= 1/2
+
+    struct Entry {
+        std::string topic;
+        std::string type;
+        uint32_t hash;
+    };
+    static uint32_t hashOf(const char* topic, size_t topic_len, const char* type, size_t type_len);
+    uint32_t probe(uint32_t hash, const char* topic, size_t topic_len, const char* type, size_t type_len,
+                   uint32_t* free_slot) const;
+
+    // entries_[handle - 1]; filled before the handle is published in slots_
+    Entry* entries_[kMaxTopics];
+    std::atomic<uint32_t> slots_[kTableSize];               // handle, 0 = empty
+    std::atomic<uint32_t> count_;
+
+    // Serializes intern() only
+#ifdef _VXWORKS_
+    SEM_ID lock_;
+#else
+    std::mutex lock_;
+#endif
+
+    TopicRegistry(const TopicRegistry&) = delete;
+    TopicRegistry& operator=(const TopicRegistry&) = delete;
+};
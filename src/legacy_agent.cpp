@@ -6,6 +6,11 @@ struct LegacyAgentHandleImpl {
     IpcJsonClient client;
 };
 
+struct LegacyWriterImpl {
+    IpcJsonClient* client;
+    IpcJsonClient::WriterTemplate tmpl;
+};
+
 // Global log callback storage
 static LegacyLogCb g_global_log_cb = nullptr;
 static void* g_global_log_user = nullptr;
@@ -80,6 +85,51 @@ LegacyStatus legacy_agent_clear_dds_entities(LEGACY_HANDLE h, uint32_t timeout_m
     return h->client.clearEntities(timeout_ms, cb, user);
 }
 
+LegacyStatus legacy_agent_hello_sync(LEGACY_HANDLE h, uint32_t timeout_ms, LegacySyncResult* out_res, int* out_proto) {
+    if (!h) return LEGACY_ERR_PARAM;
+    return h->client.sendHelloSync(timeout_ms, out_res, out_proto);
+}
+
+LegacyStatus legacy_agent_create_participant_sync(LEGACY_HANDLE h, const LegacyParticipantConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h || !cfg) return LEGACY_ERR_PARAM;
+    return h->client.createParticipantSync(cfg, timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_create_publisher_sync(LEGACY_HANDLE h, const LegacyPublisherConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h || !cfg) return LEGACY_ERR_PARAM;
+    return h->client.createPublisherSync(cfg, timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_create_subscriber_sync(LEGACY_HANDLE h, const LegacySubscriberConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h || !cfg) return LEGACY_ERR_PARAM;
+    return h->client.createSubscriberSync(cfg, timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_create_writer_sync(LEGACY_HANDLE h, const LegacyWriterConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h || !cfg) return LEGACY_ERR_PARAM;
+    return h->client.createWriterSync(cfg, timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_create_reader_sync(LEGACY_HANDLE h, const LegacyReaderConfig* cfg, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h || !cfg) return LEGACY_ERR_PARAM;
+    return h->client.createReaderSync(cfg, timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_clear_dds_entities_sync(LEGACY_HANDLE h, uint32_t timeout_ms, LegacySyncResult* out_res) {
+    if (!h) return LEGACY_ERR_PARAM;
+    return h->client.clearEntitiesSync(timeout_ms, out_res);
+}
+
+LegacyStatus legacy_agent_create_entities(LEGACY_HANDLE h, const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacyBulkCb cb, void* user) {
+    if (!h || !descs || count == 0) return LEGACY_ERR_PARAM;
+    return h->client.createEntities(descs, count, timeout_ms, cb, user);
+}
+
+LegacyStatus legacy_agent_create_entities_sync(LEGACY_HANDLE h, const LegacyEntityDesc* descs, size_t count, uint32_t timeout_ms, LegacySyncResult* out_results) {
+    if (!h || !descs || count == 0) return LEGACY_ERR_PARAM;
+    return h->client.createEntitiesSync(descs, count, timeout_ms, out_results);
+}
+
 LegacyStatus legacy_agent_get_qos_list(LEGACY_HANDLE h, bool include_builtin, bool detail, uint32_t timeout_ms, LegacyQosListCb cb, void* user) {
     if (!h) return LEGACY_ERR_PARAM;
     return h->client.getQosList(include_builtin, detail, timeout_ms, cb, user);
@@ -90,16 +140,92 @@ LegacyStatus legacy_agent_set_qos_profile(LEGACY_HANDLE h, const LegacyQosSetOpt
     return h->client.setQosProfile(opt, timeout_ms, cb, user);
 }
 
+LegacyStatus legacy_agent_topic_handle(LEGACY_HANDLE h, const char* topic, const char* type, LegacyTopicHandle* out_handle) {
+    if (!h || !topic || !type || !out_handle) return LEGACY_ERR_PARAM;
+    return h->client.topicHandle(topic, type, out_handle);
+}
+
 LegacyStatus legacy_agent_write_json(LEGACY_HANDLE h, const LegacyWriteJsonOptions* opt, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
     if (!h || !opt) return LEGACY_ERR_PARAM;
     return h->client.writeJson(opt, timeout_ms, cb, user);
 }
 
+LegacyStatus legacy_agent_write_json_noack(LEGACY_HANDLE h, const LegacyWriteJsonOptions* opt) {
+    if (!h || !opt) return LEGACY_ERR_PARAM;
+    return h->client.writeJsonNoAck(opt);
+}
+
 LegacyStatus legacy_agent_write_struct(LEGACY_HANDLE h, const char* topic, const char* type_name, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
     if (!h || !topic || !type_name || !user_struct) return LEGACY_ERR_PARAM;
     return h->client.writeStruct(topic, type_name, user_struct, timeout_ms, cb, user);
 }
 
+LegacyStatus legacy_agent_write_json_by_handle(LEGACY_HANDLE h, LegacyTopicHandle topic, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!h || topic == LEGACY_TOPIC_INVALID) return LEGACY_ERR_PARAM;
+    return h->client.writeJsonByHandle(topic, data_json, timeout_ms, cb, user);
+}
+
+LegacyStatus legacy_agent_write_json_noack_by_handle(LEGACY_HANDLE h, LegacyTopicHandle topic, const char* data_json) {
+    if (!h || topic == LEGACY_TOPIC_INVALID) return LEGACY_ERR_PARAM;
+    return h->client.writeJsonNoAckByHandle(topic, data_json);
+}
+
+LegacyStatus legacy_agent_write_struct_by_handle(LEGACY_HANDLE h, LegacyTopicHandle topic, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!h || topic == LEGACY_TOPIC_INVALID || !user_struct) return LEGACY_ERR_PARAM;
+    return h->client.writeStructByHandle(topic, user_struct, timeout_ms, cb, user);
+}
+
+LegacyStatus legacy_agent_open_writer(LEGACY_HANDLE h, const LegacyWriteJsonOptions* opt, LEGACY_WRITER* out_writer) {
+    if (!h || !opt || !opt->topic || !out_writer) return LEGACY_ERR_PARAM;
+
+    LegacyWriterImpl* w = new (std::nothrow) LegacyWriterImpl();
+    if (!w) return LEGACY_ERR_PARAM;
+    w->client = &h->client;
+
+    LegacyStatus status = h->client.openWriter(opt, &w->tmpl);
+    if (status != LEGACY_OK) {
+        delete w;
+        return status;
+    }
+
+    *out_writer = w;
+    return LEGACY_OK;
+}
+
+LegacyStatus legacy_agent_writer_write(LEGACY_WRITER w, const char* data_json, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!w) return LEGACY_ERR_PARAM;
+    return w->client->writerWrite(w->tmpl, data_json, timeout_ms, cb, user);
+}
+
+LegacyStatus legacy_agent_writer_write_noack(LEGACY_WRITER w, const char* data_json) {
+    if (!w) return LEGACY_ERR_PARAM;
+    return w->client->writerWriteNoAck(w->tmpl, data_json);
+}
+
+LegacyStatus legacy_agent_writer_write_struct(LEGACY_WRITER w, const void* user_struct, uint32_t timeout_ms, LegacyWriteCb cb, void* user) {
+    if (!w || !user_struct) return LEGACY_ERR_PARAM;
+    return w->client->writerWriteStruct(w->tmpl, user_struct, true, timeout_ms, cb, user);
+}
+
+LegacyStatus legacy_agent_writer_write_struct_noack(LEGACY_WRITER w, const void* user_struct) {
+    if (!w || !user_struct) return LEGACY_ERR_PARAM;
+    return w->client->writerWriteStruct(w->tmpl, user_struct, false, 0, nullptr, nullptr);
+}
+
+void legacy_agent_close_writer(LEGACY_WRITER w) {
+    delete w;
+}
+
+LegacyStatus legacy_agent_set_send_batching(LEGACY_HANDLE h, uint32_t max_frames, uint32_t max_delay_ms) {
+    if (!h) return LEGACY_ERR_PARAM;
+    return h->client.setSendBatching(max_frames, max_delay_ms);
+}
+
+LegacyStatus legacy_agent_flush(LEGACY_HANDLE h) {
+    if (!h) return LEGACY_ERR_PARAM;
+    return h->client.flush();
+}
+
 LegacyStatus legacy_agent_subscribe_event(LEGACY_HANDLE h, const char* topic, const char* type, LegacyEventCb cb, void* user) {
     if (!h || !topic || !type) return LEGACY_ERR_PARAM;
     return h->client.subscribeEvent(topic, type, cb, user);
@@ -110,17 +236,43 @@ LegacyStatus legacy_agent_subscribe_typed(LEGACY_HANDLE h, const char* topic, co
     return h->client.subscribeTyped(topic, type_name, cb, user);
 }
 
+LegacyStatus legacy_agent_subscribe_event_by_handle(LEGACY_HANDLE h, LegacyTopicHandle topic, LegacyEventCb cb, void* user) {
+    if (!h || topic == LEGACY_TOPIC_INVALID) return LEGACY_ERR_PARAM;
+    return h->client.subscribeEventByHandle(topic, cb, user);
+}
+
+LegacyStatus legacy_agent_subscribe_typed_by_handle(LEGACY_HANDLE h, LegacyTopicHandle topic, LegacyTypedEventCb cb, void* user) {
+    if (!h || topic == LEGACY_TOPIC_INVALID) return LEGACY_ERR_PARAM;
+    return h->client.subscribeTypedByHandle(topic, cb, user);
+}
+
 LegacyStatus legacy_agent_register_type_adapter(LEGACY_HANDLE h, const LegacyTypeAdapter* adapter) {
     if (!h || !adapter) return LEGACY_ERR_PARAM;
     return h->client.registerTypeAdapter(adapter);
 }
 
+const char* legacy_result_raw_json(const LegacySimpleResult* res) {
+    if (!res) return NULL;
+    return IpcJsonClient::rawJson(res->priv);
+}
+
+const char* legacy_event_raw_json(const LegacyEvent* evt) {
+    if (!evt) return NULL;
+    return IpcJsonClient::rawJson(evt->priv);
+}
+
 LegacyStatus legacy_agent_get_perf_stats(LEGACY_HANDLE h, LegacyPerfStats* out_stats) {
     if (!h || !out_stats) return LEGACY_ERR_PARAM;
     h->client.getPerfStats(out_stats);
     return LEGACY_OK;
 }
 
+LegacyStatus legacy_agent_get_dispatch_stats(LEGACY_HANDLE h, LegacyDispatchStats* out_stats) {
+    if (!h || !out_stats) return LEGACY_ERR_PARAM;
+    h->client.getDispatchStats(out_stats);
+    return LEGACY_OK;
+}
+
 LegacyStatus legacy_agent_unregister_type_adapter(LEGACY_HANDLE h, const char* topic, const char* type_name) {
     if (!h || !topic || !type_name) return LEGACY_ERR_PARAM;
     return h->client.unregisterTypeAdapter(topic, type_name);
@@ -0,0 +1,418 @@
+/*
+ * psm_codegen.cpp - Offline PSM XML -> C type/codec generator (host tool)
+ *
+ * Reads RTI XML type definitions (the RefDoc PSM files) and writes one header with:
+ *   - the C struct/enum/typedef of every type, names prefixed by module
+ *     (P_NSTEL::C_X -> P_NSTEL_C_X, enumerators P_NSTEL_L_...)
+ *   - <type>_TYPE / <type>_TOPIC name macros for every non-nested struct
+ *   - for C++, legacy_reflect.hpp declarations: enum string tables and the
+ *     struct field lists, from which the per-type CBOR codecs and descriptors
+ *     used by write_struct / typed subscribe are instantiated
+ *
+ * Usage: psm_codegen <out.h> <types.xml>...
+ * Built and run by "make psm-codegen"; the output is committed.
+ *
+ * Only the subset of the XML type schema used by the PSM files is handled:
+ * module, enum/enumerator, typedef, struct/member, basic types, bounded
+ * strings and single-dimension arrays. Sequences other than strings are
+ * emitted as a bounded array plus a _length member; they are not reflected
+ * (the descriptor has no variable-length arrays, and codec and descriptor
+ * share one field list), so they are not sent by write_struct and stay
+ * empty on typed receive.
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Tag {
+    std::string name;                           // without '<', "/name" for a close tag
+    std::map<std::string, std::string> attrs;
+    bool self_closing;
+};
+
+struct Member {
+    std::string name;
+    std::string type;       // basic type, or fully qualified nonBasicTypeName
+    long seq_max;           // sequenceMaxLength, -1 if none
+    long str_max;           // stringMaxLength, -1 if none
+    long array_dim;         // arrayDimensions, -1 if none
+    bool key;
+};
+
+struct Decl {
+    enum Kind { ENUM, TYPEDEF, STRUCT } kind;
+    std::string module;
+    std::string name;
+    bool nested;
+    std::vector<std::pair<std::string, long> > enumerators;    // ENUM: name, value
+    Member alias;                                               // TYPEDEF
+    std::vector<Member> members;                                // STRUCT
+};
+
+std::vector<Decl> g_decls;
+std::map<std::string, size_t> g_by_name;    // "Module::Name" -> index in g_decls
+
+void die(const char* fmt, const std::string& arg) {
+    fprintf(stderr, "psm_codegen: ");
+    fprintf(stderr, fmt, arg.c_str());
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+bool read_file(const char* path, std::string* out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out->append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// Next element tag starting at pos; skips text, <?...?> and <!-- ... -->
+bool next_tag(const std::string& xml, size_t* pos, Tag* tag) {
+    for (;;) {
+        size_t lt = xml.find('<', *pos);
+        if (lt == std::string::npos) return false;
+        if (xml.compare(lt, 4, "<!--") == 0) {
+            size_t end = xml.find("-->", lt);
+            if (end == std::string::npos) return false;
+            *pos = end + 3;
+            continue;
+        }
+        size_t gt = xml.find('>', lt);
+        if (gt == std::string::npos) return false;
+        *pos = gt + 1;
+        if (xml[lt + 1] == '?' || xml[lt + 1] == '!') continue;
+
+        std::string body = xml.substr(lt + 1, gt - lt - 1);
+        tag->self_closing = !body.empty() && body[body.size() - 1] == '/';
+        if (tag->self_closing) body.erase(body.size() - 1);
+        tag->attrs.clear();
+
+        size_t i = 0;
+        while (i < body.size() && !isspace((unsigned char)body[i])) ++i;
+        tag->name = body.substr(0, i);
+        for (;;) {
+            while (i < body.size() && isspace((unsigned char)body[i])) ++i;
+            if (i >= body.size()) break;
+            size_t eq = body.find('=', i);
+            if (eq == std::string::npos) break;
+            std::string key = body.substr(i, eq - i);
+            while (!key.empty() && isspace((unsigned char)key[key.size() - 1])) key.erase(key.size() - 1);
+            size_t q = body.find_first_of("\"'", eq);
+            if (q == std::string::npos) break;
+            size_t qe = body.find(body[q], q + 1);
+            if (qe == std::string::npos) break;
+            tag->attrs[key] = body.substr(q + 1, qe - q - 1);
+            i = qe + 1;
+        }
+        return true;
+    }
+}
+
+long attr_long(const Tag& t, const char* key) {
+    std::map<std::string, std::string>::const_iterator it = t.attrs.find(key);
+    if (it == t.attrs.end()) return -1;
+    if (it->second.find(',') != std::string::npos) die("multi-dimensional arrays are not supported (%s)", it->second);
+    return strtol(it->second.c_str(), NULL, 10);
+}
+
+std::string attr(const Tag& t, const char* key) {
+    std::map<std::string, std::string>::const_iterator it = t.attrs.find(key);
+    return it == t.attrs.end() ? std::string() : it->second;
+}
+
+Member parse_member(const Tag& t, const std::string& module) {
+    Member m;
+    m.name = attr(t, "name");
+    m.type = attr(t, "type");
+    if (m.type == "nonBasic") {
+        m.type = attr(t, "nonBasicTypeName");
+        if (m.type.find("::") == std::string::npos) m.type = module + "::" + m.type;
+    }
+    m.seq_max = attr_long(t, "sequenceMaxLength");
+    m.str_max = attr_long(t, "stringMaxLength");
+    m.array_dim = attr_long(t, "arrayDimensions");
+    m.key = attr(t, "key") == "true";
+    return m;
+}
+
+void add_decl(const Decl& d) {
+    std::string qualified = d.module + "::" + d.name;
+    if (g_by_name.count(qualified)) return;     // same file included twice
+    g_by_name[qualified] = g_decls.size();
+    g_decls.push_back(d);
+}
+
+void parse_file(const char* path) {
+    std::string xml;
+    if (!read_file(path, &xml)) die("cannot read %s", path);
+
+    std::vector<std::string> modules;
+    Decl* open = NULL;
+    Decl cur;
+    size_t pos = 0;
+    Tag t;
+    while (next_tag(xml, &pos, &t)) {
+        std::string module;
+        for (size_t i = 0; i < modules.size(); ++i) module += (i ? "::" : "") + modules[i];
+
+        if (t.name == "module") {
+            if (!t.self_closing) modules.push_back(attr(t, "name"));
+        } else if (t.name == "/module") {
+            if (!modules.empty()) modules.pop_back();
+        } else if (t.name == "enum" || t.name == "struct") {
+            cur = Decl();
+            cur.kind = (t.name == "enum") ? Decl::ENUM : Decl::STRUCT;
+            cur.module = module;
+            cur.name = attr(t, "name");
+            cur.nested = attr(t, "nested") == "true";
+            if (t.self_closing) add_decl(cur);
+            else open = &cur;
+        } else if (t.name == "/enum" || t.name == "/struct") {
+            if (open) add_decl(*open);
+            open = NULL;
+        } else if (t.name == "enumerator" && open) {
+            long value = attr_long(t, "value");
+            if (value < 0) value = open->enumerators.empty() ? 0 : open->enumerators.back().second + 1;
+            open->enumerators.push_back(std::make_pair(attr(t, "name"), value));
+        } else if (t.name == "member" && open) {
+            open->members.push_back(parse_member(t, module));
+        } else if (t.name == "typedef") {
+            Decl d;
+            d.kind = Decl::TYPEDEF;
+            d.module = module;
+            d.name = attr(t, "name");
+            d.nested = true;
+            d.alias = parse_member(t, module);
+            add_decl(d);
+        } else if (t.name == "union" || t.name == "valuetype" || t.name == "bitset") {
+            die("unsupported type construct <%s>", t.name);
+        }
+    }
+}
+
+std::string c_name(const std::string& qualified) {
+    std::string out;
+    for (size_t i = 0; i < qualified.size(); ++i) {
+        if (qualified.compare(i, 2, "::") == 0) {
+            out += '_';
+            ++i;
+        } else {
+            out += qualified[i];
+        }
+    }
+    return out;
+}
+
+std::string module_prefix(const Decl& d) {
+    return c_name(d.module) + "_";
+}
+
+const char* basic_c_type(const std::string& type) {
+    static const char* const map[][2] = {
+        { "boolean", "bool" },     { "char8", "char" },       { "char", "char" },
+        { "octet", "uint8_t" },    { "byte", "uint8_t" },     { "int8", "int8_t" },
+        { "uint8", "uint8_t" },    { "int16", "int16_t" },    { "uint16", "uint16_t" },
+        { "int32", "int32_t" },    { "uint32", "uint32_t" },  { "int64", "int64_t" },
+        { "uint64", "uint64_t" },  { "float32", "float" },    { "float64", "double" },
+        { "short", "int16_t" },    { "unsignedShort", "uint16_t" },
+        { "long", "int32_t" },     { "unsignedLong", "uint32_t" },
+        { "longLong", "int64_t" }, { "unsignedLongLong", "uint64_t" },
+        { "float", "float" },      { "double", "double" },
+    };
+    for (size_t i = 0; i < sizeof(map) / sizeof(map[0]); ++i) {
+        if (type == map[i][0]) return map[i][1];
+    }
+    return NULL;
+}
+
+const Decl* find_decl(const std::string& qualified) {
+    std::map<std::string, size_t>::const_iterator it = g_by_name.find(qualified);
+    return it == g_by_name.end() ? NULL : &g_decls[it->second];
+}
+
+// Whether a type resolves to char (sequence<char> is a string)
+bool is_char(const std::string& type) {
+    if (type == "char8" || type == "char") return true;
+    const Decl* d = find_decl(type);
+    return d && d->kind == Decl::TYPEDEF && d->alias.seq_max < 0 && d->alias.array_dim < 0 &&
+           is_char(d->alias.type);
+}
+
+std::string element_c_type(const std::string& type) {
+    if (type == "string") return "char";
+    const char* basic = basic_c_type(type);
+    if (basic) return basic;
+    if (!find_decl(type)) die("unknown type %s", type);
+    return c_name(type);
+}
+
+struct CDecl {
+    std::string type;       // element type
+    std::string suffix;     // array bound, e.g. "[21]"
+    bool sequence;          // bounded sequence (needs a _length member)
+};
+
+CDecl c_decl_of(const Member& m) {
+    CDecl out;
+    out.sequence = false;
+    char bound[32];
+    if (m.type == "string") {
+        out.type = "char";
+        snprintf(bound, sizeof(bound), "[%ld]", (m.str_max > 0 ? m.str_max : 255) + 1);
+        out.suffix = bound;
+    } else if (m.seq_max >= 0 && is_char(m.type)) {
+        out.type = "char";
+        snprintf(bound, sizeof(bound), "[%ld]", m.seq_max + 1);
+        out.suffix = bound;
+    } else {
+        out.type = element_c_type(m.type);
+        if (m.seq_max >= 0) {
+            snprintf(bound, sizeof(bound), "[%ld]", m.seq_max > 0 ? m.seq_max : 1);
+            out.suffix = bound;
+            out.sequence = true;
+        }
+    }
+    if (m.array_dim > 0) {
+        if (out.sequence) die("array of sequences is not supported (%s)", m.name);
+        snprintf(bound, sizeof(bound), "[%ld]", m.array_dim);
+        out.suffix = bound + out.suffix;
+    }
+    return out;
+}
+
+// ---- emission ----
+
+FILE* g_out;
+std::set<size_t> g_emitted;
+std::set<size_t> g_in_progress;
+std::vector<size_t> g_order;
+
+void emit_deps(const Member& m);
+
+void visit(size_t idx) {
+    if (g_emitted.count(idx)) return;
+    if (g_in_progress.count(idx)) die("recursive type %s", g_decls[idx].name);
+    g_in_progress.insert(idx);
+    const Decl& d = g_decls[idx];
+    if (d.kind == Decl::TYPEDEF) emit_deps(d.alias);
+    for (size_t i = 0; i < d.members.size(); ++i) emit_deps(d.members[i]);
+    g_in_progress.erase(idx);
+    g_emitted.insert(idx);
+    g_order.push_back(idx);
+}
+
+void emit_deps(const Member& m) {
+    std::map<std::string, size_t>::const_iterator it = g_by_name.find(m.type);
+    if (it != g_by_name.end()) visit(it->second);
+    else if (!basic_c_type(m.type) && m.type != "string") die("unknown type %s", m.type);
+}
+
+void write_c_decl(const Decl& d) {
+    std::string name = c_name(d.module + "::" + d.name);
+    if (d.kind == Decl::ENUM) {
+        fprintf(g_out, "typedef enum {\n");
+        for (size_t i = 0; i < d.enumerators.size(); ++i) {
+            fprintf(g_out, "    %s%s = %ld%s\n", module_prefix(d).c_str(), d.enumerators[i].first.c_str(),
+                    d.enumerators[i].second, i + 1 < d.enumerators.size() ? "," : "");
+        }
+        fprintf(g_out, "} %s;\n\n", name.c_str());
+    } else if (d.kind == Decl::TYPEDEF) {
+        CDecl c = c_decl_of(d.alias);
+        if (c.sequence) die("sequence typedef %s is not supported", d.name);
+        fprintf(g_out, "typedef %s %s%s;\n\n", c.type.c_str(), name.c_str(), c.suffix.c_str());
+    } else {
+        fprintf(g_out, "typedef struct {\n");
+        for (size_t i = 0; i < d.members.size(); ++i) {
+            const Member& m = d.members[i];
+            CDecl c = c_decl_of(m);
+            fprintf(g_out, "    %s %s%s;%s\n", c.type.c_str(), m.name.c_str(), c.suffix.c_str(),
+                    m.key ? "    /* key */" : "");
+            if (c.sequence) fprintf(g_out, "    uint32_t %s_length;\n", m.name.c_str());
+        }
+        if (d.members.empty()) fprintf(g_out, "    char _unused;\n");
+        fprintf(g_out, "} %s;\n", name.c_str());
+        if (!d.nested) {
+            fprintf(g_out, "#define %s_TYPE  \"%s::%s\"\n", name.c_str(), d.module.c_str(), d.name.c_str());
+            fprintf(g_out, "#define %s_TOPIC \"%s__%s\"\n", name.c_str(), c_name(d.module).c_str(), d.name.c_str());
+        }
+        fprintf(g_out, "\n");
+    }
+}
+
+void write_reflection(const Decl& d) {
+    std::string name = c_name(d.module + "::" + d.name);
+    if (d.kind == Decl::ENUM) {
+        fprintf(g_out, "LEGACY_REFLECT_ENUM_BEGIN(%s)\n", name.c_str());
+        for (size_t i = 0; i < d.enumerators.size(); ++i) {
+            fprintf(g_out, "    LEGACY_REFLECT_ENUMERATOR(\"%s\", %s%s)\n", d.enumerators[i].first.c_str(),
+                    module_prefix(d).c_str(), d.enumerators[i].first.c_str());
+        }
+        fprintf(g_out, "LEGACY_REFLECT_ENUM_END(%s)\n\n", name.c_str());
+    } else if (d.kind == Decl::STRUCT) {
+        fprintf(g_out, "LEGACY_REFLECT_STRUCT_BEGIN(%s)\n", name.c_str());
+        for (size_t i = 0; i < d.members.size(); ++i) {
+            const Member& m = d.members[i];
+            if (c_decl_of(m).sequence) {
+                fprintf(g_out, "    /* %s: sequence, not described */\n", m.name.c_str());
+            } else {
+                fprintf(g_out, "    LEGACY_REFLECT_FIELD(%s)\n", m.name.c_str());
+            }
+        }
+        fprintf(g_out, "LEGACY_REFLECT_STRUCT_END(%s)\n\n", name.c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <out.h> <types.xml>...\n", argv[0]);
+        return 2;
+    }
+    for (int i = 2; i < argc; ++i) parse_file(argv[i]);
+    for (size_t i = 0; i < g_decls.size(); ++i) visit(i);
+
+    g_out = fopen(argv[1], "wb");
+    if (!g_out) die("cannot write %s", argv[1]);
+
+    fprintf(g_out, "/*\n * Generated by tools/psm_codegen from:\n");
+    for (int i = 2; i < argc; ++i) fprintf(g_out, " *   %s\n", argv[i]);
+    fprintf(g_out, " * Do not edit; regenerate with \"make psm-codegen\".\n"
+                   " *\n"
+                   " * C types of the PSM, prefixed by module. In C++ the types are also\n"
+                   " * reflected (legacy_reflect.hpp), which instantiates a CBOR codec per\n"
+                   " * type: register one with\n"
+                   " *   legacy::reflect::register_type<T>(h, T_TOPIC, T_TYPE)\n"
+                   " * and use legacy_agent_write_struct / legacy_agent_subscribe_typed.\n"
+                   " * Sequences (other than strings) are not described: not sent, left empty.\n"
+                   " */\n\n");
+    fprintf(g_out, "#ifndef PSM_TYPES_H\n#define PSM_TYPES_H\n\n#include <stdint.h>\n#include <stdbool.h>\n\n");
+
+    std::string module;
+    for (size_t i = 0; i < g_order.size(); ++i) {
+        const Decl& d = g_decls[g_order[i]];
+        if (d.module != module) {
+            module = d.module;
+            fprintf(g_out, "/* ---- %s ---- */\n\n", module.c_str());
+        }
+        write_c_decl(d);
+    }
+
+    fprintf(g_out, "#ifdef __cplusplus\n\n#include \"legacy_reflect.hpp\"\n\n");
+    for (size_t i = 0; i < g_order.size(); ++i) write_reflection(g_decls[g_order[i]]);
+    fprintf(g_out, "#endif /* __cplusplus */\n\n#endif /* PSM_TYPES_H */\n");
+
+    if (fclose(g_out) != 0) die("cannot write %s", argv[1]);
+    return 0;
+}